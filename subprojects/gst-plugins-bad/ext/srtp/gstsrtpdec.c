@@ -211,6 +211,10 @@ static GstFlowReturn gst_srtp_dec_chain_rtp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 static GstFlowReturn gst_srtp_dec_chain_rtcp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
+static GstFlowReturn gst_srtp_dec_chain_list_rtp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
+static GstFlowReturn gst_srtp_dec_chain_list_rtcp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
 
 static GstStateChangeReturn gst_srtp_dec_change_state (GstElement * element,
     GstStateChange transition);
@@ -383,6 +387,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtp));
   gst_pad_set_chain_function (filter->rtp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtp));
+  gst_pad_set_chain_list_function (filter->rtp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtp));
 
   filter->rtp_srcpad =
       gst_pad_new_from_static_template (&rtp_src_template, "rtp_src");
@@ -406,6 +412,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtcp));
   gst_pad_set_chain_function (filter->rtcp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtcp));
+  gst_pad_set_chain_list_function (filter->rtcp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtcp));
 
   filter->rtcp_srcpad =
       gst_pad_new_from_static_template (&rtcp_src_template, "rtcp_src");
@@ -1311,15 +1319,16 @@ err:
 /*
  * This function should be called while holding the filter lock.
  * The decoded buffer is stored in-place of the input @buf.
+ * @stream is the stream of @ssrc, as returned by validate_buffer(). It is
+ * looked up again whenever the lock had to be released.
  */
 static gboolean
 gst_srtp_dec_decode_buffer (GstSrtpDec * filter, GstPad * pad, GstBuffer ** buf,
-    gboolean is_rtcp, guint32 ssrc)
+    gboolean is_rtcp, guint32 ssrc, GstSrtpDecSsrcStream * stream)
 {
   GstMapInfo map;
   srtp_err_status_t err;
   gint size;
-  GstSrtpDecSsrcStream *stream;
 
   g_return_val_if_fail (GST_IS_BUFFER (*buf), FALSE);
 
@@ -1337,22 +1346,13 @@ unprotect:
 
   gst_srtp_init_event_reporter ();
 
-  if (is_rtcp) {
-    stream = find_stream_by_ssrc (filter, ssrc);
-
+  if (is_rtcp)
     err = srtp_unprotect_rtcp_mki (filter->session, map.data, &size,
-        stream && stream->keys);
-  } else {
-    stream = find_stream_by_ssrc (filter, ssrc);
-
+        stream->keys != NULL);
+  else
     err = srtp_unprotect_mki (filter->session, map.data, &size,
-        stream && stream->keys);
-  }
-  stream = find_stream_by_ssrc (filter, ssrc);
-  if (stream == NULL) {
-    GST_WARNING_OBJECT (filter, "Could not find matching stream, dropping");
-    goto err;
-  }
+        stream->keys != NULL);
+
   stream->recv_count++;
   /* Signal user depending on type of error */
   switch (err) {
@@ -1381,6 +1381,13 @@ unprotect:
         goto err;
       }
 
+      /* the streams may have changed while the lock was released */
+      stream = find_stream_by_ssrc (filter, ssrc);
+      if (stream == NULL) {
+        GST_WARNING_OBJECT (filter, "Could not find matching stream, dropping");
+        goto err;
+      }
+
       goto unprotect;
     }
     case srtp_err_status_auth_fail:
@@ -1407,74 +1414,173 @@ err:
   return FALSE;
 }
 
-static GstFlowReturn
-gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
-    gboolean is_rtcp)
+/*
+ * This function should be called while holding the filter lock, which is
+ * released to request a new key when the soft limit is reached.
+ * Returns FALSE if @buf has to be dropped, otherwise the decoded buffer is
+ * stored in-place of @buf and @is_rtcp tells which source pad it goes to.
+ */
+static gboolean
+gst_srtp_dec_process_buffer (GstSrtpDec * filter, GstPad * pad,
+    GstBuffer ** buf, gboolean * is_rtcp)
 {
-  GstSrtpDec *filter = GST_SRTP_DEC (parent);
-  GstPad *otherpad;
   GstSrtpDecSsrcStream *stream = NULL;
-  GstFlowReturn ret = GST_FLOW_OK;
   guint32 ssrc = 0;
 
-  GST_OBJECT_LOCK (filter);
-
   /* Check if this stream exists, if not create a new stream */
 
-  if (!(stream = validate_buffer (filter, buf, &ssrc, &is_rtcp))) {
-    GST_OBJECT_UNLOCK (filter);
+  if (!(stream = validate_buffer (filter, *buf, &ssrc, is_rtcp))) {
     GST_WARNING_OBJECT (filter, "Invalid buffer, dropping");
-    goto drop_buffer;
-  }
-
-  if (!STREAM_HAS_CRYPTO (stream)) {
-    GST_OBJECT_UNLOCK (filter);
-    goto push_out;
+    return FALSE;
   }
 
-  if (!gst_srtp_dec_decode_buffer (filter, pad, &buf, is_rtcp, ssrc)) {
-    GST_OBJECT_UNLOCK (filter);
-    goto drop_buffer;
-  }
+  if (!STREAM_HAS_CRYPTO (stream))
+    return TRUE;
 
-  GST_OBJECT_UNLOCK (filter);
+  if (!gst_srtp_dec_decode_buffer (filter, pad, buf, *is_rtcp, ssrc, stream))
+    return FALSE;
 
   /* If all is well, we may have reached soft limit */
-  if (gst_srtp_get_soft_limit_reached ())
+  if (gst_srtp_get_soft_limit_reached ()) {
+    GST_OBJECT_UNLOCK (filter);
     request_key_with_signal (filter, ssrc, SIGNAL_SOFT_LIMIT);
+    GST_OBJECT_LOCK (filter);
+  }
 
-push_out:
-  /* Push buffer to source pad */
+  return TRUE;
+}
+
+/* Returns the source pad for RTP or RTCP after making sure the sticky events
+ * were sent on it, or NULL if they could not be */
+static GstPad *
+gst_srtp_dec_get_srcpad (GstSrtpDec * filter, gboolean is_rtcp)
+{
   if (is_rtcp) {
-    otherpad = filter->rtcp_srcpad;
     if (!filter->rtcp_has_segment) {
       if (!gst_srtp_dec_push_early_events (filter, filter->rtcp_srcpad,
-              filter->rtp_srcpad, TRUE)) {
-        ret = GST_FLOW_FLUSHING;
-        goto drop_buffer;
-      }
+              filter->rtp_srcpad, TRUE))
+        return NULL;
     }
+    return filter->rtcp_srcpad;
   } else {
-    otherpad = filter->rtp_srcpad;
     if (!filter->rtp_has_segment) {
       if (!gst_srtp_dec_push_early_events (filter, filter->rtp_srcpad,
-              filter->rtcp_srcpad, FALSE)) {
-        ret = GST_FLOW_FLUSHING;
-        goto drop_buffer;
-      }
+              filter->rtcp_srcpad, FALSE))
+        return NULL;
     }
+    return filter->rtp_srcpad;
   }
+}
 
-  ret = gst_pad_push (otherpad, buf);
+static GstFlowReturn
+gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
+    gboolean is_rtcp)
+{
+  GstSrtpDec *filter = GST_SRTP_DEC (parent);
+  GstPad *otherpad;
+  gboolean keep;
 
-  return ret;
+  GST_OBJECT_LOCK (filter);
+  keep = gst_srtp_dec_process_buffer (filter, pad, &buf, &is_rtcp);
+  GST_OBJECT_UNLOCK (filter);
 
-drop_buffer:
-  /* Drop buffer, except if gst_pad_push returned OK or an error */
+  if (!keep) {
+    gst_buffer_unref (buf);
+    return GST_FLOW_OK;
+  }
 
-  gst_buffer_unref (buf);
+  /* Push buffer to source pad */
+  if (!(otherpad = gst_srtp_dec_get_srcpad (filter, is_rtcp))) {
+    gst_buffer_unref (buf);
+    return GST_FLOW_FLUSHING;
+  }
 
-  return ret;
+  return gst_pad_push (otherpad, buf);
+}
+
+typedef struct
+{
+  GstSrtpDec *filter;
+  GstPad *pad;
+  gboolean is_rtcp;
+  GstBufferList *rtp_list;
+  GstBufferList *rtcp_list;
+} DecodeListData;
+
+static gboolean
+decode_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
+{
+  DecodeListData *data = user_data;
+  GstBufferList **out_list;
+  GstBuffer *buf = *buffer;
+  gboolean is_rtcp = data->is_rtcp;
+
+  /* take the buffer out of the list so that it can be decoded in place */
+  *buffer = NULL;
+
+  if (!gst_srtp_dec_process_buffer (data->filter, data->pad, &buf, &is_rtcp)) {
+    gst_buffer_unref (buf);
+    return TRUE;
+  }
+
+  /* with rtcp-mux the RTCP packets are sent to the RTCP source pad */
+  out_list = is_rtcp ? &data->rtcp_list : &data->rtp_list;
+  if (*out_list == NULL)
+    *out_list = gst_buffer_list_new ();
+  gst_buffer_list_add (*out_list, buf);
+
+  return TRUE;
+}
+
+static GstFlowReturn
+gst_srtp_dec_push_list (GstSrtpDec * filter, GstBufferList * list,
+    gboolean is_rtcp)
+{
+  GstPad *otherpad;
+
+  if (list == NULL)
+    return GST_FLOW_OK;
+
+  if (!(otherpad = gst_srtp_dec_get_srcpad (filter, is_rtcp))) {
+    gst_buffer_list_unref (list);
+    return GST_FLOW_FLUSHING;
+  }
+
+  return gst_pad_push_list (otherpad, list);
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list, gboolean is_rtcp)
+{
+  GstSrtpDec *filter = GST_SRTP_DEC (parent);
+  DecodeListData data;
+  GstFlowReturn ret;
+
+  GST_LOG_OBJECT (pad, "Buffer chain with list of %d",
+      gst_buffer_list_length (buf_list));
+
+  data.filter = filter;
+  data.pad = pad;
+  data.is_rtcp = is_rtcp;
+  data.rtp_list = NULL;
+  data.rtcp_list = NULL;
+
+  /* the whole list is decoded with the lock taken once */
+  buf_list = gst_buffer_list_make_writable (buf_list);
+  GST_OBJECT_LOCK (filter);
+  gst_buffer_list_foreach (buf_list, decode_buffer_it, &data);
+  GST_OBJECT_UNLOCK (filter);
+  gst_buffer_list_unref (buf_list);
+
+  ret = gst_srtp_dec_push_list (filter, data.rtcp_list, TRUE);
+  if (ret != GST_FLOW_OK && ret != GST_FLOW_NOT_LINKED) {
+    if (data.rtp_list)
+      gst_buffer_list_unref (data.rtp_list);
+    return ret;
+  }
+
+  return gst_srtp_dec_push_list (filter, data.rtp_list, FALSE);
 }
 
 static GstFlowReturn
@@ -1489,6 +1595,20 @@ gst_srtp_dec_chain_rtcp (GstPad * pad, GstObject * parent, GstBuffer * buf)
   return gst_srtp_dec_chain (pad, parent, buf, TRUE);
 }
 
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, FALSE);
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtcp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, TRUE);
+}
+
 static GstStateChangeReturn
 gst_srtp_dec_change_state (GstElement * element, GstStateChange transition)
 {
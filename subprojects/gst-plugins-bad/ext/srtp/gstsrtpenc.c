@@ -133,6 +133,13 @@ GST_DEBUG_CATEGORY_STATIC (gst_srtp_enc_debug);
 #define DEFAULT_REPLAY_WINDOW_SIZE 128
 #define DEFAULT_ALLOW_REPEAT_TX FALSE
 
+/* Room needed to protect a packet of @size bytes */
+#define PROTECTED_SIZE(size) ((size) + SRTP_MAX_TRAILER_LEN + 10)
+
+/* Size of the output buffers of the pool, packets that do not fit in there
+ * get an output buffer of their own */
+#define POOL_BUFFER_SIZE PROTECTED_SIZE (1500)
+
 #define HAS_CRYPTO(filter) (filter->rtp_cipher != GST_SRTP_CIPHER_NULL || \
       filter->rtcp_cipher != GST_SRTP_CIPHER_NULL ||                      \
       filter->rtp_auth != GST_SRTP_AUTH_NULL ||                           \
@@ -161,15 +168,6 @@ enum
   PROP_MKI
 };
 
-typedef struct ProcessBufferItData
-{
-  GstSrtpEnc *filter;
-  GstPad *pad;
-  GstBufferList *out_list;
-  GstFlowReturn flowret;
-  gboolean is_rtcp;
-} ProcessBufferItData;
-
 /* the capabilities of the inputs and outputs.
  *
  * describe the real formats here.
@@ -352,6 +350,8 @@ gst_srtp_enc_class_init (GstSrtpEncClass * klass)
 static void
 gst_srtp_enc_init (GstSrtpEnc * filter)
 {
+  GstStructure *config;
+
   filter->key_changed = TRUE;
   filter->first_session = TRUE;
   filter->key = DEFAULT_MASTER_KEY;
@@ -362,6 +362,11 @@ gst_srtp_enc_init (GstSrtpEnc * filter)
   filter->replay_window_size = DEFAULT_REPLAY_WINDOW_SIZE;
   filter->allow_repeat_tx = DEFAULT_ALLOW_REPEAT_TX;
   filter->ssrcs_set = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  filter->pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (filter->pool);
+  gst_buffer_pool_config_set_params (config, NULL, POOL_BUFFER_SIZE, 0, 0);
+  gst_buffer_pool_set_config (filter->pool, config);
 }
 
 static guint
@@ -649,6 +654,8 @@ gst_srtp_enc_dispose (GObject * object)
     g_hash_table_unref (filter->ssrcs_set);
   filter->ssrcs_set = NULL;
 
+  gst_clear_object (&filter->pool);
+
   G_OBJECT_CLASS (gst_srtp_enc_parent_class)->dispose (object);
 }
 
@@ -1097,92 +1104,157 @@ gst_srtp_enc_check_set_caps (GstSrtpEnc * filter, GstPad * pad,
   return GST_FLOW_OK;
 }
 
+/* Adds the SSRC of @buf to the set of SSRCs. The lookup is skipped when it is
+ * the same as the one of the previous buffer, stored in @last_ssrc. */
 static void
-gst_srtp_enc_ensure_ssrc (GstSrtpEnc * filter, GstBuffer * buf)
+gst_srtp_enc_ensure_ssrc (GstSrtpEnc * filter, GstBuffer * buf,
+    gint64 * last_ssrc)
 {
   GstRTPBuffer rtpbuf = GST_RTP_BUFFER_INIT;
   if (gst_rtp_buffer_map (buf,
           GST_MAP_READ | GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING, &rtpbuf)) {
     guint32 ssrc = gst_rtp_buffer_get_ssrc (&rtpbuf);
-    gst_srtp_enc_add_ssrc (filter, ssrc);
+    if (ssrc != *last_ssrc) {
+      gst_srtp_enc_add_ssrc (filter, ssrc);
+      *last_ssrc = ssrc;
+    }
     gst_rtp_buffer_unmap (&rtpbuf);
   }
 }
 
-static GstFlowReturn
-gst_srtp_enc_process_buffer (GstSrtpEnc * filter, GstPad * pad,
-    GstBuffer * buf, gboolean is_rtcp, GstBuffer ** outbuf_ptr)
+/* Returns a writable buffer with the contents and metadata of @buf and room
+ * for the SRTP trailer. @buf itself is returned if it can be protected in
+ * place, otherwise it is copied into a buffer from the pool and unreffed. */
+static GstBuffer *
+gst_srtp_enc_prepare_buffer (GstSrtpEnc * filter, GstBuffer * buf)
 {
-  GstFlowReturn ret = GST_FLOW_OK;
-  gint size_max, size;
   GstBuffer *bufout = NULL;
   GstMapInfo mapout;
-  srtp_err_status_t err;
+  gsize size, offset, maxsize;
 
-  /* Create a bigger buffer to add protection */
   size = gst_buffer_get_size (buf);
-  size_max = size + SRTP_MAX_TRAILER_LEN + 10;
-  bufout = gst_buffer_new_allocate (NULL, size_max, NULL);
 
-  gst_buffer_map (bufout, &mapout, GST_MAP_READWRITE);
+  if (gst_buffer_is_writable (buf) && gst_buffer_n_memory (buf) == 1 &&
+      gst_memory_is_writable (gst_buffer_peek_memory (buf, 0))) {
+    gst_buffer_get_sizes (buf, &offset, &maxsize);
+    if (maxsize - offset >= PROTECTED_SIZE (size))
+      return buf;
+  }
+
+  if (PROTECTED_SIZE (size) > POOL_BUFFER_SIZE ||
+      gst_buffer_pool_acquire_buffer (filter->pool, &bufout,
+          NULL) != GST_FLOW_OK)
+    bufout = gst_buffer_new_allocate (NULL, PROTECTED_SIZE (size), NULL);
 
+  gst_buffer_map (bufout, &mapout, GST_MAP_WRITE);
   gst_buffer_extract (buf, 0, mapout.data, size);
+  gst_buffer_unmap (bufout, &mapout);
+  gst_buffer_set_size (bufout, size);
+  gst_buffer_copy_into (bufout, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  gst_buffer_unref (buf);
 
-  GST_OBJECT_LOCK (filter);
+  return bufout;
+}
 
-  gst_srtp_init_event_reporter ();
+/* Protects a buffer from gst_srtp_enc_prepare_buffer() in place, must be
+ * called with the object lock */
+static srtp_err_status_t
+gst_srtp_enc_protect_buffer (GstSrtpEnc * filter, GstPad * pad,
+    GstBuffer * buf, gboolean is_rtcp)
+{
+  GstMapInfo map;
+  srtp_err_status_t err;
+  gint size;
 
-  if (filter->session == NULL) {
-    /* The rtcp session disappeared (element shutting down) */
-    GST_OBJECT_UNLOCK (filter);
-    gst_buffer_unmap (bufout, &mapout);
-    ret = GST_FLOW_FLUSHING;
-    goto fail;
-  }
+  size = gst_buffer_get_size (buf);
+  gst_buffer_set_size (buf, PROTECTED_SIZE (size));
 
-  gst_srtp_enc_ensure_ssrc (filter, buf);
+  gst_buffer_map (buf, &map, GST_MAP_READWRITE);
 
   if (is_rtcp)
-    err = srtp_protect_rtcp_mki (filter->session, mapout.data, &size,
+    err = srtp_protect_rtcp_mki (filter->session, map.data, &size,
         (filter->mki != NULL), 0);
   else
-    err = srtp_protect_mki (filter->session, mapout.data, &size,
+    err = srtp_protect_mki (filter->session, map.data, &size,
         (filter->mki != NULL), 0);
 
-  GST_OBJECT_UNLOCK (filter);
-
-  gst_buffer_unmap (bufout, &mapout);
+  gst_buffer_unmap (buf, &map);
 
   if (err == srtp_err_status_ok) {
     /* Buffer protected */
-    gst_buffer_set_size (bufout, size);
-    gst_buffer_copy_into (bufout, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+    gst_buffer_set_size (buf, size);
 
     GST_LOG_OBJECT (pad, "Encoding %s buffer of size %d",
         is_rtcp ? "RTCP" : "RTP", size);
+  }
 
-  } else if (err == srtp_err_status_key_expired) {
+  return err;
+}
+
+/* Protects @buf, or all buffers of @list if it is not %NULL. The buffers
+ * must come from gst_srtp_enc_prepare_buffer(). The lock is only taken once
+ * for the whole list. */
+static GstFlowReturn
+gst_srtp_enc_protect (GstSrtpEnc * filter, GstPad * pad, GstBufferList * list,
+    GstBuffer * buf, gboolean is_rtcp)
+{
+  srtp_err_status_t err = srtp_err_status_ok;
+  gint64 last_ssrc = -1;
+  guint i, len;
+
+  len = list ? gst_buffer_list_length (list) : 1;
+
+  GST_OBJECT_LOCK (filter);
+
+  if (filter->session == NULL) {
+    /* The rtcp session disappeared (element shutting down) */
+    GST_OBJECT_UNLOCK (filter);
+    return GST_FLOW_FLUSHING;
+  }
+
+  gst_srtp_init_event_reporter ();
+
+  for (i = 0; i < len; i++) {
+    if (list)
+      buf = gst_buffer_list_get_writable (list, i);
+
+    gst_srtp_enc_ensure_ssrc (filter, buf, &last_ssrc);
+    err = gst_srtp_enc_protect_buffer (filter, pad, buf, is_rtcp);
+    if (err != srtp_err_status_ok)
+      break;
+  }
+
+  GST_OBJECT_UNLOCK (filter);
 
+  if (err == srtp_err_status_ok) {
+    return GST_FLOW_OK;
+  } else if (err == srtp_err_status_key_expired) {
     GST_ELEMENT_ERROR (GST_ELEMENT_CAST (filter), STREAM, ENCODE,
         ("Key usage limit has been reached"),
         ("Unable to protect buffer (hard key usage limit reached)"));
-    ret = GST_FLOW_ERROR;
-    goto fail;
-
   } else {
     /* srtp_protect failed */
     GST_ELEMENT_ERROR (filter, LIBRARY, FAILED, (NULL),
         ("Unable to protect buffer (protect failed) code %d", err));
-    ret = GST_FLOW_ERROR;
-    goto fail;
   }
 
-  *outbuf_ptr = bufout;
-  return ret;
+  return GST_FLOW_ERROR;
+}
 
-fail:
-  gst_buffer_unref (bufout);
-  return ret;
+static void
+gst_srtp_enc_check_soft_limit (GstSrtpEnc * filter)
+{
+  GST_OBJECT_LOCK (filter);
+
+  if (gst_srtp_get_soft_limit_reached ()) {
+    GST_OBJECT_UNLOCK (filter);
+    g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
+    GST_OBJECT_LOCK (filter);
+    if (filter->random_key && !filter->key_changed)
+      gst_srtp_enc_replace_random_key (filter);
+  }
+
+  GST_OBJECT_UNLOCK (filter);
 }
 
 static GstFlowReturn
@@ -1192,66 +1264,49 @@ gst_srtp_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
   GstSrtpEnc *filter = GST_SRTP_ENC (parent);
   GstFlowReturn ret = GST_FLOW_OK;
   GstPad *otherpad;
-  GstBuffer *bufout = NULL;
 
   if ((ret = gst_srtp_enc_check_set_caps (filter, pad, is_rtcp)) != GST_FLOW_OK) {
     goto out;
   }
 
+  otherpad = get_rtp_other_pad (pad);
+
   GST_OBJECT_LOCK (filter);
 
   if (!HAS_CRYPTO (filter)) {
     GST_OBJECT_UNLOCK (filter);
-    otherpad = get_rtp_other_pad (pad);
     return gst_pad_push (otherpad, buf);
   }
 
   GST_OBJECT_UNLOCK (filter);
 
-  ret = gst_srtp_enc_process_buffer (filter, pad, buf, is_rtcp, &bufout);
+  buf = gst_srtp_enc_prepare_buffer (filter, buf);
+
+  ret = gst_srtp_enc_protect (filter, pad, NULL, buf, is_rtcp);
   if (ret != GST_FLOW_OK)
     goto out;
 
   /* Push buffer to source pad */
-  otherpad = get_rtp_other_pad (pad);
-  ret = gst_pad_push (otherpad, bufout);
-  bufout = NULL;
+  ret = gst_pad_push (otherpad, buf);
+  buf = NULL;
 
   if (ret != GST_FLOW_OK)
     goto out;
 
-  GST_OBJECT_LOCK (filter);
-
-  if (gst_srtp_get_soft_limit_reached ()) {
-    GST_OBJECT_UNLOCK (filter);
-    g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
-    GST_OBJECT_LOCK (filter);
-    if (filter->random_key && !filter->key_changed)
-      gst_srtp_enc_replace_random_key (filter);
-  }
-
-  GST_OBJECT_UNLOCK (filter);
+  gst_srtp_enc_check_soft_limit (filter);
 
 out:
-  gst_buffer_unref (buf);
+  if (buf)
+    gst_buffer_unref (buf);
   return ret;
 }
 
 static gboolean
-process_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
+prepare_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
 {
-  ProcessBufferItData *data = user_data;
-  GstBuffer *bufout;
-  GstFlowReturn ret;
-
-  ret = gst_srtp_enc_process_buffer (data->filter, data->pad, *buffer,
-      data->is_rtcp, &bufout);
-  if (ret != GST_FLOW_OK) {
-    data->flowret = ret;
-    return FALSE;
-  }
+  GstSrtpEnc *filter = user_data;
 
-  gst_buffer_list_add (data->out_list, bufout);
+  *buffer = gst_srtp_enc_prepare_buffer (filter, *buffer);
 
   return TRUE;
 }
@@ -1263,8 +1318,6 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
   GstSrtpEnc *filter = GST_SRTP_ENC (parent);
   GstFlowReturn ret = GST_FLOW_OK;
   GstPad *otherpad;
-  GstBufferList *out_list = NULL;
-  ProcessBufferItData process_data;
 
   GST_LOG_OBJECT (pad, "Buffer chain with list of %d",
       gst_buffer_list_length (buf_list));
@@ -1275,60 +1328,39 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
   if ((ret = gst_srtp_enc_check_set_caps (filter, pad, is_rtcp)) != GST_FLOW_OK)
     goto out;
 
+  otherpad = get_rtp_other_pad (pad);
+
   GST_OBJECT_LOCK (filter);
 
   if (!HAS_CRYPTO (filter)) {
     GST_OBJECT_UNLOCK (filter);
-    otherpad = get_rtp_other_pad (pad);
     return gst_pad_push_list (otherpad, buf_list);
   }
 
   GST_OBJECT_UNLOCK (filter);
 
-  out_list = gst_buffer_list_new ();
-
-  process_data.filter = filter;
-  process_data.pad = pad;
-  process_data.is_rtcp = is_rtcp;
-  process_data.out_list = out_list;
-  process_data.flowret = GST_FLOW_OK;
+  /* copy what can't be protected in place outside of the lock */
+  buf_list = gst_buffer_list_make_writable (buf_list);
+  gst_buffer_list_foreach (buf_list, prepare_buffer_it, filter);
 
-  if (!gst_buffer_list_foreach (buf_list, process_buffer_it, &process_data)) {
-    ret = process_data.flowret;
+  if ((ret = gst_srtp_enc_protect (filter, pad, buf_list, NULL,
+              is_rtcp)) != GST_FLOW_OK)
     goto out;
-  }
-
-  if (!gst_buffer_list_length (out_list)) {
-    gst_buffer_list_unref (out_list);
-    ret = GST_FLOW_OK;
-    goto out;
-  }
 
   /* Push buffer to source pad */
-  otherpad = get_rtp_other_pad (pad);
   GST_LOG_OBJECT (pad, "Pushing buffer chain of %d",
       gst_buffer_list_length (buf_list));
-  ret = gst_pad_push_list (otherpad, out_list);
+  ret = gst_pad_push_list (otherpad, buf_list);
+  buf_list = NULL;
 
-  if (ret != GST_FLOW_OK) {
+  if (ret != GST_FLOW_OK)
     goto out;
-  }
-
-  GST_OBJECT_LOCK (filter);
-
-  if (gst_srtp_get_soft_limit_reached ()) {
-    GST_OBJECT_UNLOCK (filter);
-    g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
-    GST_OBJECT_LOCK (filter);
-    if (filter->random_key && !filter->key_changed)
-      gst_srtp_enc_replace_random_key (filter);
-  }
 
-  GST_OBJECT_UNLOCK (filter);
+  gst_srtp_enc_check_soft_limit (filter);
 
 out:
-
-  gst_buffer_list_unref (buf_list);
+  if (buf_list)
+    gst_buffer_list_unref (buf_list);
 
   return ret;
 }
@@ -1403,6 +1435,8 @@ gst_srtp_enc_change_state (GstElement * element, GstStateChange transition)
       GST_OBJECT_UNLOCK (filter);
       break;
     case GST_STATE_CHANGE_READY_TO_PAUSED:
+      if (!gst_buffer_pool_set_active (filter->pool, TRUE))
+        GST_WARNING_OBJECT (filter, "Could not activate buffer pool");
       break;
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
       break;
@@ -1418,6 +1452,7 @@ gst_srtp_enc_change_state (GstElement * element, GstStateChange transition)
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_srtp_enc_reset (filter);
+      gst_buffer_pool_set_active (filter->pool, FALSE);
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
       break;
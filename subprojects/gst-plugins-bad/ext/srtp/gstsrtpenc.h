@@ -86,6 +86,9 @@ struct _GstSrtpEnc
   gboolean allow_repeat_tx;
 
   GHashTable *ssrcs_set;
+
+  /* output buffers for packets that can't be protected in place */
+  GstBufferPool *pool;
 };
 
 struct _GstSrtpEncClass
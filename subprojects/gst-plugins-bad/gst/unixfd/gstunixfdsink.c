@@ -48,6 +48,7 @@
 
 #include <gst/base/base.h>
 #include <gst/allocators/allocators.h>
+#include <gst/video/video.h>
 
 #include <glib/gstdio.h>
 #include <gio/gio.h>
@@ -755,6 +756,32 @@ static gboolean
 gst_unix_fd_sink_propose_allocation (GstBaseSink * bsink, GstQuery * query)
 {
   GstAllocator *allocator = gst_shm_allocator_get ();
+  GstCaps *caps;
+  gboolean need_pool;
+  GstVideoInfo info;
+
+  gst_query_parse_allocation (query, &caps, &need_pool);
+
+  /* For raw video also offer a pool, so that producers that don't pick an
+   * allocator themselves still create their frames in shareable memory */
+  if (need_pool && caps && gst_caps_is_fixed (caps) &&
+      gst_caps_features_is_equal (gst_caps_get_features (caps, 0),
+          GST_CAPS_FEATURES_MEMORY_SYSTEM_MEMORY) &&
+      gst_video_info_from_caps (&info, caps)) {
+    GstBufferPool *pool = gst_video_buffer_pool_new ();
+    GstStructure *config = gst_buffer_pool_get_config (pool);
+
+    gst_buffer_pool_config_set_params (config, caps, info.size, 0, 0);
+    gst_buffer_pool_config_set_allocator (config, allocator, NULL);
+    gst_buffer_pool_config_add_option (config,
+        GST_BUFFER_POOL_OPTION_VIDEO_SHAREABLE_MEMORY);
+    if (gst_buffer_pool_set_config (pool, config))
+      gst_query_add_allocation_pool (query, pool, info.size, 0, 0);
+    else
+      GST_WARNING_OBJECT (bsink, "failed to configure shm video pool");
+    gst_object_unref (pool);
+  }
+
   gst_query_add_allocation_param (query, allocator, NULL);
   gst_object_unref (allocator);
 
@@ -26,6 +26,7 @@
 #include "gstscenechange.h"
 #include "gstzebrastripe.h"
 #include "gstvideodiff.h"
+#include "gstvideoladder.h"
 
 
 static gboolean
@@ -36,6 +37,7 @@ plugin_init (GstPlugin * plugin)
   ret |= GST_ELEMENT_REGISTER (scenechange, plugin);
   ret |= GST_ELEMENT_REGISTER (zebrastripe, plugin);
   ret |= GST_ELEMENT_REGISTER (videodiff, plugin);
+  ret |= GST_ELEMENT_REGISTER (videoladder, plugin);
 
   return ret;
 }
@@ -0,0 +1,1104 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+/**
+ * SECTION:element-videoladder
+ * @title: videoladder
+ *
+ * The videoladder element scales one input video stream to several output
+ * resolutions at once, e.g. to produce the renditions of an adaptive
+ * bitrate ladder.
+ *
+ * Each requested source pad has a #GstVideoLadderPad:width and
+ * #GstVideoLadderPad:height. Compared to a tee followed by one scaler per
+ * output, the input frame is only read by the largest rendition: with
+ * #GstVideoLadder:cascade enabled, every smaller rendition is scaled from
+ * the smallest already produced rendition that is at least as large, so
+ * 2160p is scaled to 1080p, 1080p to 720p and so on.
+ *
+ * The output renditions have the same format as the input, the pixel aspect
+ * ratio is adjusted so that the display aspect ratio is preserved.
+ *
+ * ## Example launch line
+ * |[
+ * gst-launch-1.0 videotestsrc ! video/x-raw,width=3840,height=2160 ! videoladder name=l \
+ *     l.src_0 ::width=1920 ::height=1080 ! queue ! fakesink \
+ *     l.src_1 ::width=1280 ::height=720 ! queue ! fakesink \
+ *     l.src_2 ::width=640 ::height=360 ! queue ! fakesink
+ * ]|
+ *
+ * Since: 1.28
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstvideoladder.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_video_ladder_debug_category);
+#define GST_CAT_DEFAULT gst_video_ladder_debug_category
+
+#define VIDEO_CAPS \
+    GST_VIDEO_CAPS_MAKE ("{ I420, YV12, Y42B, Y444, NV12, NV21, NV16, " \
+        "YUY2, UYVY, AYUV, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, " \
+        "RGB, BGR, GRAY8, GRAY16_LE, GRAY16_BE, I420_10LE, I422_10LE, " \
+        "Y444_10LE, P010_10LE, v210, AYUV64 }")
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VIDEO_CAPS));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src_%u",
+    GST_PAD_SRC,
+    GST_PAD_REQUEST,
+    GST_STATIC_CAPS (VIDEO_CAPS));
+
+/* GstVideoLadderPad */
+
+#define DEFAULT_PAD_WIDTH 0
+#define DEFAULT_PAD_HEIGHT 0
+
+enum
+{
+  PROP_PAD_0,
+  PROP_PAD_WIDTH,
+  PROP_PAD_HEIGHT,
+};
+
+struct _GstVideoLadderPad
+{
+  GstPad parent;
+
+  /* properties, protected by the object lock */
+  gint width;
+  gint height;
+
+  /* streaming thread */
+  gboolean configured;
+  GstVideoInfo info;
+  /* index of the rendition we scale from, -1 for the input */
+  gint source;
+  GstVideoConverter *convert;
+  GstBufferPool *pool;
+};
+
+G_DEFINE_TYPE (GstVideoLadderPad, gst_video_ladder_pad, GST_TYPE_PAD);
+
+static void gst_video_ladder_pad_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_video_ladder_pad_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_video_ladder_pad_finalize (GObject * object);
+
+static void
+gst_video_ladder_pad_class_init (GstVideoLadderPadClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+
+  gobject_class->set_property = gst_video_ladder_pad_set_property;
+  gobject_class->get_property = gst_video_ladder_pad_get_property;
+  gobject_class->finalize = gst_video_ladder_pad_finalize;
+
+  /**
+   * GstVideoLadderPad:width:
+   *
+   * Width of this rendition, 0 to keep the input width.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_PAD_WIDTH,
+      g_param_spec_int ("width", "Width",
+          "Width of this rendition (0 = input width)", 0, G_MAXINT,
+          DEFAULT_PAD_WIDTH,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_PLAYING |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoLadderPad:height:
+   *
+   * Height of this rendition, 0 to keep the input height.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_PAD_HEIGHT,
+      g_param_spec_int ("height", "Height",
+          "Height of this rendition (0 = input height)", 0, G_MAXINT,
+          DEFAULT_PAD_HEIGHT,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_PLAYING |
+          G_PARAM_STATIC_STRINGS));
+}
+
+static void
+gst_video_ladder_pad_init (GstVideoLadderPad * pad)
+{
+  pad->width = DEFAULT_PAD_WIDTH;
+  pad->height = DEFAULT_PAD_HEIGHT;
+  pad->source = -1;
+}
+
+static void
+gst_video_ladder_pad_reset (GstVideoLadderPad * pad)
+{
+  if (pad->convert) {
+    gst_video_converter_free (pad->convert);
+    pad->convert = NULL;
+  }
+  if (pad->pool) {
+    gst_buffer_pool_set_active (pad->pool, FALSE);
+    gst_object_unref (pad->pool);
+    pad->pool = NULL;
+  }
+  pad->configured = FALSE;
+  pad->source = -1;
+}
+
+static void
+gst_video_ladder_pad_finalize (GObject * object)
+{
+  gst_video_ladder_pad_reset (GST_VIDEO_LADDER_PAD (object));
+
+  G_OBJECT_CLASS (gst_video_ladder_pad_parent_class)->finalize (object);
+}
+
+/* GstVideoLadder */
+
+#define DEFAULT_METHOD GST_VIDEO_RESAMPLER_METHOD_CUBIC
+#define DEFAULT_N_THREADS 1
+#define DEFAULT_CASCADE TRUE
+
+enum
+{
+  PROP_0,
+  PROP_METHOD,
+  PROP_N_THREADS,
+  PROP_CASCADE,
+};
+
+struct _GstVideoLadder
+{
+  GstElement parent;
+
+  GstPad *sinkpad;
+
+  /* properties and pad bookkeeping, protected by the object lock */
+  GstVideoResamplerMethod method;
+  guint n_threads;
+  gboolean cascade;
+  guint next_pad_index;
+  gboolean reconfigure;
+
+  /* streaming thread */
+  gboolean have_info;
+  GstVideoInfo in_info;
+  /* GstVideoLadderPad, largest rendition first */
+  GPtrArray *levels;
+};
+
+G_DEFINE_TYPE_WITH_CODE (GstVideoLadder, gst_video_ladder, GST_TYPE_ELEMENT,
+    GST_DEBUG_CATEGORY_INIT (gst_video_ladder_debug_category, "videoladder", 0,
+        "debug category for videoladder element"));
+GST_ELEMENT_REGISTER_DEFINE (videoladder, "videoladder",
+    GST_RANK_NONE, GST_TYPE_VIDEO_LADDER);
+
+static void gst_video_ladder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_video_ladder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_video_ladder_finalize (GObject * object);
+
+static GstStateChangeReturn gst_video_ladder_change_state (GstElement *
+    element, GstStateChange transition);
+static GstPad *gst_video_ladder_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps);
+static void gst_video_ladder_release_pad (GstElement * element, GstPad * pad);
+
+static GstFlowReturn gst_video_ladder_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buffer);
+static gboolean gst_video_ladder_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event);
+static gboolean gst_video_ladder_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query);
+static gboolean gst_video_ladder_src_query (GstPad * pad, GstObject * parent,
+    GstQuery * query);
+
+static void
+gst_video_ladder_class_init (GstVideoLadderClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstElementClass *element_class = (GstElementClass *) klass;
+
+  gobject_class->set_property = gst_video_ladder_set_property;
+  gobject_class->get_property = gst_video_ladder_get_property;
+  gobject_class->finalize = gst_video_ladder_finalize;
+
+  /**
+   * GstVideoLadder:method:
+   *
+   * Resampling method used for all renditions.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_METHOD,
+      g_param_spec_enum ("method", "Method", "Resampling method",
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, DEFAULT_METHOD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoLadder:n-threads:
+   *
+   * Maximum number of threads each rendition is scaled with, 0 for the
+   * number of CPUs.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = number of CPUs)", 0,
+          G_MAXUINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoLadder:cascade:
+   *
+   * Scale each rendition from the next larger rendition instead of from
+   * the input frame. This saves memory bandwidth and scaling work at the
+   * cost of some additional softening of the smaller renditions.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_CASCADE,
+      g_param_spec_boolean ("cascade", "Cascade",
+          "Scale each rendition from the next larger one", DEFAULT_CASCADE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+  gst_element_class_add_static_pad_template_with_gtype (element_class,
+      &src_template, GST_TYPE_VIDEO_LADDER_PAD);
+
+  gst_element_class_set_static_metadata (element_class,
+      "Video ladder scaler", "Filter/Converter/Video/Scaler",
+      "Scales a video stream to multiple resolutions",
+      "GStreamer maintainers <gstreamer-devel@lists.freedesktop.org>");
+
+  element_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_video_ladder_change_state);
+  element_class->request_new_pad =
+      GST_DEBUG_FUNCPTR (gst_video_ladder_request_new_pad);
+  element_class->release_pad = GST_DEBUG_FUNCPTR (gst_video_ladder_release_pad);
+
+  gst_type_mark_as_plugin_api (GST_TYPE_VIDEO_LADDER_PAD, 0);
+}
+
+static void
+gst_video_ladder_init (GstVideoLadder * self)
+{
+  self->sinkpad = gst_pad_new_from_static_template (&sink_template, "sink");
+  gst_pad_set_chain_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_video_ladder_chain));
+  gst_pad_set_event_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_video_ladder_sink_event));
+  gst_pad_set_query_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_video_ladder_sink_query));
+  gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
+
+  self->method = DEFAULT_METHOD;
+  self->n_threads = DEFAULT_N_THREADS;
+  self->cascade = DEFAULT_CASCADE;
+  self->reconfigure = TRUE;
+  self->levels = g_ptr_array_new_with_free_func (gst_object_unref);
+}
+
+static void
+gst_video_ladder_finalize (GObject * object)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (object);
+
+  g_ptr_array_unref (self->levels);
+
+  G_OBJECT_CLASS (gst_video_ladder_parent_class)->finalize (object);
+}
+
+static void
+gst_video_ladder_mark_reconfigure (GstVideoLadder * self)
+{
+  GST_OBJECT_LOCK (self);
+  self->reconfigure = TRUE;
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_video_ladder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (prop_id) {
+    case PROP_METHOD:
+      self->method = g_value_get_enum (value);
+      break;
+    case PROP_N_THREADS:
+      self->n_threads = g_value_get_uint (value);
+      break;
+    case PROP_CASCADE:
+      self->cascade = g_value_get_boolean (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  self->reconfigure = TRUE;
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_video_ladder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (object);
+
+  GST_OBJECT_LOCK (self);
+  switch (prop_id) {
+    case PROP_METHOD:
+      g_value_set_enum (value, self->method);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, self->n_threads);
+      break;
+    case PROP_CASCADE:
+      g_value_set_boolean (value, self->cascade);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+static void
+gst_video_ladder_pad_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoLadderPad *pad = GST_VIDEO_LADDER_PAD (object);
+  GstElement *parent;
+
+  GST_OBJECT_LOCK (pad);
+  switch (prop_id) {
+    case PROP_PAD_WIDTH:
+      pad->width = g_value_get_int (value);
+      break;
+    case PROP_PAD_HEIGHT:
+      pad->height = g_value_get_int (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (pad);
+
+  parent = gst_pad_get_parent_element (GST_PAD (pad));
+  if (parent) {
+    gst_video_ladder_mark_reconfigure (GST_VIDEO_LADDER (parent));
+    gst_object_unref (parent);
+  }
+}
+
+static void
+gst_video_ladder_pad_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoLadderPad *pad = GST_VIDEO_LADDER_PAD (object);
+
+  GST_OBJECT_LOCK (pad);
+  switch (prop_id) {
+    case PROP_PAD_WIDTH:
+      g_value_set_int (value, pad->width);
+      break;
+    case PROP_PAD_HEIGHT:
+      g_value_set_int (value, pad->height);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (pad);
+}
+
+typedef struct
+{
+  GstPad *srcpad;
+  gboolean before_caps;
+} StickyData;
+
+static gboolean
+store_sticky_events (GstPad * pad, GstEvent ** event, gpointer user_data)
+{
+  StickyData *data = user_data;
+  GstEventType type = GST_EVENT_TYPE (*event);
+
+  /* every rendition has its own caps */
+  if (type == GST_EVENT_CAPS)
+    return TRUE;
+
+  if ((type < GST_EVENT_CAPS) == data->before_caps)
+    gst_pad_store_sticky_event (data->srcpad, *event);
+
+  return TRUE;
+}
+
+static void
+gst_video_ladder_store_sticky_events (GstVideoLadder * self, GstPad * srcpad,
+    GstCaps * caps)
+{
+  StickyData data = { srcpad, TRUE };
+  GstEvent *event;
+
+  gst_pad_sticky_events_foreach (self->sinkpad, store_sticky_events, &data);
+  event = gst_event_new_caps (caps);
+  gst_pad_store_sticky_event (srcpad, event);
+  gst_event_unref (event);
+  data.before_caps = FALSE;
+  gst_pad_sticky_events_foreach (self->sinkpad, store_sticky_events, &data);
+}
+
+static GstPad *
+gst_video_ladder_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (element);
+  gchar *pad_name = NULL;
+  GstPad *pad;
+
+  GST_OBJECT_LOCK (self);
+  if (name == NULL)
+    name = pad_name = g_strdup_printf ("src_%u", self->next_pad_index);
+  self->next_pad_index++;
+  self->reconfigure = TRUE;
+  GST_OBJECT_UNLOCK (self);
+
+  pad = g_object_new (GST_TYPE_VIDEO_LADDER_PAD, "name", name,
+      "direction", templ->direction, "template", templ, NULL);
+  g_free (pad_name);
+
+  gst_pad_set_query_function (pad,
+      GST_DEBUG_FUNCPTR (gst_video_ladder_src_query));
+
+  /* the sticky events are stored on the pad once it is configured, with
+   * its own caps */
+  if (GST_PAD_IS_ACTIVE (self->sinkpad))
+    gst_pad_set_active (pad, TRUE);
+  gst_element_add_pad (element, pad);
+
+  return pad;
+}
+
+static void
+gst_video_ladder_release_pad (GstElement * element, GstPad * pad)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (element);
+
+  GST_DEBUG_OBJECT (self, "releasing pad %s:%s", GST_DEBUG_PAD_NAME (pad));
+
+  gst_video_ladder_mark_reconfigure (self);
+
+  gst_pad_set_active (pad, FALSE);
+  gst_element_remove_pad (element, pad);
+}
+
+static gint
+compare_level_size (gconstpointer a, gconstpointer b)
+{
+  const GstVideoLadderPad *pa = *(const GstVideoLadderPad **) a;
+  const GstVideoLadderPad *pb = *(const GstVideoLadderPad **) b;
+  guint64 size_a, size_b;
+
+  size_a = (guint64) GST_VIDEO_INFO_WIDTH (&pa->info) *
+      GST_VIDEO_INFO_HEIGHT (&pa->info);
+  size_b = (guint64) GST_VIDEO_INFO_WIDTH (&pb->info) *
+      GST_VIDEO_INFO_HEIGHT (&pb->info);
+
+  if (size_a > size_b)
+    return -1;
+  if (size_a < size_b)
+    return 1;
+  return 0;
+}
+
+static GstCaps *
+gst_video_ladder_make_caps (GstVideoLadder * self, gint width, gint height)
+{
+  GstVideoInfo *in_info = &self->in_info;
+  GstCaps *caps;
+  gint par_n, par_d;
+
+  if (width <= 0)
+    width = GST_VIDEO_INFO_WIDTH (in_info);
+  if (height <= 0)
+    height = GST_VIDEO_INFO_HEIGHT (in_info);
+
+  /* keep the display aspect ratio of the input */
+  if (!gst_util_fraction_multiply (GST_VIDEO_INFO_PAR_N (in_info) *
+          GST_VIDEO_INFO_WIDTH (in_info),
+          GST_VIDEO_INFO_PAR_D (in_info) * GST_VIDEO_INFO_HEIGHT (in_info),
+          height, width, &par_n, &par_d)) {
+    par_n = GST_VIDEO_INFO_PAR_N (in_info);
+    par_d = GST_VIDEO_INFO_PAR_D (in_info);
+  }
+
+  caps = gst_video_info_to_caps (in_info);
+  gst_caps_set_simple (caps, "width", G_TYPE_INT, width,
+      "height", G_TYPE_INT, height,
+      "pixel-aspect-ratio", GST_TYPE_FRACTION, par_n, par_d, NULL);
+
+  return caps;
+}
+
+static GstBufferPool *
+gst_video_ladder_create_pool (GstCaps * caps, GstVideoInfo * info)
+{
+  GstBufferPool *pool;
+  GstStructure *config;
+
+  pool = gst_video_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, info->size, 0, 0);
+  gst_buffer_pool_config_add_option (config, GST_BUFFER_POOL_OPTION_VIDEO_META);
+
+  if (!gst_buffer_pool_set_config (pool, config) ||
+      !gst_buffer_pool_set_active (pool, TRUE)) {
+    gst_object_unref (pool);
+    return NULL;
+  }
+  return pool;
+}
+
+/* called from the streaming thread when pads, their sizes, the properties
+ * or the input caps changed */
+static gboolean
+gst_video_ladder_configure (GstVideoLadder * self)
+{
+  GstVideoResamplerMethod method;
+  guint n_threads;
+  gboolean cascade;
+  GList *l;
+  guint i;
+  gint k;
+
+  g_ptr_array_set_size (self->levels, 0);
+
+  GST_OBJECT_LOCK (self);
+  method = self->method;
+  n_threads = self->n_threads;
+  cascade = self->cascade;
+  for (l = GST_ELEMENT (self)->srcpads; l; l = l->next)
+    g_ptr_array_add (self->levels, gst_object_ref (l->data));
+  self->reconfigure = FALSE;
+  GST_OBJECT_UNLOCK (self);
+
+  for (i = 0; i < self->levels->len; i++) {
+    GstVideoLadderPad *pad = g_ptr_array_index (self->levels, i);
+    GstVideoInfo info;
+    GstCaps *caps;
+    gint width, height;
+
+    GST_OBJECT_LOCK (pad);
+    width = pad->width;
+    height = pad->height;
+    GST_OBJECT_UNLOCK (pad);
+
+    caps = gst_video_ladder_make_caps (self, width, height);
+    if (!gst_video_info_from_caps (&info, caps)) {
+      gst_caps_unref (caps);
+      goto invalid_caps;
+    }
+
+    if (!pad->configured || !gst_video_info_is_equal (&info, &pad->info)) {
+      gboolean was_configured = pad->configured;
+
+      GST_DEBUG_OBJECT (pad, "new caps %" GST_PTR_FORMAT, caps);
+
+      gst_video_ladder_pad_reset (pad);
+      pad->info = info;
+      pad->pool = gst_video_ladder_create_pool (caps, &info);
+      if (!pad->pool) {
+        gst_caps_unref (caps);
+        goto no_pool;
+      }
+
+      if (was_configured) {
+        gst_pad_push_event (GST_PAD (pad), gst_event_new_caps (caps));
+      } else {
+        /* a new pad, catch up on the events of the input */
+        gst_video_ladder_store_sticky_events (self, GST_PAD (pad), caps);
+      }
+      pad->configured = TRUE;
+    }
+    gst_caps_unref (caps);
+  }
+
+  g_ptr_array_sort (self->levels, compare_level_size);
+
+  for (i = 0; i < self->levels->len; i++) {
+    GstVideoLadderPad *pad = g_ptr_array_index (self->levels, i);
+    GstVideoInfo *src_info;
+    gint width = GST_VIDEO_INFO_WIDTH (&pad->info);
+    gint height = GST_VIDEO_INFO_HEIGHT (&pad->info);
+
+    /* the smallest rendition that is at least as large as this one */
+    pad->source = -1;
+    if (cascade) {
+      for (k = (gint) i - 1; k >= 0; k--) {
+        GstVideoLadderPad *prev = g_ptr_array_index (self->levels, k);
+
+        if (GST_VIDEO_INFO_WIDTH (&prev->info) >= width &&
+            GST_VIDEO_INFO_HEIGHT (&prev->info) >= height) {
+          pad->source = k;
+          break;
+        }
+      }
+    }
+
+    if (pad->source < 0) {
+      src_info = &self->in_info;
+    } else {
+      GstVideoLadderPad *prev = g_ptr_array_index (self->levels, pad->source);
+      src_info = &prev->info;
+    }
+
+    GST_DEBUG_OBJECT (pad, "scaling %dx%d from %s %dx%d", width, height,
+        pad->source < 0 ? "input" : "rendition",
+        GST_VIDEO_INFO_WIDTH (src_info), GST_VIDEO_INFO_HEIGHT (src_info));
+
+    if (pad->convert)
+      gst_video_converter_free (pad->convert);
+    pad->convert = gst_video_converter_new (src_info, &pad->info,
+        gst_structure_new ("GstVideoConverter",
+            GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+            GST_TYPE_VIDEO_RESAMPLER_METHOD, method,
+            GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+    if (!pad->convert)
+      goto no_converter;
+  }
+
+  return TRUE;
+
+  /* ERRORS */
+invalid_caps:
+  {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("Invalid output size"));
+    return FALSE;
+  }
+no_pool:
+  {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS, (NULL),
+        ("Failed to create buffer pool"));
+    return FALSE;
+  }
+no_converter:
+  {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("Failed to create converter"));
+    return FALSE;
+  }
+}
+
+static GstFlowReturn
+gst_video_ladder_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (parent);
+  GstVideoFrame in_frame, *frames;
+  GstBuffer **outbufs;
+  GstFlowReturn ret = GST_FLOW_OK;
+  gboolean reconfigure, all_eos = TRUE, all_not_linked = TRUE;
+  guint i, n_levels, n_done;
+
+  if (!self->have_info)
+    goto not_negotiated;
+
+  GST_OBJECT_LOCK (self);
+  reconfigure = self->reconfigure;
+  GST_OBJECT_UNLOCK (self);
+
+  if (reconfigure && !gst_video_ladder_configure (self)) {
+    gst_buffer_unref (buffer);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  n_levels = self->levels->len;
+  if (n_levels == 0) {
+    gst_buffer_unref (buffer);
+    return GST_FLOW_NOT_LINKED;
+  }
+
+  if (!gst_video_frame_map (&in_frame, &self->in_info, buffer, GST_MAP_READ))
+    goto map_failed;
+
+  frames = g_newa (GstVideoFrame, n_levels);
+  outbufs = g_newa (GstBuffer *, n_levels);
+
+  /* largest rendition first, the smaller ones can then read from it */
+  for (n_done = 0; n_done < n_levels; n_done++) {
+    GstVideoLadderPad *lpad = g_ptr_array_index (self->levels, n_done);
+    GstVideoFrame *src_frame;
+
+    ret = gst_buffer_pool_acquire_buffer (lpad->pool, &outbufs[n_done], NULL);
+    if (ret != GST_FLOW_OK)
+      break;
+
+    if (!gst_video_frame_map (&frames[n_done], &lpad->info, outbufs[n_done],
+            GST_MAP_READWRITE)) {
+      gst_buffer_unref (outbufs[n_done]);
+      ret = GST_FLOW_ERROR;
+      break;
+    }
+
+    src_frame = lpad->source < 0 ? &in_frame : &frames[lpad->source];
+    gst_video_converter_frame (lpad->convert, src_frame, &frames[n_done]);
+
+    gst_buffer_copy_into (outbufs[n_done], buffer,
+        GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+  }
+
+  for (i = 0; i < n_done; i++)
+    gst_video_frame_unmap (&frames[i]);
+  gst_video_frame_unmap (&in_frame);
+  gst_buffer_unref (buffer);
+
+  if (ret != GST_FLOW_OK) {
+    for (i = 0; i < n_done; i++)
+      gst_buffer_unref (outbufs[i]);
+    GST_DEBUG_OBJECT (self, "failed to produce output: %s",
+        gst_flow_get_name (ret));
+    return ret;
+  }
+
+  for (i = 0; i < n_levels; i++) {
+    GstPad *srcpad = g_ptr_array_index (self->levels, i);
+    GstFlowReturn res;
+
+    if (ret != GST_FLOW_OK) {
+      gst_buffer_unref (outbufs[i]);
+      continue;
+    }
+
+    res = gst_pad_push (srcpad, outbufs[i]);
+
+    /* a pad that was released in the meantime */
+    if (res == GST_FLOW_FLUSHING) {
+      GST_OBJECT_LOCK (srcpad);
+      if (GST_OBJECT_PARENT (srcpad) != parent)
+        res = GST_FLOW_NOT_LINKED;
+      GST_OBJECT_UNLOCK (srcpad);
+    }
+
+    if (res == GST_FLOW_FLUSHING || res < GST_FLOW_EOS)
+      ret = res;
+    if (res != GST_FLOW_EOS)
+      all_eos = FALSE;
+    if (res != GST_FLOW_NOT_LINKED)
+      all_not_linked = FALSE;
+  }
+
+  if (ret == GST_FLOW_OK) {
+    if (all_not_linked)
+      ret = GST_FLOW_NOT_LINKED;
+    else if (all_eos)
+      ret = GST_FLOW_EOS;
+  }
+
+  return ret;
+
+  /* ERRORS */
+not_negotiated:
+  {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("No input format negotiated"));
+    gst_buffer_unref (buffer);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+map_failed:
+  {
+    GST_ELEMENT_ERROR (self, RESOURCE, READ, (NULL),
+        ("Failed to map input buffer"));
+    gst_buffer_unref (buffer);
+    return GST_FLOW_ERROR;
+  }
+}
+
+static gboolean
+gst_video_ladder_forward_event (GstVideoLadder * self, GstEvent * event)
+{
+  GList *pads = NULL, *l;
+  gboolean ret = TRUE;
+
+  GST_OBJECT_LOCK (self);
+  for (l = GST_ELEMENT (self)->srcpads; l; l = l->next)
+    pads = g_list_prepend (pads, gst_object_ref (l->data));
+  GST_OBJECT_UNLOCK (self);
+
+  for (l = pads; l; l = l->next) {
+    GstVideoLadderPad *pad = l->data;
+
+    /* pads without caps yet get the sticky events when they are
+     * configured, storing them now would put them before the caps */
+    if (GST_EVENT_IS_STICKY (event) && self->have_info && !pad->configured)
+      continue;
+
+    if (!gst_pad_push_event (GST_PAD (pad), gst_event_ref (event)))
+      ret = FALSE;
+  }
+  g_list_free_full (pads, gst_object_unref);
+  gst_event_unref (event);
+
+  return ret;
+}
+
+static gboolean
+gst_video_ladder_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (parent);
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+      GstVideoInfo info;
+
+      gst_event_parse_caps (event, &caps);
+      if (!gst_video_info_from_caps (&info, caps)) {
+        GST_WARNING_OBJECT (self, "invalid caps %" GST_PTR_FORMAT, caps);
+        gst_event_unref (event);
+        return FALSE;
+      }
+
+      self->in_info = info;
+      self->have_info = TRUE;
+      gst_event_unref (event);
+
+      /* configure right away so that the caps of every rendition go out
+       * before the segment */
+      gst_video_ladder_mark_reconfigure (self);
+      return gst_video_ladder_configure (self);
+    }
+    case GST_EVENT_SEGMENT:
+    case GST_EVENT_EOS:
+    {
+      gboolean reconfigure;
+
+      /* make sure pads requested since the last configuration get their
+       * caps first */
+      GST_OBJECT_LOCK (self);
+      reconfigure = self->reconfigure;
+      GST_OBJECT_UNLOCK (self);
+
+      if (reconfigure && self->have_info
+          && !gst_video_ladder_configure (self)) {
+        gst_event_unref (event);
+        return FALSE;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  return gst_video_ladder_forward_event (self, event);
+}
+
+/* the input caps downstream of @pad would accept, any size */
+static GstCaps *
+gst_video_ladder_strip_size (GstCaps * caps)
+{
+  GstCaps *res;
+  guint i, n;
+
+  res = gst_caps_new_empty ();
+  n = gst_caps_get_size (caps);
+  for (i = 0; i < n; i++) {
+    GstStructure *s = gst_caps_get_structure (caps, i);
+    GstCapsFeatures *f = gst_caps_get_features (caps, i);
+
+    if (i > 0 && gst_caps_is_subset_structure_full (res, s, f))
+      continue;
+
+    s = gst_structure_copy (s);
+    gst_structure_set (s, "width", GST_TYPE_INT_RANGE, 1, G_MAXINT,
+        "height", GST_TYPE_INT_RANGE, 1, G_MAXINT, NULL);
+    gst_structure_remove_field (s, "pixel-aspect-ratio");
+
+    gst_caps_append_structure_full (res, s, gst_caps_features_copy (f));
+  }
+
+  return res;
+}
+
+static GstCaps *
+gst_video_ladder_sink_getcaps (GstVideoLadder * self, GstCaps * filter)
+{
+  GstCaps *res;
+  GList *pads = NULL, *l;
+
+  res = gst_pad_get_pad_template_caps (self->sinkpad);
+
+  GST_OBJECT_LOCK (self);
+  for (l = GST_ELEMENT (self)->srcpads; l; l = l->next)
+    pads = g_list_prepend (pads, gst_object_ref (l->data));
+  GST_OBJECT_UNLOCK (self);
+
+  for (l = pads; l && !gst_caps_is_empty (res); l = l->next) {
+    GstCaps *peercaps, *stripped, *tmp;
+
+    peercaps = gst_pad_peer_query_caps (l->data, NULL);
+    stripped = gst_video_ladder_strip_size (peercaps);
+    tmp = gst_caps_intersect (res, stripped);
+    gst_caps_unref (res);
+    gst_caps_unref (stripped);
+    gst_caps_unref (peercaps);
+    res = tmp;
+  }
+  g_list_free_full (pads, gst_object_unref);
+
+  if (filter) {
+    GstCaps *tmp;
+
+    tmp = gst_caps_intersect_full (filter, res, GST_CAPS_INTERSECT_FIRST);
+    gst_caps_unref (res);
+    res = tmp;
+  }
+
+  return res;
+}
+
+static gboolean
+gst_video_ladder_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (parent);
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *filter, *caps;
+
+      gst_query_parse_caps (query, &filter);
+      caps = gst_video_ladder_sink_getcaps (self, filter);
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      return TRUE;
+    }
+    case GST_QUERY_ALLOCATION:
+      /* every output has a different size, nothing to forward */
+      return FALSE;
+    default:
+      break;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+static GstCaps *
+gst_video_ladder_src_getcaps (GstVideoLadder * self, GstVideoLadderPad * pad,
+    GstCaps * filter)
+{
+  GstCaps *tmpl, *peercaps, *res;
+  gint width, height;
+  guint i, n;
+
+  GST_OBJECT_LOCK (pad);
+  width = pad->width;
+  height = pad->height;
+  GST_OBJECT_UNLOCK (pad);
+
+  tmpl = gst_pad_get_pad_template_caps (GST_PAD (pad));
+  peercaps = gst_pad_peer_query_caps (self->sinkpad, tmpl);
+  gst_caps_unref (tmpl);
+
+  res = gst_caps_make_writable (peercaps);
+  n = gst_caps_get_size (res);
+  for (i = 0; i < n; i++) {
+    GstStructure *s = gst_caps_get_structure (res, i);
+
+    if (width > 0)
+      gst_structure_set (s, "width", G_TYPE_INT, width, NULL);
+    if (height > 0)
+      gst_structure_set (s, "height", G_TYPE_INT, height, NULL);
+    gst_structure_remove_field (s, "pixel-aspect-ratio");
+  }
+
+  if (filter) {
+    GstCaps *tmp;
+
+    tmp = gst_caps_intersect_full (filter, res, GST_CAPS_INTERSECT_FIRST);
+    gst_caps_unref (res);
+    res = tmp;
+  }
+
+  return res;
+}
+
+static gboolean
+gst_video_ladder_src_query (GstPad * pad, GstObject * parent, GstQuery * query)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (parent);
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *filter, *caps;
+
+      gst_query_parse_caps (query, &filter);
+      caps = gst_video_ladder_src_getcaps (self, GST_VIDEO_LADDER_PAD (pad),
+          filter);
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      return TRUE;
+    }
+    default:
+      break;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+static GstStateChangeReturn
+gst_video_ladder_change_state (GstElement * element, GstStateChange transition)
+{
+  GstVideoLadder *self = GST_VIDEO_LADDER (element);
+  GstStateChangeReturn ret;
+  guint i;
+
+  ret = GST_ELEMENT_CLASS (gst_video_ladder_parent_class)->change_state
+      (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      for (i = 0; i < self->levels->len; i++)
+        gst_video_ladder_pad_reset (g_ptr_array_index (self->levels, i));
+      g_ptr_array_set_size (self->levels, 0);
+      self->have_info = FALSE;
+      gst_video_ladder_mark_reconfigure (self);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
@@ -0,0 +1,39 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _GST_VIDEO_LADDER_H_
+#define _GST_VIDEO_LADDER_H_
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_VIDEO_LADDER_PAD (gst_video_ladder_pad_get_type())
+G_DECLARE_FINAL_TYPE (GstVideoLadderPad, gst_video_ladder_pad,
+    GST, VIDEO_LADDER_PAD, GstPad);
+
+#define GST_TYPE_VIDEO_LADDER (gst_video_ladder_get_type())
+G_DECLARE_FINAL_TYPE (GstVideoLadder, gst_video_ladder,
+    GST, VIDEO_LADDER, GstElement);
+
+GST_ELEMENT_REGISTER_DECLARE (videoladder);
+
+G_END_DECLS
+
+#endif
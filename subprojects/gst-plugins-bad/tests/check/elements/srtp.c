@@ -249,6 +249,124 @@ GST_START_TEST (test_roc)
 
 GST_END_TEST;
 
+static GstStaticPadTemplate harness_src_template =
+GST_STATIC_PAD_TEMPLATE ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+static GstStaticPadTemplate harness_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+#define LIST_TEST_PAYLOAD_SIZE 160
+/* more than the SRTP trailer with the longest tag and MKI */
+#define LIST_TEST_SPARE_SIZE 256
+
+/* an RTP packet for the request_key() caps with @extra bytes of free space
+ * after it */
+static GstBuffer *
+make_list_test_packet (guint16 seqnum, gsize extra)
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+
+  buf = gst_buffer_new_allocate (NULL, 12 + LIST_TEST_PAYLOAD_SIZE + extra,
+      NULL);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  memset (map.data, seqnum & 0xff, map.size);
+  GST_WRITE_UINT8 (map.data, 0x80);
+  GST_WRITE_UINT8 (map.data + 1, 8);
+  GST_WRITE_UINT16_BE (map.data + 2, seqnum);
+  GST_WRITE_UINT32_BE (map.data + 4, seqnum * LIST_TEST_PAYLOAD_SIZE);
+  GST_WRITE_UINT32_BE (map.data + 8, 1356955624);
+  gst_buffer_unmap (buf, &map);
+  gst_buffer_set_size (buf, 12 + LIST_TEST_PAYLOAD_SIZE);
+
+  return buf;
+}
+
+GST_START_TEST (test_buffer_list)
+{
+  GstElement *enc;
+  GstHarness *h_enc, *h_dec;
+  GstBufferList *list;
+  GstBuffer *orig[4], *buf;
+  GstMemory *in_place_mem;
+  gint i;
+
+  enc = gst_element_factory_make ("srtpenc", NULL);
+  gst_util_set_object_arg (G_OBJECT (enc), "key",
+      "012345678901234567890123456789012345678901234567890123456789");
+  h_enc = gst_harness_new_full (enc, &harness_src_template, "rtp_sink_0",
+      &harness_sink_template, "rtp_src_0");
+  gst_object_unref (enc);
+  gst_harness_set_caps_str (h_enc,
+      "application/x-rtp, payload=(int)8, ssrc=(uint)1356955624",
+      "application/x-srtp");
+
+  h_dec = gst_harness_new_with_padnames ("srtpdec", "rtp_sink", "rtp_src");
+  gst_harness_set_caps (h_dec, request_key (),
+      gst_caps_from_string ("application/x-rtp"));
+
+  /* protected in place, copied because too small and copied because
+   * made of multiple memories */
+  orig[0] = make_list_test_packet (1, LIST_TEST_SPARE_SIZE);
+  orig[1] = make_list_test_packet (2, 0);
+  orig[2] = make_list_test_packet (3, 0);
+  buf = make_list_test_packet (4, LIST_TEST_SPARE_SIZE);
+  orig[3] = gst_buffer_copy_region (buf, GST_BUFFER_COPY_ALL, 0, 12);
+  gst_buffer_append (orig[3], gst_buffer_copy_region (buf,
+          GST_BUFFER_COPY_MEMORY, 12, LIST_TEST_PAYLOAD_SIZE));
+  gst_buffer_unref (buf);
+
+  /* a deep copy has no free space left after the data, so the first packet
+   * is pushed as a new buffer with the same content */
+  list = gst_buffer_list_new ();
+  buf = make_list_test_packet (1, LIST_TEST_SPARE_SIZE);
+  in_place_mem = gst_buffer_peek_memory (buf, 0);
+  gst_buffer_list_add (list, buf);
+  for (i = 1; i < 4; i++)
+    gst_buffer_list_add (list, gst_buffer_copy_deep (orig[i]));
+  fail_unless_equals_int (gst_pad_push_list (h_enc->srcpad, list),
+      GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h_enc), 4);
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 4; i++) {
+    GstMapInfo map;
+
+    buf = gst_harness_pull (h_enc);
+    if (i == 0)
+      fail_unless (gst_buffer_peek_memory (buf, 0) == in_place_mem);
+    else
+      fail_unless (gst_buffer_peek_memory (buf, 0) != in_place_mem);
+    gst_buffer_map (orig[i], &map, GST_MAP_READ);
+    fail_unless (gst_buffer_get_size (buf) > map.size);
+    fail_unless (gst_buffer_memcmp (buf, 12, map.data + 12,
+            LIST_TEST_PAYLOAD_SIZE) != 0);
+    gst_buffer_unmap (orig[i], &map);
+    gst_buffer_list_add (list, buf);
+  }
+  fail_unless_equals_int (gst_pad_push_list (h_dec->srcpad, list),
+      GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h_dec), 4);
+
+  for (i = 0; i < 4; i++) {
+    GstMapInfo map;
+
+    buf = gst_harness_pull (h_dec);
+    gst_buffer_map (orig[i], &map, GST_MAP_READ);
+    fail_unless_equals_int (gst_buffer_get_size (buf), map.size);
+    fail_unless (gst_buffer_memcmp (buf, 0, map.data, map.size) == 0);
+    gst_buffer_unmap (orig[i], &map);
+    gst_buffer_unref (buf);
+    gst_buffer_unref (orig[i]);
+  }
+
+  gst_harness_teardown (h_enc);
+  gst_harness_teardown (h_dec);
+}
+
+GST_END_TEST;
+
 #ifdef HAVE_SRTP2
 
 GST_START_TEST (test_simple_mki)
@@ -395,6 +513,7 @@ srtp_suite (void)
   tcase_add_test (tc_chain, test_play);
   tcase_add_test (tc_chain, test_roc);
   tcase_add_test (tc_chain, test_play_key_error);
+  tcase_add_test (tc_chain, test_buffer_list);
 #ifdef HAVE_SRTP2
   tcase_add_test (tc_chain, test_simple_mki);
   tcase_add_test (tc_chain, test_srtpdec_multiple_mki);
@@ -25,7 +25,9 @@
 
 #include <gst/gst.h>
 #include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
 #include <gst/app/app.h>
+#include <gst/video/video.h>
 #include <glib/gstdio.h>
 
 static void
@@ -294,6 +296,71 @@ GST_START_TEST (test_unixfd_copy)
 
 GST_END_TEST;
 
+GST_START_TEST (test_unixfd_propose_allocation)
+{
+  GError *error = NULL;
+
+  gchar *tempdir = g_dir_make_tmp ("unixfd-test-XXXXXX", &error);
+  g_assert_no_error (error);
+  gchar *socket_path = g_strdup_printf ("%s/socket", tempdir);
+
+  gchar *pipeline_str = g_strdup_printf ("unixfdsink socket-path=%s",
+      socket_path);
+  GstHarness *h = gst_harness_new_parse (pipeline_str);
+  g_free (pipeline_str);
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=RGBA,width=320,height=240,framerate=30/1");
+
+  /* raw video gets a pool allocating shareable memory */
+  GstCaps *caps = gst_caps_from_string
+      ("video/x-raw,format=RGBA,width=320,height=240,framerate=30/1");
+  GstQuery *query = gst_query_new_allocation (caps, TRUE);
+  gst_caps_unref (caps);
+  fail_unless (gst_pad_peer_query (h->srcpad, query));
+
+  fail_unless_equals_int (gst_query_get_n_allocation_pools (query), 1);
+  GstBufferPool *pool;
+  guint size, min, max;
+  gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+  fail_unless (pool != NULL);
+  fail_unless_equals_int (size, 320 * 240 * 4);
+
+  GstStructure *config = gst_buffer_pool_get_config (pool);
+  fail_unless (gst_buffer_pool_config_has_option (config,
+          GST_BUFFER_POOL_OPTION_VIDEO_SHAREABLE_MEMORY));
+  GstAllocator *allocator;
+  fail_unless (gst_buffer_pool_config_get_allocator (config, &allocator,
+          NULL));
+  fail_unless (allocator != NULL);
+  gst_structure_free (config);
+  gst_object_unref (pool);
+
+  /* the same allocator is proposed for other producers */
+  fail_unless (gst_query_get_n_allocation_params (query) > 0);
+  GstAllocator *param_allocator;
+  gst_query_parse_nth_allocation_param (query, 0, &param_allocator, NULL);
+  fail_unless (param_allocator == allocator);
+  gst_object_unref (param_allocator);
+  gst_query_unref (query);
+
+  /* anything else only gets the allocator */
+  caps = gst_caps_new_empty_simple ("application/x-test");
+  query = gst_query_new_allocation (caps, TRUE);
+  gst_caps_unref (caps);
+  fail_unless (gst_pad_peer_query (h->srcpad, query));
+  fail_unless_equals_int (gst_query_get_n_allocation_pools (query), 0);
+  fail_unless (gst_query_get_n_allocation_params (query) > 0);
+  gst_query_unref (query);
+
+  gst_harness_teardown (h);
+
+  g_rmdir (tempdir);
+  g_free (tempdir);
+  g_free (socket_path);
+}
+
+GST_END_TEST;
+
 static Suite *
 unixfd_suite (void)
 {
@@ -304,6 +371,7 @@ unixfd_suite (void)
   tcase_add_test (tc, test_unixfd_videotestsrc);
   tcase_add_test (tc, test_unixfd_segment);
   tcase_add_test (tc, test_unixfd_copy);
+  tcase_add_test (tc, test_unixfd_propose_allocation);
 
   return s;
 }
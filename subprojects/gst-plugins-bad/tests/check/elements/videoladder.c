@@ -0,0 +1,337 @@
+/* GStreamer
+ *
+ * unit test for videoladder
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/video/video.h>
+
+#define IN_CAPS "video/x-raw,format=I420,width=320,height=240," \
+    "framerate=30/1,pixel-aspect-ratio=1/1"
+
+/* the renditions in the order they are requested, each one with the index
+ * of the rendition it is scaled from with cascade enabled, -1 for the input */
+static const struct
+{
+  gint width, height;
+  gint cascade_from;
+} sizes[] = {
+  {160, 120, 1},
+  {320, 180, -1},
+  {80, 60, 0},
+};
+
+static GstHarness *
+setup_rendition (GstHarness * h, const gchar * padname, gint width,
+    gint height)
+{
+  GstHarness *hs;
+  GstPad *srcpad;
+
+  if (h == NULL)
+    hs = gst_harness_new_with_padnames ("videoladder", "sink", padname);
+  else
+    hs = gst_harness_new_with_element (h->element, NULL, padname);
+
+  srcpad = gst_pad_get_peer (hs->sinkpad);
+  fail_unless (srcpad != NULL);
+  g_object_set (srcpad, "width", width, "height", height, NULL);
+  gst_object_unref (srcpad);
+
+  return hs;
+}
+
+/* a checkerboard with some fine detail on top, scaling it in several steps
+ * gives visibly different results than scaling it at once */
+static GstBuffer *
+create_frame (GstVideoInfo * info, guint n)
+{
+  GstVideoFrame frame;
+  GstBuffer *buf;
+  guint i;
+
+  buf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (info));
+  fail_unless (gst_video_frame_map (&frame, info, buf, GST_MAP_WRITE));
+  for (i = 0; i < GST_VIDEO_FRAME_N_PLANES (&frame); i++) {
+    guint8 *data = GST_VIDEO_FRAME_PLANE_DATA (&frame, i);
+    gint stride = GST_VIDEO_FRAME_PLANE_STRIDE (&frame, i);
+    gint x, y;
+
+    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&frame, i); y++) {
+      for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (&frame, i); x++) {
+        guint8 base = ((x / 4 + y / 4) & 1) ? 200 : 40;
+
+        data[y * stride + x] = base + ((x * 3 + y * 5 + i * 17 + n) & 31);
+      }
+    }
+  }
+  gst_video_frame_unmap (&frame);
+
+  return buf;
+}
+
+/* scales @src like videoladder does with its default settings */
+static GstBuffer *
+scale_frame (GstBuffer * src, GstVideoInfo * src_info,
+    GstVideoInfo * dest_info)
+{
+  GstVideoConverter *convert;
+  GstVideoFrame in_frame, out_frame;
+  GstBuffer *dest;
+
+  convert = gst_video_converter_new (src_info, dest_info,
+      gst_structure_new ("GstVideoConverter",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, GST_VIDEO_RESAMPLER_METHOD_CUBIC,
+          NULL));
+  fail_unless (convert != NULL);
+
+  dest = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (dest_info));
+  fail_unless (gst_video_frame_map (&in_frame, src_info, src, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&out_frame, dest_info, dest,
+          GST_MAP_WRITE));
+  gst_video_converter_frame (convert, &in_frame, &out_frame);
+  gst_video_frame_unmap (&out_frame);
+  gst_video_frame_unmap (&in_frame);
+  gst_video_converter_free (convert);
+
+  return dest;
+}
+
+static gboolean
+frames_equal (GstBuffer * a, GstBuffer * b, GstVideoInfo * info)
+{
+  GstVideoFrame fa, fb;
+  gboolean equal = TRUE;
+  guint i;
+
+  fail_unless (gst_video_frame_map (&fa, info, a, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&fb, info, b, GST_MAP_READ));
+  for (i = 0; i < GST_VIDEO_FRAME_N_PLANES (&fa) && equal; i++) {
+    guint8 *da = GST_VIDEO_FRAME_PLANE_DATA (&fa, i);
+    guint8 *db = GST_VIDEO_FRAME_PLANE_DATA (&fb, i);
+    gint sa = GST_VIDEO_FRAME_PLANE_STRIDE (&fa, i);
+    gint sb = GST_VIDEO_FRAME_PLANE_STRIDE (&fb, i);
+    gint row;
+
+    for (row = 0; row < GST_VIDEO_FRAME_COMP_HEIGHT (&fa, i) && equal; row++)
+      equal = memcmp (da + row * sa, db + row * sb,
+          GST_VIDEO_FRAME_COMP_WIDTH (&fa, i)) == 0;
+  }
+  gst_video_frame_unmap (&fb);
+  gst_video_frame_unmap (&fa);
+
+  return equal;
+}
+
+/* checks the negotiated caps of a rendition and returns its info */
+static void
+check_rendition_caps (GstHarness * h, gint width, gint height,
+    GstVideoInfo * info)
+{
+  GstCaps *caps;
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_video_info_from_caps (info, caps));
+  gst_caps_unref (caps);
+
+  fail_unless_equals_int (GST_VIDEO_INFO_FORMAT (info), GST_VIDEO_FORMAT_I420);
+  fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (info), width);
+  fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (info), height);
+  /* the display aspect ratio of the 4:3 input is kept */
+  fail_unless_equals_int (GST_VIDEO_INFO_PAR_N (info) * width * 3,
+      GST_VIDEO_INFO_PAR_D (info) * height * 4);
+}
+
+static GstBuffer *
+pull_rendition (GstHarness * h, GstClockTime pts)
+{
+  GstBuffer *buf;
+
+  buf = gst_harness_pull (h);
+  fail_unless (buf != NULL);
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (buf), pts);
+  fail_unless_equals_uint64 (GST_BUFFER_DURATION (buf), GST_SECOND / 30);
+
+  return buf;
+}
+
+static void
+run_ladder (gboolean cascade)
+{
+  GstHarness *h[G_N_ELEMENTS (sizes)];
+  GstVideoInfo info, out_info[G_N_ELEMENTS (sizes)];
+  GstBuffer *direct[G_N_ELEMENTS (sizes)], *cascaded[G_N_ELEMENTS (sizes)];
+  GstCaps *caps;
+  GstBuffer *buf;
+  guint i, n, done;
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    gchar *padname = g_strdup_printf ("src_%u", i);
+
+    h[i] = setup_rendition (i == 0 ? NULL : h[0], padname, sizes[i].width,
+        sizes[i].height);
+    g_free (padname);
+  }
+  g_object_set (h[0]->element, "cascade", cascade, NULL);
+
+  caps = gst_caps_from_string (IN_CAPS);
+  fail_unless (gst_video_info_from_caps (&info, caps));
+  gst_harness_set_src_caps (h[0], caps);
+
+  for (n = 0; n < 2; n++) {
+    GstClockTime pts = n * GST_SECOND / 30;
+
+    buf = create_frame (&info, n);
+    GST_BUFFER_PTS (buf) = pts;
+    GST_BUFFER_DURATION (buf) = GST_SECOND / 30;
+
+    fail_unless_equals_int (gst_harness_push (h[0], gst_buffer_ref (buf)),
+        GST_FLOW_OK);
+
+    for (i = 0; i < G_N_ELEMENTS (sizes); i++)
+      check_rendition_caps (h[i], sizes[i].width, sizes[i].height,
+          &out_info[i]);
+
+    /* the references for scaling every rendition from the input and from
+     * the rendition it is cascaded from, the larger ones first */
+    for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+      direct[i] = scale_frame (buf, &info, &out_info[i]);
+      cascaded[i] = NULL;
+    }
+    for (done = 0; done < G_N_ELEMENTS (sizes);) {
+      for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+        gint from = sizes[i].cascade_from;
+
+        if (cascaded[i] != NULL)
+          continue;
+        if (from < 0)
+          cascaded[i] = gst_buffer_ref (direct[i]);
+        else if (cascaded[from] != NULL)
+          cascaded[i] = scale_frame (cascaded[from], &out_info[from],
+              &out_info[i]);
+        else
+          continue;
+        done++;
+      }
+    }
+
+    for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+      GstBuffer *out = pull_rendition (h[i], pts);
+      GstBuffer *expected = cascade ? cascaded[i] : direct[i];
+      GstBuffer *other = cascade ? direct[i] : cascaded[i];
+
+      fail_unless (frames_equal (out, expected, &out_info[i]),
+          "rendition %dx%d wasn't scaled from the expected level",
+          sizes[i].width, sizes[i].height);
+      /* the pattern tells the levels apart */
+      if (sizes[i].cascade_from >= 0)
+        fail_if (frames_equal (out, other, &out_info[i]));
+
+      gst_buffer_unref (out);
+      gst_buffer_unref (direct[i]);
+      gst_buffer_unref (cascaded[i]);
+    }
+    gst_buffer_unref (buf);
+  }
+
+  for (i = G_N_ELEMENTS (sizes); i > 0; i--)
+    gst_harness_teardown (h[i - 1]);
+}
+
+GST_START_TEST (test_videoladder_cascade)
+{
+  run_ladder (TRUE);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_videoladder_direct)
+{
+  run_ladder (FALSE);
+}
+
+GST_END_TEST;
+
+static void
+push_and_check_resized (GstHarness * h, GstVideoInfo * info, guint n,
+    gint width, gint height)
+{
+  GstVideoInfo out_info;
+  GstBuffer *buf, *out, *expected;
+
+  buf = create_frame (info, n);
+  GST_BUFFER_PTS (buf) = n * GST_SECOND / 30;
+  GST_BUFFER_DURATION (buf) = GST_SECOND / 30;
+  fail_unless_equals_int (gst_harness_push (h, gst_buffer_ref (buf)),
+      GST_FLOW_OK);
+
+  check_rendition_caps (h, width, height, &out_info);
+  expected = scale_frame (buf, info, &out_info);
+  out = pull_rendition (h, n * GST_SECOND / 30);
+  fail_unless (frames_equal (out, expected, &out_info));
+
+  gst_buffer_unref (out);
+  gst_buffer_unref (expected);
+  gst_buffer_unref (buf);
+}
+
+GST_START_TEST (test_videoladder_resize)
+{
+  GstHarness *h;
+  GstVideoInfo info;
+  GstCaps *caps;
+  GstPad *srcpad;
+
+  h = setup_rendition (NULL, "src_0", 160, 120);
+
+  caps = gst_caps_from_string (IN_CAPS);
+  fail_unless (gst_video_info_from_caps (&info, caps));
+  gst_harness_set_src_caps (h, caps);
+
+  push_and_check_resized (h, &info, 0, 160, 120);
+
+  /* changing the size while running renegotiates */
+  srcpad = gst_pad_get_peer (h->sinkpad);
+  g_object_set (srcpad, "width", 64, "height", 48, NULL);
+  gst_object_unref (srcpad);
+
+  push_and_check_resized (h, &info, 1, 64, 48);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+videoladder_suite (void)
+{
+  Suite *s = suite_create ("videoladder");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_videoladder_cascade);
+  tcase_add_test (tc_chain, test_videoladder_direct);
+  tcase_add_test (tc_chain, test_videoladder_resize);
+
+  return s;
+}
+
+GST_CHECK_MAIN (videoladder);
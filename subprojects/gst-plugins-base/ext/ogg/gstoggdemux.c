@@ -61,6 +61,11 @@
 
 #define SEEK_GIVE_UP_THRESHOLD (3*GST_SECOND)
 
+/* Upper bound for the entries in the page index of a stream. The minimum
+ * distance between entries grows with the size of the chain to stay below
+ * this. */
+#define MAX_PAGE_INDEX_ENTRIES 8192
+
 #define GST_CHAIN_LOCK(ogg)     g_mutex_lock(&(ogg)->chain_lock)
 #define GST_CHAIN_UNLOCK(ogg)   g_mutex_unlock(&(ogg)->chain_lock)
 
@@ -194,6 +199,8 @@ gst_ogg_pad_init (GstOggPad * pad)
   pad->map.granulerate_n = 0;
   pad->map.granulerate_d = 0;
   pad->map.granuleshift = -1;
+
+  pad->page_index = g_array_new (FALSE, FALSE, sizeof (GstOggPageIndexEntry));
 }
 
 static void
@@ -240,6 +247,7 @@ gst_ogg_pad_finalize (GObject * object)
   GstOggPad *pad = GST_OGG_PAD (object);
 
   ogg_stream_clear (&pad->map.stream);
+  g_array_free (pad->page_index, TRUE);
 
   G_OBJECT_CLASS (gst_ogg_pad_parent_class)->finalize (object);
 }
@@ -2170,6 +2178,128 @@ gst_ogg_chain_free (GstOggChain * chain)
   g_free (chain);
 }
 
+/* returns the position of the first index entry at or after @offset */
+static guint
+gst_ogg_pad_page_index_find (GstOggPad * pad, gint64 offset)
+{
+  guint lo = 0, hi = pad->page_index->len;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (g_array_index (pad->page_index, GstOggPageIndexEntry,
+            mid).offset < offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/* remember that the page of @pad at @offset ends at stream time @time */
+static void
+gst_ogg_pad_page_index_add (GstOggPad * pad, gint64 offset, GstClockTime time)
+{
+  GstOggChain *chain = pad->chain;
+  GArray *index = pad->page_index;
+  GstOggPageIndexEntry entry;
+  gint64 spacing;
+  guint pos;
+
+  if (!GST_CLOCK_TIME_IS_VALID (time) || chain == NULL || chain->offset < 0
+      || offset < chain->offset || offset >= chain->end_offset)
+    return;
+
+  /* seeking reads at least a chunk anyway, no need for a finer index */
+  spacing = MAX (chain->ogg->chunk_size,
+      (chain->end_offset - chain->offset) / MAX_PAGE_INDEX_ENTRIES);
+
+  pos = gst_ogg_pad_page_index_find (pad, offset);
+  if (pos > 0 && offset - g_array_index (index, GstOggPageIndexEntry,
+          pos - 1).offset < spacing)
+    return;
+  if (pos < index->len && g_array_index (index, GstOggPageIndexEntry,
+          pos).offset - offset < spacing)
+    return;
+
+  entry.offset = offset;
+  entry.time = time;
+  g_array_insert_val (index, pos, entry);
+
+  GST_LOG_OBJECT (pad, "indexed page at %" G_GINT64_FORMAT
+      " with time %" GST_TIME_FORMAT ", %u entries", offset,
+      GST_TIME_ARGS (time), index->len);
+}
+
+/* Narrows down the range to search for @target in with the page indexes of
+ * the streams. The times of the pages of one stream grow with their offset,
+ * but the pages of different streams are not ordered by time against each
+ * other, so the range has to contain the target of every stream. When
+ * @only_serial_no is set, only the stream with @serialno is considered. */
+static void
+gst_ogg_chain_page_index_narrow (GstOggChain * chain, gint64 target,
+    gboolean only_serial_no, gint serialno, gint64 * begin,
+    gint64 * begintime, gint64 * end, gint64 * endtime)
+{
+  GstOggPageIndexEntry *first = NULL, *last = NULL;
+  gboolean have_first = TRUE, have_last = TRUE;
+  gint i;
+
+  for (i = 0; i < chain->streams->len; i++) {
+    GstOggPad *pad = g_array_index (chain->streams, GstOggPad *, i);
+    GArray *index;
+    guint lo, hi;
+
+    if (pad == NULL || pad->map.is_skeleton || pad->map.is_sparse)
+      continue;
+    if (only_serial_no && pad->map.serialno != (guint32) serialno)
+      continue;
+
+    /* first entry at or after the target */
+    index = pad->page_index;
+    lo = 0;
+    hi = index->len;
+    while (lo < hi) {
+      guint mid = lo + (hi - lo) / 2;
+
+      if (g_array_index (index, GstOggPageIndexEntry, mid).time < target)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    /* a stream without pages on one side leaves that side open */
+    if (lo == 0) {
+      have_first = FALSE;
+    } else {
+      GstOggPageIndexEntry *entry =
+          &g_array_index (index, GstOggPageIndexEntry, lo - 1);
+
+      if (first == NULL || entry->offset < first->offset)
+        first = entry;
+    }
+    if (lo == index->len) {
+      have_last = FALSE;
+    } else {
+      GstOggPageIndexEntry *entry =
+          &g_array_index (index, GstOggPageIndexEntry, lo);
+
+      if (last == NULL || entry->offset > last->offset)
+        last = entry;
+    }
+  }
+
+  if (have_first && first && first->offset > *begin && first->offset < *end) {
+    *begin = first->offset;
+    *begintime = first->time;
+  }
+  if (have_last && last && last->offset > *begin && last->offset < *end) {
+    *end = last->offset;
+    *endtime = last->time;
+  }
+}
+
 static void
 gst_ogg_pad_mark_discont (GstOggPad * pad)
 {
@@ -3136,6 +3266,10 @@ do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
   GstFlowReturn ret;
   gint64 result = 0;
 
+  /* narrow down the range with the pages we have seen before */
+  gst_ogg_chain_page_index_narrow (chain, target, only_serial_no, serialno,
+      &begin, &begintime, &end, &endtime);
+
   best = begin;
 
   GST_DEBUG_OBJECT (ogg,
@@ -3227,6 +3361,9 @@ do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
         granuletime -= pad->start_time;
         granuletime += chain->begin_time;
 
+        if (!pad->map.is_sparse)
+          gst_ogg_pad_page_index_add (pad, result, granuletime);
+
         GST_DEBUG_OBJECT (ogg,
             "found page with granule %" G_GINT64_FORMAT " and time %"
             GST_TIME_FORMAT, granulepos, GST_TIME_ARGS (granuletime));
@@ -4703,6 +4840,39 @@ unknown_chain:
   }
 }
 
+/* in pull mode, remember where the pages we play back are so that later
+ * seeks need fewer reads */
+static void
+gst_ogg_demux_index_page (GstOggDemux * ogg, ogg_page * page)
+{
+  GstOggChain *chain = ogg->current_chain;
+  GstOggPad *pad;
+  gint64 granulepos, offset;
+  GstClockTime time;
+
+  granulepos = ogg_page_granulepos (page);
+  if (granulepos == -1)
+    return;
+
+  pad = gst_ogg_chain_get_stream (chain, ogg_page_serialno (page));
+  if (pad == NULL || pad->map.is_skeleton || pad->map.is_sparse
+      || !GST_CLOCK_TIME_IS_VALID (pad->start_time)
+      || !GST_CLOCK_TIME_IS_VALID (chain->begin_time))
+    return;
+
+  time = gst_ogg_stream_get_end_time_for_granulepos (&pad->map, granulepos);
+  if (!GST_CLOCK_TIME_IS_VALID (time) || time < pad->start_time)
+    return;
+  time = time - pad->start_time + chain->begin_time;
+
+  /* everything up to ogg->offset was submitted, the sync layer still holds
+   * the data following this page */
+  offset = ogg->offset - (ogg->sync.fill - ogg->sync.returned)
+      - page->header_len - page->body_len;
+
+  gst_ogg_pad_page_index_add (pad, offset, time);
+}
+
 /* streaming mode, receive a buffer, parse it, create pads for
  * the serialno, submit pages and packets to the oggpads
  */
@@ -4742,6 +4912,8 @@ gst_ogg_demux_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
       /* discontinuity in the pages */
       GST_DEBUG_OBJECT (ogg, "discont in page found, continuing");
     } else {
+      if (ogg->pullmode && ogg->current_chain)
+        gst_ogg_demux_index_page (ogg, &page);
       result = gst_ogg_demux_handle_page (ogg, &page, FALSE);
       if (result < 0) {
         GST_DEBUG_OBJECT (ogg, "gst_ogg_demux_handle_page returned %d", result);
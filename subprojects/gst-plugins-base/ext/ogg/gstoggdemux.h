@@ -52,6 +52,14 @@ typedef struct _GstOggDemux GstOggDemux;
 typedef struct _GstOggDemuxClass GstOggDemuxClass;
 typedef struct _GstOggChain GstOggChain;
 
+/* a page of a stream we have seen while reading, and the stream time it
+ * ends at */
+typedef struct
+{
+  gint64 offset;
+  GstClockTime time;
+} GstOggPageIndexEntry;
+
 /* all information needed for one ogg chain (relevant for chained bitstreams) */
 struct _GstOggChain
 {
@@ -113,6 +121,11 @@ struct _GstOggPad
   /* push mode seeking */
   GstClockTime push_kf_time;
   GstClockTime push_sync_time;
+
+  /* pull mode seeking */
+  GArray *page_index;           /* GstOggPageIndexEntry, sorted by offset. Pages of
+                                   this stream seen while reading, to narrow down
+                                   seeks */
 };
 
 struct _GstOggPadClass
@@ -201,6 +201,9 @@ static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
 #define DEFAULT_DTX             FALSE
 #define DEFAULT_PACKET_LOSS_PERCENT 0
 #define DEFAULT_MAX_PAYLOAD_SIZE 4000
+#define DEFAULT_MAX_THREADS     1
+
+#define HIGHEST_MAX_PAYLOAD_SIZE 4000
 
 enum
 {
@@ -214,7 +217,8 @@ enum
   PROP_INBAND_FEC,
   PROP_DTX,
   PROP_PACKET_LOSS_PERCENT,
-  PROP_MAX_PAYLOAD_SIZE
+  PROP_MAX_PAYLOAD_SIZE,
+  PROP_MAX_THREADS
 };
 
 static void gst_opus_enc_finalize (GObject * object);
@@ -341,11 +345,31 @@ gst_opus_enc_class_init (GstOpusEncClass * klass)
           GST_PARAM_MUTABLE_PLAYING));
   g_object_class_install_property (G_OBJECT_CLASS (klass),
       PROP_MAX_PAYLOAD_SIZE, g_param_spec_uint ("max-payload-size",
-          "Max payload size", "Maximum payload size in bytes", 2, 4000,
-          DEFAULT_MAX_PAYLOAD_SIZE,
+          "Max payload size", "Maximum payload size in bytes", 2,
+          HIGHEST_MAX_PAYLOAD_SIZE, DEFAULT_MAX_PAYLOAD_SIZE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_PLAYING));
 
+  /**
+   * GstOpusEnc:max-threads:
+   *
+   * Maximum number of threads to encode multichannel audio with. With more
+   * than one thread, every stream of the multistream layout gets its own
+   * encoder and the streams of each frame are encoded in parallel. Frames
+   * are still output as soon as they are encoded, so this adds no latency.
+   * 0 uses as many threads as there are processors.
+   *
+   * Takes effect when the input format is next configured.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (G_OBJECT_CLASS (klass),
+      PROP_MAX_THREADS, g_param_spec_uint ("max-threads",
+          "Maximum threads", "Maximum number of threads to encode the "
+          "streams of multichannel audio with (0 = one per processor)",
+          0, G_MAXINT, DEFAULT_MAX_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gobject_class->finalize = GST_DEBUG_FUNCPTR (gst_opus_enc_finalize);
 
   GST_DEBUG_CATEGORY_INIT (opusenc_debug, "opusenc", 0, "Opus encoder");
@@ -392,6 +416,35 @@ gst_opus_enc_init (GstOpusEnc * enc)
   enc->packet_loss_percentage = DEFAULT_PACKET_LOSS_PERCENT;
   enc->max_payload_size = DEFAULT_MAX_PAYLOAD_SIZE;
   enc->audio_type = DEFAULT_AUDIO_TYPE;
+  enc->max_threads = DEFAULT_MAX_THREADS;
+}
+
+static void
+gst_opus_enc_free_encoders (GstOpusEnc * enc)
+{
+  guint i;
+
+  if (enc->state) {
+    opus_multistream_encoder_destroy (enc->state);
+    enc->state = NULL;
+  }
+
+  if (enc->task_pool) {
+    gst_task_pool_cleanup (enc->task_pool);
+    gst_clear_object (&enc->task_pool);
+  }
+  for (i = 0; i < enc->n_streams; i++) {
+    GstOpusEncStream *stream = &enc->streams[i];
+
+    if (stream->state)
+      opus_encoder_destroy (stream->state);
+    g_free (stream->pcm);
+    g_free (stream->packet);
+  }
+  g_clear_pointer (&enc->streams, g_free);
+  enc->n_streams = 0;
+  g_clear_pointer (&enc->jobs, g_free);
+  enc->n_jobs = 0;
 }
 
 static gboolean
@@ -412,10 +465,7 @@ gst_opus_enc_stop (GstAudioEncoder * benc)
   GstOpusEnc *enc = GST_OPUS_ENC (benc);
 
   GST_DEBUG_OBJECT (enc, "stop");
-  if (enc->state) {
-    opus_multistream_encoder_destroy (enc->state);
-    enc->state = NULL;
-  }
+  gst_opus_enc_free_encoders (enc);
   gst_tag_setter_reset_tags (GST_TAG_SETTER (enc));
 
   return TRUE;
@@ -721,10 +771,7 @@ gst_opus_enc_set_format (GstAudioEncoder * benc, GstAudioInfo * info)
       enc->sample_rate);
 
   /* handle reconfigure */
-  if (enc->state) {
-    opus_multistream_encoder_destroy (enc->state);
-    enc->state = NULL;
-  }
+  gst_opus_enc_free_encoders (enc);
   if (!gst_opus_enc_setup (enc)) {
     g_mutex_unlock (&enc->property_lock);
     return FALSE;
@@ -743,6 +790,117 @@ gst_opus_enc_set_format (GstAudioEncoder * benc, GstAudioInfo * info)
   return TRUE;
 }
 
+/* Gives every stream of the multistream layout its own encoder, fed from
+ * the input channels the encoding mapping assigns to it. Coupled streams
+ * come first and take two coded channels each. */
+static gboolean
+gst_opus_enc_setup_streams (GstOpusEnc * enc, guint n_threads)
+{
+  guint n_coupled = enc->n_stereo_streams;
+  gint max_frame_samples = 3 * enc->sample_rate / 50;
+  guint i;
+
+  enc->n_streams = enc->n_channels - n_coupled;
+  enc->streams = g_new0 (GstOpusEncStream, enc->n_streams);
+  for (i = 0; i < enc->n_streams; i++) {
+    GstOpusEncStream *stream = &enc->streams[i];
+    int error = OPUS_OK;
+
+    stream->channels = i < n_coupled ? 2 : 1;
+    stream->in_channels[0] = stream->in_channels[1] = -1;
+    stream->state = opus_encoder_create (enc->sample_rate, stream->channels,
+        enc->audio_type, &error);
+    if (!stream->state || error != OPUS_OK)
+      return FALSE;
+    stream->pcm = g_new (gint16, max_frame_samples * stream->channels);
+    stream->packet = g_malloc (HIGHEST_MAX_PAYLOAD_SIZE * stream->channels);
+  }
+
+  for (i = 0; i < enc->n_channels; i++) {
+    guint coded = enc->encoding_channel_mapping[i];
+
+    if (coded < 2 * n_coupled)
+      enc->streams[coded / 2].in_channels[coded % 2] = i;
+    else if (coded != 255 && coded - n_coupled < enc->n_streams)
+      enc->streams[coded - n_coupled].in_channels[0] = i;
+  }
+
+  enc->n_jobs = n_threads;
+  enc->jobs = g_new0 (GstOpusEncJob, n_threads);
+  for (i = 0; i < n_threads; i++) {
+    enc->jobs[i].enc = enc;
+    enc->jobs[i].index = i;
+  }
+
+  /* the streaming thread runs one of the jobs itself */
+  enc->task_pool = gst_shared_task_pool_new ();
+  gst_shared_task_pool_set_max_threads (GST_SHARED_TASK_POOL (enc->task_pool),
+      n_threads - 1);
+  gst_task_pool_prepare (enc->task_pool, NULL);
+
+  return TRUE;
+}
+
+/* Splits the bitrate between the streams like the multistream encoder
+ * does: each stream gets a base rate and the rest is shared per channel */
+static gint
+gst_opus_enc_get_stream_bitrate (GstOpusEnc * enc, guint stream)
+{
+  gint n_streams = enc->n_streams;
+  gint n_coded_channels = n_streams + enc->n_stereo_streams;
+  gint stream_offset, channel_rate;
+
+  stream_offset = CLAMP (enc->bitrate / n_streams / 2, 0, 20000);
+  channel_rate = (enc->bitrate - stream_offset * n_streams) / n_coded_channels;
+
+  return MAX (stream_offset + channel_rate * enc->streams[stream].channels,
+      500);
+}
+
+/* call with the property lock */
+static void
+gst_opus_enc_apply_settings (GstOpusEnc * enc)
+{
+  guint i;
+
+  if (enc->state) {
+    opus_multistream_encoder_ctl (enc->state, OPUS_SET_BITRATE (enc->bitrate),
+        0);
+    opus_multistream_encoder_ctl (enc->state,
+        OPUS_SET_BANDWIDTH (enc->bandwidth), 0);
+    opus_multistream_encoder_ctl (enc->state,
+        OPUS_SET_VBR (enc->bitrate_type != BITRATE_TYPE_CBR), 0);
+    opus_multistream_encoder_ctl (enc->state,
+        OPUS_SET_VBR_CONSTRAINT (enc->bitrate_type ==
+            BITRATE_TYPE_CONSTRAINED_VBR), 0);
+    opus_multistream_encoder_ctl (enc->state,
+        OPUS_SET_COMPLEXITY (enc->complexity), 0);
+    opus_multistream_encoder_ctl (enc->state,
+        OPUS_SET_INBAND_FEC (enc->inband_fec), 0);
+    opus_multistream_encoder_ctl (enc->state, OPUS_SET_DTX (enc->dtx), 0);
+    opus_multistream_encoder_ctl (enc->state,
+        OPUS_SET_PACKET_LOSS_PERC (enc->packet_loss_percentage), 0);
+  }
+
+  for (i = 0; i < enc->n_streams; i++) {
+    OpusEncoder *state = enc->streams[i].state;
+
+    opus_encoder_ctl (state,
+        OPUS_SET_BITRATE (gst_opus_enc_get_stream_bitrate (enc, i)));
+    opus_encoder_ctl (state, OPUS_SET_BANDWIDTH (enc->bandwidth));
+    opus_encoder_ctl (state,
+        OPUS_SET_VBR (enc->bitrate_type != BITRATE_TYPE_CBR));
+    opus_encoder_ctl (state,
+        OPUS_SET_VBR_CONSTRAINT (enc->bitrate_type ==
+            BITRATE_TYPE_CONSTRAINED_VBR));
+    opus_encoder_ctl (state, OPUS_SET_COMPLEXITY (enc->complexity));
+    opus_encoder_ctl (state, OPUS_SET_INBAND_FEC (enc->inband_fec));
+    opus_encoder_ctl (state, OPUS_SET_DTX (enc->dtx));
+    opus_encoder_ctl (state,
+        OPUS_SET_PACKET_LOSS_PERC (enc->packet_loss_percentage));
+  }
+}
+
 static gboolean
 gst_opus_enc_setup (GstOpusEnc * enc)
 {
@@ -750,6 +908,7 @@ gst_opus_enc_setup (GstOpusEnc * enc)
   GstCaps *caps;
   gboolean ret;
   gint32 lookahead;
+  guint n_streams, n_threads;
   const GstTagList *tags;
   GstTagList *empty_tags = NULL;
   GstBuffer *header, *comments;
@@ -767,30 +926,30 @@ gst_opus_enc_setup (GstOpusEnc * enc)
       "Decoding mapping table", enc->n_channels, enc->decoding_channel_mapping);
 #endif
 
-  enc->state = opus_multistream_encoder_create (enc->sample_rate,
-      enc->n_channels, enc->n_channels - enc->n_stereo_streams,
-      enc->n_stereo_streams, enc->encoding_channel_mapping,
-      enc->audio_type, &error);
-  if (!enc->state || error != OPUS_OK)
-    goto encoder_creation_failed;
-
-  opus_multistream_encoder_ctl (enc->state, OPUS_SET_BITRATE (enc->bitrate), 0);
-  opus_multistream_encoder_ctl (enc->state, OPUS_SET_BANDWIDTH (enc->bandwidth),
-      0);
-  opus_multistream_encoder_ctl (enc->state,
-      OPUS_SET_VBR (enc->bitrate_type != BITRATE_TYPE_CBR), 0);
-  opus_multistream_encoder_ctl (enc->state,
-      OPUS_SET_VBR_CONSTRAINT (enc->bitrate_type ==
-          BITRATE_TYPE_CONSTRAINED_VBR), 0);
-  opus_multistream_encoder_ctl (enc->state,
-      OPUS_SET_COMPLEXITY (enc->complexity), 0);
-  opus_multistream_encoder_ctl (enc->state,
-      OPUS_SET_INBAND_FEC (enc->inband_fec), 0);
-  opus_multistream_encoder_ctl (enc->state, OPUS_SET_DTX (enc->dtx), 0);
-  opus_multistream_encoder_ctl (enc->state,
-      OPUS_SET_PACKET_LOSS_PERC (enc->packet_loss_percentage), 0);
-
-  opus_multistream_encoder_ctl (enc->state, OPUS_GET_LOOKAHEAD (&lookahead), 0);
+  n_streams = enc->n_channels - enc->n_stereo_streams;
+  n_threads = enc->max_threads ? enc->max_threads : g_get_num_processors ();
+  n_threads = MIN (n_threads, n_streams);
+
+  if (n_threads > 1) {
+    GST_DEBUG_OBJECT (enc, "encoding %u streams with %u threads", n_streams,
+        n_threads);
+    if (!gst_opus_enc_setup_streams (enc, n_threads))
+      goto encoder_creation_failed;
+  } else {
+    enc->state = opus_multistream_encoder_create (enc->sample_rate,
+        enc->n_channels, n_streams, enc->n_stereo_streams,
+        enc->encoding_channel_mapping, enc->audio_type, &error);
+    if (!enc->state || error != OPUS_OK)
+      goto encoder_creation_failed;
+  }
+
+  gst_opus_enc_apply_settings (enc);
+
+  if (enc->state)
+    opus_multistream_encoder_ctl (enc->state, OPUS_GET_LOOKAHEAD (&lookahead),
+        0);
+  else
+    opus_encoder_ctl (enc->streams[0].state, OPUS_GET_LOOKAHEAD (&lookahead));
 
   GST_LOG_OBJECT (enc, "we have frame size %d, lookahead %d", enc->frame_size,
       lookahead);
@@ -825,6 +984,7 @@ gst_opus_enc_setup (GstOpusEnc * enc)
 
 encoder_creation_failed:
   GST_ERROR_OBJECT (enc, "Encoder creation failed");
+  gst_opus_enc_free_encoders (enc);
   return FALSE;
 }
 
@@ -964,6 +1124,174 @@ gst_opus_enc_sink_getcaps (GstAudioEncoder * benc, GstCaps * filter)
   return caps;
 }
 
+/* frame length coding of RFC 6716 section 3.2.1 */
+static gint
+gst_opus_enc_write_frame_length (gint length, guint8 * data)
+{
+  if (length < 252) {
+    data[0] = length;
+    return 1;
+  }
+
+  data[0] = 252 + (length & 0x3);
+  data[1] = (length - data[0]) >> 2;
+  return 2;
+}
+
+static gint
+gst_opus_enc_frame_length_size (gint length)
+{
+  return length < 252 ? 1 : 2;
+}
+
+/* Rewrites the Opus packet @packet into @out, in the self-delimiting
+ * framing of RFC 6716 appendix B if @self_delimited. Returns the size or
+ * an Opus error code. */
+static gint
+gst_opus_enc_write_packet (const guint8 * packet, gint len,
+    gboolean self_delimited, guint8 * out, gint max_size)
+{
+  const guint8 *frames[48];
+  opus_int16 sizes[48];
+  guint8 toc, *p = out;
+  gint n_frames, i, frames_size = 0, size;
+  gboolean vbr = FALSE, code3;
+
+  n_frames = opus_packet_parse (packet, len, &toc, frames, sizes, NULL);
+  if (n_frames <= 0)
+    return n_frames < 0 ? n_frames : OPUS_INVALID_PACKET;
+
+  for (i = 0; i < n_frames; i++) {
+    frames_size += sizes[i];
+    if (sizes[i] != sizes[0])
+      vbr = TRUE;
+  }
+
+  /* with codes 0 to 2 */
+  size = 1 + frames_size;
+  if (n_frames == 2 && vbr)
+    size += gst_opus_enc_frame_length_size (sizes[0]);
+  if (self_delimited)
+    size += gst_opus_enc_frame_length_size (sizes[n_frames - 1]);
+
+  code3 = n_frames > 2;
+  if (code3) {
+    size = 2 + frames_size;
+    if (vbr) {
+      for (i = 0; i < n_frames - 1; i++)
+        size += gst_opus_enc_frame_length_size (sizes[i]);
+    }
+    if (self_delimited)
+      size += gst_opus_enc_frame_length_size (sizes[n_frames - 1]);
+  }
+
+  if (size > max_size)
+    return OPUS_BUFFER_TOO_SMALL;
+
+  toc &= 0xfc;
+  if (!code3) {
+    if (n_frames == 1) {
+      *p++ = toc;
+    } else if (!vbr) {
+      *p++ = toc | 0x1;
+    } else {
+      *p++ = toc | 0x2;
+      p += gst_opus_enc_write_frame_length (sizes[0], p);
+    }
+  } else {
+    *p++ = toc | 0x3;
+    *p++ = n_frames | (vbr ? 0x80 : 0);
+    if (vbr) {
+      for (i = 0; i < n_frames - 1; i++)
+        p += gst_opus_enc_write_frame_length (sizes[i], p);
+    }
+  }
+  if (self_delimited)
+    p += gst_opus_enc_write_frame_length (sizes[n_frames - 1], p);
+
+  for (i = 0; i < n_frames; i++) {
+    memcpy (p, frames[i], sizes[i]);
+    p += sizes[i];
+  }
+
+  return p - out;
+}
+
+static void
+gst_opus_enc_encode_job (gpointer user_data)
+{
+  GstOpusEncJob *job = user_data;
+  GstOpusEnc *enc = job->enc;
+  gint frame_samples = enc->jobs_frame_samples;
+  guint i;
+
+  for (i = job->index; i < enc->n_streams; i += enc->n_jobs) {
+    GstOpusEncStream *stream = &enc->streams[i];
+    gint n, c;
+
+    for (n = 0; n < frame_samples; n++) {
+      for (c = 0; c < stream->channels; c++) {
+        gint in = stream->in_channels[c];
+
+        stream->pcm[n * stream->channels + c] =
+            in >= 0 ? enc->jobs_pcm[n * enc->n_channels + in] : 0;
+      }
+    }
+
+    stream->packet_size = opus_encode (stream->state, stream->pcm,
+        frame_samples, stream->packet, enc->jobs_max_bytes * stream->channels);
+  }
+}
+
+/* Encodes the streams of one frame in parallel and puts the packets
+ * together into a multistream packet, like opus_multistream_encode().
+ * All but the last stream use the self-delimiting framing. With CBR every
+ * stream encoder outputs packets of a constant size, so the size of the
+ * frame is constant too. The frame is complete when this returns, so no
+ * latency is added. */
+static gint
+gst_opus_enc_encode_streams (GstOpusEnc * enc, const gint16 * pcm,
+    gint frame_samples, guint max_payload_size, guint8 * out, gint max_size)
+{
+  gint size = 0;
+  guint i;
+
+  enc->jobs_pcm = pcm;
+  enc->jobs_frame_samples = frame_samples;
+  enc->jobs_max_bytes = max_payload_size;
+
+  for (i = 1; i < enc->n_jobs; i++)
+    enc->jobs[i].id = gst_task_pool_push (enc->task_pool,
+        gst_opus_enc_encode_job, &enc->jobs[i], NULL);
+
+  gst_opus_enc_encode_job (&enc->jobs[0]);
+
+  for (i = 1; i < enc->n_jobs; i++) {
+    if (enc->jobs[i].id)
+      gst_task_pool_join (enc->task_pool, enc->jobs[i].id);
+    else
+      gst_opus_enc_encode_job (&enc->jobs[i]);
+    enc->jobs[i].id = NULL;
+  }
+
+  for (i = 0; i < enc->n_streams; i++) {
+    GstOpusEncStream *stream = &enc->streams[i];
+    gboolean last = (i == enc->n_streams - 1);
+    gint ret;
+
+    if (stream->packet_size < 0)
+      return stream->packet_size;
+
+    ret = gst_opus_enc_write_packet (stream->packet, stream->packet_size,
+        !last, out + size, max_size - size);
+    if (ret < 0)
+      return ret;
+    size += ret;
+  }
+
+  return size;
+}
+
 static GstFlowReturn
 gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
 {
@@ -977,7 +1305,7 @@ gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
   GstBuffer *outbuf;
   guint64 trim_start = 0, trim_end = 0;
 
-  guint max_payload_size;
+  guint max_payload_size, max_size;
   gint frame_samples, input_samples, output_samples;
 
   g_mutex_lock (&enc->property_lock);
@@ -1070,9 +1398,12 @@ gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
 
   g_assert (size == bytes);
 
+  /* the self-delimiting framing of parallel encoded streams needs up to
+   * three more bytes per stream */
+  max_size = max_payload_size * enc->n_channels + 3 * enc->n_streams;
   outbuf =
       gst_audio_encoder_allocate_output_buffer (GST_AUDIO_ENCODER (enc),
-      max_payload_size * enc->n_channels);
+      max_size);
   if (!outbuf)
     goto done;
 
@@ -1089,9 +1420,14 @@ gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
 
   gst_buffer_map (outbuf, &omap, GST_MAP_WRITE);
 
-  outsize =
-      opus_multistream_encode (enc->state, (const gint16 *) data,
-      frame_samples, omap.data, max_payload_size * enc->n_channels);
+  if (enc->streams)
+    outsize =
+        gst_opus_enc_encode_streams (enc, (const gint16 *) data,
+        frame_samples, max_payload_size, omap.data, max_size);
+  else
+    outsize =
+        opus_multistream_encode (enc->state, (const gint16 *) data,
+        frame_samples, omap.data, max_payload_size * enc->n_channels);
 
   gst_buffer_unmap (outbuf, &omap);
 
@@ -1185,6 +1521,9 @@ gst_opus_enc_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_MAX_PAYLOAD_SIZE:
       g_value_set_uint (value, enc->max_payload_size);
       break;
+    case PROP_MAX_THREADS:
+      g_value_set_uint (value, enc->max_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1206,6 +1545,8 @@ gst_opus_enc_set_property (GObject * object, guint prop_id,
   enc->prop = g_value_get_##type (value); \
   if (enc->state) { \
     opus_multistream_encoder_ctl (enc->state, OPUS_SET_##ctl (enc->prop)); \
+  } else if (enc->streams) { \
+    gst_opus_enc_apply_settings (enc); \
   } \
   g_mutex_unlock (&enc->property_lock); \
 } while(0)
@@ -1237,6 +1578,8 @@ gst_opus_enc_set_property (GObject * object, guint prop_id,
         opus_multistream_encoder_ctl (enc->state,
             OPUS_SET_VBR_CONSTRAINT (enc->bitrate_type ==
                 BITRATE_TYPE_CONSTRAINED_VBR), 0);
+      } else if (enc->streams) {
+        gst_opus_enc_apply_settings (enc);
       }
       g_mutex_unlock (&enc->property_lock);
       break;
@@ -1257,6 +1600,11 @@ gst_opus_enc_set_property (GObject * object, guint prop_id,
       enc->max_payload_size = g_value_get_uint (value);
       g_mutex_unlock (&enc->property_lock);
       break;
+    case PROP_MAX_THREADS:
+      g_mutex_lock (&enc->property_lock);
+      enc->max_threads = g_value_get_uint (value);
+      g_mutex_unlock (&enc->property_lock);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
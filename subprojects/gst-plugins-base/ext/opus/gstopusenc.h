@@ -55,6 +55,23 @@ typedef enum
 typedef struct _GstOpusEnc GstOpusEnc;
 typedef struct _GstOpusEncClass GstOpusEncClass;
 
+/* one stream of a multistream layout when the streams are encoded in
+ * parallel */
+typedef struct {
+  OpusEncoder          *state;
+  gint                  channels;
+  gint                  in_channels[2];   /* input channel for each channel */
+  gint16               *pcm;
+  guint8               *packet;
+  gint                  packet_size;      /* or error code */
+} GstOpusEncStream;
+
+typedef struct {
+  GstOpusEnc           *enc;
+  guint                 index;
+  gpointer              id;
+} GstOpusEncJob;
+
 struct _GstOpusEnc {
   GstAudioEncoder       element;
 
@@ -87,6 +104,18 @@ struct _GstOpusEnc {
   guint8                encoding_channel_mapping[256];
   guint8                decoding_channel_mapping[256];
   guint8                n_stereo_streams;
+
+  /* parallel encoding of the streams, used instead of the multistream
+   * encoder in state when there is more than one thread */
+  guint                 max_threads;
+  GstTaskPool          *task_pool;
+  GstOpusEncStream     *streams;
+  guint                 n_streams;
+  GstOpusEncJob        *jobs;
+  guint                 n_jobs;
+  const gint16         *jobs_pcm;
+  gint                  jobs_frame_samples;
+  gint                  jobs_max_bytes;
 };
 
 struct _GstOpusEncClass {
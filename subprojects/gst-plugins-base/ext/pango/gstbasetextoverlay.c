@@ -77,6 +77,11 @@
 #define MINIMUM_OUTLINE_OFFSET 1.0
 #define DEFAULT_SCALE_BASIS    640
 
+/* number of rasterized glyphs kept around */
+#define GLYPH_CACHE_MAX_ENTRIES 1024
+/* glyphs are rasterized at 1/GLYPH_SUBPIXELS pixel positions */
+#define GLYPH_SUBPIXELS 4
+
 enum
 {
   PROP_0,
@@ -701,6 +706,8 @@ gst_base_text_overlay_finalize (GObject * object)
     overlay->layout = NULL;
   }
 
+  g_clear_pointer (&overlay->glyph_cache, g_hash_table_unref);
+
   if (overlay->text_buffer) {
     gst_buffer_unref (overlay->text_buffer);
     overlay->text_buffer = NULL;
@@ -1779,6 +1786,369 @@ gst_text_overlay_filter_foreground_attr (PangoAttribute * attr, gpointer data)
   }
 }
 
+/* Rasterizing text with an outline goes through a cairo path and is slow,
+ * which is most noticeable for overlays whose text changes every frame,
+ * like timecodes. For simple text, each glyph is rasterized once per font,
+ * scale and subpixel position into alpha masks for the shadow, outline and
+ * fill. For every layer the masks of all glyphs are combined into one mask,
+ * which is then painted once in the same layer order as when drawing the
+ * whole layout. Layout still goes through Pango, so kerning and wrapping are
+ * the same, but glyphs are placed at the nearest 1/GLYPH_SUBPIXELS pixel and
+ * overlapping outlines are combined per pixel instead of being stroked as
+ * one path. The result thus differs slightly from Pango's along the glyph
+ * edges. */
+typedef struct
+{
+  PangoFont *font;
+  PangoGlyph glyph;
+  guint subpixel;
+
+  /* offset of the masks from the integer pen position */
+  gint x, y;
+  cairo_surface_t *shadow;
+  cairo_surface_t *outline;
+  cairo_surface_t *fill;
+} GstBaseTextOverlayGlyph;
+
+typedef struct
+{
+  GstBaseTextOverlayGlyph *glyph;
+  gint x, y;
+} GstBaseTextOverlayGlyphPos;
+
+static guint
+glyph_hash (gconstpointer key)
+{
+  const GstBaseTextOverlayGlyph *g = key;
+
+  return g_direct_hash (g->font) ^ (g->glyph * 2654435761u) ^ g->subpixel;
+}
+
+static gboolean
+glyph_equal (gconstpointer a, gconstpointer b)
+{
+  const GstBaseTextOverlayGlyph *ga = a, *gb = b;
+
+  return ga->font == gb->font && ga->glyph == gb->glyph &&
+      ga->subpixel == gb->subpixel;
+}
+
+static void
+glyph_free (GstBaseTextOverlayGlyph * g)
+{
+  g_object_unref (g->font);
+  g_clear_pointer (&g->shadow, cairo_surface_destroy);
+  g_clear_pointer (&g->outline, cairo_surface_destroy);
+  g_clear_pointer (&g->fill, cairo_surface_destroy);
+  g_free (g);
+}
+
+static gboolean
+gst_text_overlay_filter_unsupported_attr (PangoAttribute * attr,
+    gpointer data)
+{
+  switch (attr->klass->type) {
+    case PANGO_ATTR_LANGUAGE:
+    case PANGO_ATTR_FAMILY:
+    case PANGO_ATTR_STYLE:
+    case PANGO_ATTR_WEIGHT:
+    case PANGO_ATTR_VARIANT:
+    case PANGO_ATTR_STRETCH:
+    case PANGO_ATTR_SIZE:
+    case PANGO_ATTR_FONT_DESC:
+    case PANGO_ATTR_SCALE:
+    case PANGO_ATTR_FALLBACK:
+    case PANGO_ATTR_LETTER_SPACING:
+    case PANGO_ATTR_ABSOLUTE_SIZE:
+      return FALSE;
+    default:
+      /* colors, decorations etc. are drawn by the renderer */
+      return TRUE;
+  }
+}
+
+/* Only text in simple alphabetic scripts without per-character styling
+ * is composed from cached glyphs, everything else is left to Pango */
+static gboolean
+gst_base_text_overlay_can_cache_glyphs (GstBaseTextOverlay * overlay)
+{
+  PangoAttrList *attrs;
+  const gchar *p;
+
+  if (overlay->use_vertical_render)
+    return FALSE;
+
+  for (p = pango_layout_get_text (overlay->layout); *p;
+      p = g_utf8_next_char (p)) {
+    gunichar c = g_utf8_get_char (p);
+
+    /* Latin, Greek and Cyrillic without combining marks */
+    if (c >= 0x250 && (c < 0x370 || c >= 0x530))
+      return FALSE;
+  }
+
+  attrs = pango_layout_get_attributes (overlay->layout);
+  if (attrs) {
+    PangoAttrList *tmp, *unsupported;
+
+    /* pango_attr_list_filter() removes the matches from the list */
+    tmp = pango_attr_list_copy (attrs);
+    unsupported = pango_attr_list_filter (tmp,
+        gst_text_overlay_filter_unsupported_attr, NULL);
+    pango_attr_list_unref (tmp);
+    if (unsupported) {
+      pango_attr_list_unref (unsupported);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static cairo_surface_t *
+gst_base_text_overlay_glyph_mask (GstBaseTextOverlay * overlay,
+    GstBaseTextOverlayGlyph * g, gint width, gint height, double origin_x,
+    double origin_y, gboolean stroke)
+{
+  PangoGlyphString *glyphs;
+  cairo_surface_t *surface;
+  cairo_t *cr;
+
+  glyphs = pango_glyph_string_new ();
+  pango_glyph_string_set_size (glyphs, 1);
+  glyphs->glyphs[0].glyph = g->glyph;
+  glyphs->glyphs[0].geometry.width = 0;
+  glyphs->glyphs[0].geometry.x_offset = 0;
+  glyphs->glyphs[0].geometry.y_offset = 0;
+  glyphs->glyphs[0].attr.is_cluster_start = 1;
+  glyphs->log_clusters[0] = 0;
+
+  surface = cairo_image_surface_create (CAIRO_FORMAT_A8, width, height);
+  cr = cairo_create (surface);
+  cairo_translate (cr, origin_x, origin_y);
+  cairo_scale (cr, overlay->glyph_scale_x, overlay->glyph_scale_y);
+  cairo_move_to (cr, 0, 0);
+
+  if (stroke) {
+    cairo_set_line_width (cr, overlay->glyph_outline_offset);
+    pango_cairo_glyph_string_path (cr, g->font, glyphs);
+    cairo_stroke (cr);
+  } else {
+    pango_cairo_show_glyph_string (cr, g->font, glyphs);
+  }
+
+  cairo_destroy (cr);
+  pango_glyph_string_free (glyphs);
+
+  return surface;
+}
+
+static GstBaseTextOverlayGlyph *
+gst_base_text_overlay_get_glyph (GstBaseTextOverlay * overlay,
+    PangoFont * font, PangoGlyph glyph, guint subpixel)
+{
+  GstBaseTextOverlayGlyph key, *g;
+  PangoRectangle ink;
+  double sx = overlay->glyph_scale_x, sy = overlay->glyph_scale_y;
+  double shadow_x, shadow_y, frac_x, frac_y;
+  gint pad, x1, y1;
+
+  key.font = font;
+  key.glyph = glyph;
+  key.subpixel = subpixel;
+  g = g_hash_table_lookup (overlay->glyph_cache, &key);
+  if (g)
+    return g;
+
+  g = g_new0 (GstBaseTextOverlayGlyph, 1);
+  g->font = g_object_ref (font);
+  g->glyph = glyph;
+  g->subpixel = subpixel;
+  g_hash_table_add (overlay->glyph_cache, g);
+
+  pango_font_get_glyph_extents (font, glyph, &ink, NULL);
+  if (ink.width <= 0 || ink.height <= 0)
+    return g;
+
+  shadow_x = overlay->glyph_shadow_offset * sx;
+  shadow_y = overlay->glyph_shadow_offset * sy;
+  frac_x = (double) (subpixel % GLYPH_SUBPIXELS) / GLYPH_SUBPIXELS;
+  frac_y = (double) (subpixel / GLYPH_SUBPIXELS) / GLYPH_SUBPIXELS;
+
+  /* room for the outline, antialiasing and the subpixel offset */
+  pad = ceil (overlay->glyph_outline_offset * MAX (sx, sy) / 2.0) + 2;
+
+  g->x = floor ((double) ink.x * sx / PANGO_SCALE + MIN (shadow_x, 0)) - pad;
+  g->y = floor ((double) ink.y * sy / PANGO_SCALE + MIN (shadow_y, 0)) - pad;
+  x1 = ceil ((double) (ink.x + ink.width) * sx / PANGO_SCALE +
+      MAX (shadow_x, 0)) + pad;
+  y1 = ceil ((double) (ink.y + ink.height) * sy / PANGO_SCALE +
+      MAX (shadow_y, 0)) + pad;
+
+  g->fill = gst_base_text_overlay_glyph_mask (overlay, g, x1 - g->x,
+      y1 - g->y, frac_x - g->x, frac_y - g->y, FALSE);
+  if (overlay->glyph_outline_offset > 0)
+    g->outline = gst_base_text_overlay_glyph_mask (overlay, g, x1 - g->x,
+        y1 - g->y, frac_x - g->x, frac_y - g->y, TRUE);
+  if (overlay->glyph_shadow_offset != 0)
+    g->shadow = gst_base_text_overlay_glyph_mask (overlay, g, x1 - g->x,
+        y1 - g->y, frac_x - g->x + shadow_x, frac_y - g->y + shadow_y, FALSE);
+
+  return g;
+}
+
+/* paints one layer of all glyphs, combining the glyph masks with @op first
+ * so that overlapping glyphs are not blended twice */
+static void
+gst_base_text_overlay_paint_glyphs (cairo_t * cr, GArray * positions,
+    gsize layer, cairo_operator_t op, guint color, double alpha)
+{
+  cairo_surface_t *target = cairo_get_target (cr);
+  cairo_surface_t *layer_mask;
+  cairo_t *layer_cr;
+  guint i;
+
+  layer_mask = cairo_image_surface_create (CAIRO_FORMAT_A8,
+      cairo_image_surface_get_width (target),
+      cairo_image_surface_get_height (target));
+  layer_cr = cairo_create (layer_mask);
+  cairo_set_operator (layer_cr, op);
+
+  for (i = 0; i < positions->len; i++) {
+    GstBaseTextOverlayGlyphPos *pos =
+        &g_array_index (positions, GstBaseTextOverlayGlyphPos, i);
+    cairo_surface_t *mask =
+        G_STRUCT_MEMBER (cairo_surface_t *, pos->glyph, layer);
+
+    if (mask) {
+      cairo_set_source_surface (layer_cr, mask, pos->x + pos->glyph->x,
+          pos->y + pos->glyph->y);
+      cairo_paint (layer_cr);
+    }
+  }
+  cairo_destroy (layer_cr);
+
+  cairo_set_source_rgba (cr, ((color >> 16) & 0xff) / 255.0,
+      ((color >> 8) & 0xff) / 255.0, (color & 0xff) / 255.0, alpha);
+  cairo_mask_surface (cr, layer_mask, 0, 0);
+  cairo_surface_destroy (layer_mask);
+}
+
+/* Composes the layout from cached glyphs with @matrix mapping layout to
+ * device coordinates. Returns %FALSE without drawing anything if the layout
+ * has to be rendered by Pango. */
+static gboolean
+gst_base_text_overlay_render_glyphs (GstBaseTextOverlay * overlay,
+    cairo_t * cr, const cairo_matrix_t * matrix, double scalef_x,
+    double scalef_y)
+{
+  PangoLayoutIter *iter;
+  GArray *positions;
+  gdouble shadow_offset, outline_offset;
+  gboolean ret = TRUE;
+
+  if (!gst_base_text_overlay_can_cache_glyphs (overlay))
+    return FALSE;
+
+  shadow_offset = overlay->draw_shadow ? overlay->shadow_offset : 0.0;
+  outline_offset = overlay->draw_outline ? overlay->outline_offset : 0.0;
+
+  if (!overlay->glyph_cache) {
+    overlay->glyph_cache = g_hash_table_new_full (glyph_hash, glyph_equal,
+        (GDestroyNotify) glyph_free, NULL);
+  }
+
+  if (overlay->glyph_scale_x != scalef_x || overlay->glyph_scale_y != scalef_y
+      || overlay->glyph_shadow_offset != shadow_offset
+      || overlay->glyph_outline_offset != outline_offset
+      || g_hash_table_size (overlay->glyph_cache) >= GLYPH_CACHE_MAX_ENTRIES) {
+    GST_DEBUG_OBJECT (overlay, "flushing %u cached glyphs",
+        g_hash_table_size (overlay->glyph_cache));
+    g_hash_table_remove_all (overlay->glyph_cache);
+    overlay->glyph_scale_x = scalef_x;
+    overlay->glyph_scale_y = scalef_y;
+    overlay->glyph_shadow_offset = shadow_offset;
+    overlay->glyph_outline_offset = outline_offset;
+  }
+
+  positions = g_array_new (FALSE, FALSE, sizeof (GstBaseTextOverlayGlyphPos));
+
+  iter = pango_layout_get_iter (overlay->layout);
+  do {
+    PangoLayoutRun *run = pango_layout_iter_get_run_readonly (iter);
+    PangoRectangle logical_rect;
+    gint baseline, x, i;
+
+    /* end of a line */
+    if (!run)
+      continue;
+
+    pango_layout_iter_get_run_extents (iter, NULL, &logical_rect);
+    baseline = pango_layout_iter_get_baseline (iter);
+    x = logical_rect.x;
+
+    for (i = 0; i < run->glyphs->num_glyphs; i++) {
+      PangoGlyphInfo *info = &run->glyphs->glyphs[i];
+      GstBaseTextOverlayGlyphPos pos;
+      double dx, dy, qx, qy, ix, iy;
+      guint subpixel;
+
+      if (info->glyph & PANGO_GLYPH_UNKNOWN_FLAG) {
+        /* hex boxes are drawn by the renderer */
+        ret = FALSE;
+        goto done;
+      }
+
+      if (info->glyph != PANGO_GLYPH_EMPTY) {
+        dx = (double) (x + info->geometry.x_offset) / PANGO_SCALE;
+        dy = (double) (baseline + info->geometry.y_offset) / PANGO_SCALE;
+        cairo_matrix_transform_point (matrix, &dx, &dy);
+        /* round to the nearest subpixel position */
+        qx = floor (dx * GLYPH_SUBPIXELS + 0.5);
+        qy = floor (dy * GLYPH_SUBPIXELS + 0.5);
+        ix = floor (qx / GLYPH_SUBPIXELS);
+        iy = floor (qy / GLYPH_SUBPIXELS);
+        subpixel = (guint) (qx - ix * GLYPH_SUBPIXELS) + GLYPH_SUBPIXELS *
+            (guint) (qy - iy * GLYPH_SUBPIXELS);
+
+        pos.glyph = gst_base_text_overlay_get_glyph (overlay,
+            run->item->analysis.font, info->glyph, subpixel);
+        pos.x = ix;
+        pos.y = iy;
+        g_array_append_val (positions, pos);
+      }
+      x += info->geometry.width;
+    }
+  } while (pango_layout_iter_next_run (iter));
+
+  GST_LOG_OBJECT (overlay, "composing %u glyphs", positions->len);
+
+  cairo_save (cr);
+  cairo_identity_matrix (cr);
+  /* same layers as gst_base_text_overlay_render_pangocairo(). Glyphs are
+   * added up like cairo does when showing them, the outlines are combined
+   * like the coverage of overlapping strokes */
+  if (shadow_offset != 0)
+    gst_base_text_overlay_paint_glyphs (cr, positions,
+        G_STRUCT_OFFSET (GstBaseTextOverlayGlyph, shadow),
+        CAIRO_OPERATOR_ADD, 0, 0.5);
+  if (outline_offset > 0)
+    gst_base_text_overlay_paint_glyphs (cr, positions,
+        G_STRUCT_OFFSET (GstBaseTextOverlayGlyph, outline),
+        CAIRO_OPERATOR_OVER, overlay->outline_color,
+        ((overlay->outline_color >> 24) & 0xff) / 255.0);
+  gst_base_text_overlay_paint_glyphs (cr, positions,
+      G_STRUCT_OFFSET (GstBaseTextOverlayGlyph, fill), CAIRO_OPERATOR_ADD,
+      overlay->color, ((overlay->color >> 24) & 0xff) / 255.0);
+  cairo_restore (cr);
+
+done:
+  pango_layout_iter_free (iter);
+  g_array_unref (positions);
+
+  return ret;
+}
+
 static void
 gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
     const gchar * string, gint textlen)
@@ -2025,6 +2395,10 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
   /* apply transformations */
   cairo_set_matrix (cr, &cairo_matrix);
 
+  if (gst_base_text_overlay_render_glyphs (overlay, cr, &cairo_matrix,
+          scalef_x, scalef_y))
+    goto done;
+
   /* FIXME: We use show_layout everywhere except for the surface
    * because it's really faster and internally does all kinds of
    * caching. Unfortunately we have to paint to a cairo path for
@@ -2089,6 +2463,7 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
   pango_cairo_show_layout (cr, overlay->layout);
   cairo_restore (cr);
 
+done:
   cairo_destroy (cr);
   cairo_surface_destroy (surface);
   gst_buffer_unmap (buffer, &map);
@@ -229,6 +229,13 @@ struct _GstBaseTextOverlay {
     PangoRectangle           ink_rect;
     PangoRectangle           logical_rect;
 
+    /* rasterized glyphs, and the scaling and effects they were made with */
+    GHashTable              *glyph_cache;
+    gdouble                  glyph_scale_x;
+    gdouble                  glyph_scale_y;
+    gdouble                  glyph_shadow_offset;
+    gdouble                  glyph_outline_offset;
+
     gboolean                    attach_compo_to_buffer;
     GstVideoOverlayComposition *composition;
     GstVideoOverlayComposition *upstream_composition;
@@ -60,6 +60,13 @@
  *
  * The eos signal can also be used to be informed when the EOS state is reached
  * to avoid polling.
+ *
+ * Applications pulling at high rates can reduce the per-sample overhead with
+ * gst_app_sink_try_pull_batch(), which dequeues all immediately available
+ * buffers (up to a limit) with the same caps and segment as a single sample
+ * containing a #GstBufferList. On UNIX, gst_app_sink_get_wakeup_fd() returns
+ * a file descriptor that can be added to the application's own poll or epoll
+ * loop instead of blocking in one of the pull functions.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -71,6 +78,12 @@
 
 #include <string.h>
 
+#ifdef G_OS_UNIX
+#include <glib-unix.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "gstappsrc.h"          /* for GstAppLeakyType */
 #include "gstappsink.h"
 #include "gstapputils.h"
@@ -141,6 +154,11 @@ struct _GstAppSinkPrivate
   Callbacks *callbacks;
 
   GstSample *sample;
+
+  /* pipe that is readable while something can be pulled, created on
+   * demand by gst_app_sink_get_wakeup_fd() */
+  gint wakeup_fds[2];
+  gboolean wakeup_pending;
 };
 
 GST_DEBUG_CATEGORY_STATIC (app_sink_debug);
@@ -753,6 +771,7 @@ gst_app_sink_init (GstAppSink * appsink)
   priv->wait_status = NOONE_WAITING;
   priv->leaky_type = DEFAULT_PROP_LEAKY_TYPE;
   priv->silent = DEFAULT_SILENT;
+  priv->wakeup_fds[0] = priv->wakeup_fds[1] = -1;
 }
 
 static void
@@ -799,6 +818,13 @@ gst_app_sink_finalize (GObject * obj)
   g_cond_clear (&priv->cond);
   gst_vec_deque_free (priv->queue);
 
+#ifdef G_OS_UNIX
+  if (priv->wakeup_fds[0] >= 0) {
+    close (priv->wakeup_fds[0]);
+    close (priv->wakeup_fds[1]);
+  }
+#endif
+
   G_OBJECT_CLASS (parent_class)->finalize (obj);
 }
 
@@ -956,6 +982,35 @@ gst_app_sink_unlock_stop (GstBaseSink * bsink)
   return TRUE;
 }
 
+/* make the wakeup fd readable exactly while an object or EOS is waiting to be
+ * pulled, must be called with the mutex after every change to the queue */
+static void
+gst_app_sink_update_wakeup_unlocked (GstAppSink * appsink)
+{
+#ifdef G_OS_UNIX
+  GstAppSinkPrivate *priv = appsink->priv;
+  gboolean readable;
+
+  if (priv->wakeup_fds[0] < 0)
+    return;
+
+  readable = priv->queue_status_info.queued_buffers > 0
+      || priv->queue_status_info.num_events > 0 || priv->is_eos;
+
+  if (readable && !priv->wakeup_pending) {
+    const guint8 c = 0;
+
+    if (write (priv->wakeup_fds[1], &c, 1) == 1)
+      priv->wakeup_pending = TRUE;
+  } else if (!readable && priv->wakeup_pending) {
+    guint8 c;
+
+    if (read (priv->wakeup_fds[0], &c, 1) == 1)
+      priv->wakeup_pending = FALSE;
+  }
+#endif
+}
+
 static void
 gst_app_sink_flush_unlocked (GstAppSink * appsink)
 {
@@ -973,6 +1028,7 @@ gst_app_sink_flush_unlocked (GstAppSink * appsink)
   gst_caps_replace (&priv->last_caps, NULL);
   g_cond_signal (&priv->cond);
   priv->in = priv->out = priv->dropped = 0;
+  gst_app_sink_update_wakeup_unlocked (appsink);
 }
 
 static gboolean
@@ -1071,6 +1127,7 @@ gst_app_sink_event (GstBaseSink * sink, GstEvent * event)
       GST_DEBUG_OBJECT (appsink, "receiving EOS");
       priv->is_eos = TRUE;
       g_cond_signal (&priv->cond);
+      gst_app_sink_update_wakeup_unlocked (appsink);
       g_mutex_unlock (&priv->mutex);
 
       g_mutex_lock (&priv->mutex);
@@ -1151,6 +1208,7 @@ gst_app_sink_event (GstBaseSink * sink, GstEvent * event)
 
     gst_vec_deque_push_tail (priv->queue, gst_event_ref (event));
     gst_queue_status_info_push_event (&priv->queue_status_info);
+    gst_app_sink_update_wakeup_unlocked (appsink);
 
     if ((priv->wait_status & APP_WAITING))
       g_cond_signal (&priv->cond);
@@ -1373,6 +1431,7 @@ restart:
   gst_vec_deque_push_tail (priv->queue, gst_mini_object_ref (data));
   gst_queue_status_info_push (&priv->queue_status_info, data,
       &priv->last_segment, GST_OBJECT_CAST (appsink));
+  gst_app_sink_update_wakeup_unlocked (appsink);
 
   if ((priv->wait_status & APP_WAITING))
     g_cond_signal (&priv->cond);
@@ -2458,6 +2517,8 @@ gst_app_sink_try_pull_object (GstAppSink * appsink, GstClockTime timeout)
     ret = obj;
   }
 
+  gst_app_sink_update_wakeup_unlocked (appsink);
+
   if ((priv->wait_status & STREAM_WAITING))
     g_cond_signal (&priv->cond);
 
@@ -2487,6 +2548,218 @@ not_started:
   }
 }
 
+/**
+ * gst_app_sink_try_pull_batch:
+ * @appsink: a #GstAppSink
+ * @max_buffers: the maximum number of buffers to return
+ * @timeout: the maximum amount of time to wait for the first buffer
+ *
+ * This function blocks until at least one buffer or EOS becomes available or
+ * the appsink element is set to the READY/NULL state or the timeout expires,
+ * like gst_app_sink_try_pull_sample().
+ *
+ * Unlike gst_app_sink_try_pull_sample(), all buffers that are queued at that
+ * point are returned at once, up to @max_buffers, in the #GstBufferList of
+ * the returned sample. All buffers in the list share the caps and segment of
+ * the sample: a caps or segment change ends the batch and the following
+ * buffers are returned by the next call. Buffer lists received from upstream
+ * are not split up, so a batch can only exceed @max_buffers if it consists of
+ * a single such list. Other serialized events are dropped, as with
+ * gst_app_sink_try_pull_sample().
+ *
+ * This takes the internal lock only once for the whole batch and is meant
+ * for applications that consume many small samples at high rates.
+ *
+ * Returns: (transfer full) (nullable): a #GstSample containing a
+ *     #GstBufferList, or %NULL when the appsink is stopped or EOS or the
+ *     timeout expires. Call gst_sample_unref() after usage.
+ *
+ * Since: 1.28
+ */
+GstSample *
+gst_app_sink_try_pull_batch (GstAppSink * appsink, guint max_buffers,
+    GstClockTime timeout)
+{
+  GstAppSinkPrivate *priv;
+  GstMiniObject *obj;
+  GstBufferList *list;
+  GstSample *ret;
+  gboolean timeout_valid;
+  gint64 end_time;
+  guint n_buffers = 0;
+
+  g_return_val_if_fail (GST_IS_APP_SINK (appsink), NULL);
+  g_return_val_if_fail (max_buffers > 0, NULL);
+
+  timeout_valid = GST_CLOCK_TIME_IS_VALID (timeout);
+
+  if (timeout_valid)
+    end_time =
+        g_get_monotonic_time () + timeout / (GST_SECOND / G_TIME_SPAN_SECOND);
+
+  priv = appsink->priv;
+
+  g_mutex_lock (&priv->mutex);
+  gst_buffer_replace (&priv->preroll_buffer, NULL);
+
+  while (TRUE) {
+    GST_DEBUG_OBJECT (appsink, "trying to grab a batch");
+    if (!priv->started)
+      goto not_started;
+
+    /* activate the caps and segment in front of the first buffer */
+    while (priv->queue_status_info.num_events > 0
+        && GST_IS_EVENT (gst_vec_deque_peek_head (priv->queue)))
+      gst_mini_object_unref (dequeue_object (appsink));
+
+    if (priv->queue_status_info.queued_buffers > 0)
+      break;
+
+    if (priv->is_eos)
+      goto eos;
+
+    gst_app_sink_update_wakeup_unlocked (appsink);
+
+    /* nothing to return, wait */
+    GST_DEBUG_OBJECT (appsink, "waiting for a buffer");
+    priv->wait_status |= APP_WAITING;
+    if (timeout_valid) {
+      if (!g_cond_wait_until (&priv->cond, &priv->mutex, end_time))
+        goto expired;
+    } else {
+      g_cond_wait (&priv->cond, &priv->mutex);
+    }
+    priv->wait_status &= ~APP_WAITING;
+  }
+
+  list = gst_buffer_list_new_sized (MIN (max_buffers,
+          priv->queue_status_info.queued_buffers));
+
+  while (n_buffers < max_buffers
+      && (obj = gst_vec_deque_peek_head (priv->queue))) {
+    if (GST_IS_EVENT (obj)) {
+      GstEventType type = GST_EVENT_TYPE (obj);
+
+      if (type == GST_EVENT_CAPS || type == GST_EVENT_SEGMENT)
+        break;
+
+      gst_mini_object_unref (dequeue_object (appsink));
+    } else if (GST_IS_BUFFER_LIST (obj)) {
+      guint i, len = gst_buffer_list_length (GST_BUFFER_LIST_CAST (obj));
+
+      if (n_buffers > 0 && n_buffers + len > max_buffers)
+        break;
+
+      obj = dequeue_object (appsink);
+      for (i = 0; i < len; i++)
+        gst_buffer_list_add (list,
+            gst_buffer_ref (gst_buffer_list_get (GST_BUFFER_LIST_CAST (obj),
+                    i)));
+      gst_mini_object_unref (obj);
+      n_buffers += len;
+    } else {
+      obj = dequeue_object (appsink);
+      gst_buffer_list_add (list, GST_BUFFER_CAST (obj));
+      n_buffers++;
+    }
+  }
+
+  GST_DEBUG_OBJECT (appsink, "we have a batch of %u buffers", n_buffers);
+  priv->out += n_buffers;
+  priv->sample = gst_sample_make_writable (priv->sample);
+  gst_sample_set_buffer (priv->sample, NULL);
+  gst_sample_set_buffer_list (priv->sample, list);
+  gst_buffer_list_unref (list);
+  ret = gst_sample_ref (priv->sample);
+
+  gst_app_sink_update_wakeup_unlocked (appsink);
+
+  if ((priv->wait_status & STREAM_WAITING))
+    g_cond_signal (&priv->cond);
+
+  g_mutex_unlock (&priv->mutex);
+
+  return ret;
+
+  /* special conditions */
+expired:
+  {
+    GST_DEBUG_OBJECT (appsink, "timeout expired, return NULL");
+    priv->wait_status &= ~APP_WAITING;
+    g_mutex_unlock (&priv->mutex);
+    return NULL;
+  }
+eos:
+  {
+    GST_DEBUG_OBJECT (appsink, "we are EOS, return NULL");
+    gst_app_sink_update_wakeup_unlocked (appsink);
+    g_mutex_unlock (&priv->mutex);
+    return NULL;
+  }
+not_started:
+  {
+    GST_DEBUG_OBJECT (appsink, "we are stopped, return NULL");
+    g_mutex_unlock (&priv->mutex);
+    return NULL;
+  }
+}
+
+/**
+ * gst_app_sink_get_wakeup_fd:
+ * @appsink: a #GstAppSink
+ *
+ * Get a file descriptor that is readable whenever
+ * gst_app_sink_try_pull_object() would not block, i.e. while a sample or a
+ * serialized event is queued or after EOS was received. It becomes
+ * unreadable again once everything was pulled.
+ *
+ * This allows integrating appsink into an existing poll, epoll or
+ * #GMainContext based event loop, pulling with a timeout of 0 whenever the
+ * file descriptor becomes readable, instead of dedicating a thread to
+ * blocking in the pull functions.
+ *
+ * The file descriptor is owned by @appsink and stays valid for its lifetime.
+ * It must not be read from, written to or closed by the application.
+ *
+ * Returns: the file descriptor, or -1 if this is not supported on the
+ *     current platform.
+ *
+ * Since: 1.28
+ */
+gint
+gst_app_sink_get_wakeup_fd (GstAppSink * appsink)
+{
+  GstAppSinkPrivate *priv;
+  gint fd = -1;
+
+  g_return_val_if_fail (GST_IS_APP_SINK (appsink), -1);
+
+  priv = appsink->priv;
+
+#ifdef G_OS_UNIX
+  g_mutex_lock (&priv->mutex);
+  if (priv->wakeup_fds[0] < 0) {
+    GError *err = NULL;
+
+    if (g_unix_open_pipe (priv->wakeup_fds, FD_CLOEXEC, &err)) {
+      g_unix_set_fd_nonblocking (priv->wakeup_fds[0], TRUE, NULL);
+      g_unix_set_fd_nonblocking (priv->wakeup_fds[1], TRUE, NULL);
+      priv->wakeup_pending = FALSE;
+      gst_app_sink_update_wakeup_unlocked (appsink);
+    } else {
+      GST_WARNING_OBJECT (appsink, "failed to create wakeup pipe: %s",
+          err->message);
+      g_clear_error (&err);
+      priv->wakeup_fds[0] = priv->wakeup_fds[1] = -1;
+    }
+  }
+  fd = priv->wakeup_fds[0];
+  g_mutex_unlock (&priv->mutex);
+#endif
+
+  return fd;
+}
+
 /**
  * gst_app_sink_set_callbacks: (skip)
  * @appsink: a #GstAppSink
@@ -215,6 +215,12 @@ GstSample *     gst_app_sink_try_pull_sample  (GstAppSink *appsink, GstClockTime
 GST_APP_API
 GstMiniObject * gst_app_sink_try_pull_object    (GstAppSink *appsink, GstClockTime timeout);
 
+GST_APP_API
+GstSample *     gst_app_sink_try_pull_batch   (GstAppSink *appsink, guint max_buffers, GstClockTime timeout);
+
+GST_APP_API
+gint            gst_app_sink_get_wakeup_fd    (GstAppSink *appsink);
+
 GST_APP_API
 void            gst_app_sink_set_callbacks    (GstAppSink * appsink,
                                                GstAppSinkCallbacks *callbacks,
@@ -1384,6 +1384,10 @@ serialize_info_if_required (GstDiscoverer * dc, GstDiscovererInfo * info)
       && info->result == GST_DISCOVERER_OK) {
     GVariant *variant = gst_discoverer_info_to_variant (info,
         GST_DISCOVERER_SERIALIZE_ALL);
+    gchar *cache_dir = g_path_get_dirname (dc->priv->current_cachefile);
+
+    g_mkdir_with_parents (cache_dir, 0777);
+    g_free (cache_dir);
 
     g_file_set_contents (dc->priv->current_cachefile,
         g_variant_get_data (variant), g_variant_get_size (variant), NULL);
@@ -1838,8 +1842,9 @@ _serialized_info_get_path (GstDiscoverer * dc, gchar * uri)
   cache_dir =
       g_build_filename (g_get_user_cache_dir (), "gstreamer-" GST_API_VERSION,
       CACHE_DIRNAME, hash_dirname, NULL);
-  g_mkdir_with_parents (cache_dir, 0777);
 
+  /* the directory is only created when storing, lookups for files that
+   * aren't cached yet should not touch the file system */
   res = g_build_filename (cache_dir, &checksum[2], NULL);
 
 done:
@@ -2684,6 +2689,139 @@ gst_discoverer_discover_uri (GstDiscoverer * discoverer, const gchar * uri,
   return info;
 }
 
+typedef struct
+{
+  GstDiscoverer *discoverer;
+  const gchar *const *uris;
+  guint n_uris;
+  GstDiscovererInfo **infos;
+  gint next;
+  /* settings of the discoverer when the batch was started */
+  GstClockTime timeout;
+  gboolean use_cache;
+} DiscoverBatch;
+
+static void
+batch_source_setup_cb (GstDiscoverer * worker, GstElement * source,
+    GstDiscoverer * dc)
+{
+  g_signal_emit (dc, gst_discoverer_signals[SIGNAL_SOURCE_SETUP], 0, source);
+}
+
+static gpointer
+discover_batch_worker (DiscoverBatch * batch)
+{
+  GstDiscoverer *dc = batch->discoverer;
+  GstDiscoverer *worker;
+  guint i;
+
+  worker = g_object_new (GST_TYPE_DISCOVERER, "timeout", batch->timeout,
+      "use-cache", batch->use_cache, NULL);
+  if (worker->priv->uridecodebin == NULL) {
+    g_object_unref (worker);
+    worker = NULL;
+  } else {
+    g_signal_connect (worker, "source-setup",
+        G_CALLBACK (batch_source_setup_cb), dc);
+  }
+
+  while ((i = (guint) g_atomic_int_add (&batch->next, 1)) < batch->n_uris) {
+    GstDiscovererInfo *info = NULL;
+    GError *err = NULL;
+
+    if (worker)
+      info = gst_discoverer_discover_uri (worker, batch->uris[i], &err);
+
+    if (!info) {
+      info = g_object_new (GST_TYPE_DISCOVERER_INFO, NULL);
+      info->uri = g_strdup (batch->uris[i]);
+      info->result = GST_DISCOVERER_ERROR;
+    }
+    if (err) {
+      GST_DEBUG_OBJECT (dc, "error discovering %s: %s", batch->uris[i],
+          err->message);
+      g_error_free (err);
+    }
+
+    batch->infos[i] = info;
+  }
+
+  if (worker)
+    g_object_unref (worker);
+
+  return NULL;
+}
+
+/**
+ * gst_discoverer_discover_uris:
+ * @discoverer: A #GstDiscoverer
+ * @uris: (array zero-terminated=1): The URIs to run on.
+ * @max_pipelines: the maximum number of URIs to discover at the same time,
+ *     or 0 to use the number of processors
+ *
+ * Synchronously discovers all @uris, running up to @max_pipelines
+ * discoveries in parallel. Each of them uses its own pipeline with the
+ * #GstDiscoverer:timeout and #GstDiscoverer:use-cache settings of
+ * @discoverer. The #GstDiscoverer::source-setup signal of @discoverer is
+ * emitted for every source, from the thread discovering it.
+ *
+ * URIs with a valid entry in the discoverer cache are answered from it
+ * without setting up a pipeline, so rescanning a collection with
+ * #GstDiscoverer:use-cache enabled only pays for the files that changed.
+ *
+ * @discoverer itself must not be discovering anything else meanwhile.
+ *
+ * Returns: (transfer full) (element-type GstDiscovererInfo): a
+ * #GstDiscovererInfo for each of @uris, in the same order. Check
+ * gst_discoverer_info_get_result() to find which of them failed.
+ *
+ * Since: 1.28
+ */
+GPtrArray *
+gst_discoverer_discover_uris (GstDiscoverer * discoverer,
+    const gchar * const *uris, guint max_pipelines)
+{
+  DiscoverBatch batch;
+  GThread **threads;
+  GPtrArray *res;
+  guint i, n_threads;
+
+  g_return_val_if_fail (GST_IS_DISCOVERER (discoverer), NULL);
+  g_return_val_if_fail (uris != NULL, NULL);
+
+  batch.discoverer = discoverer;
+  batch.uris = uris;
+  batch.n_uris = g_strv_length ((gchar **) uris);
+  batch.infos = g_new0 (GstDiscovererInfo *, batch.n_uris);
+  batch.next = 0;
+
+  DISCO_LOCK (discoverer);
+  batch.timeout = discoverer->priv->timeout;
+  batch.use_cache = discoverer->priv->use_cache;
+  DISCO_UNLOCK (discoverer);
+
+  if (max_pipelines == 0)
+    max_pipelines = g_get_num_processors ();
+  n_threads = MIN (max_pipelines, batch.n_uris);
+
+  GST_DEBUG_OBJECT (discoverer, "discovering %u uris with %u pipelines",
+      batch.n_uris, n_threads);
+
+  threads = g_newa (GThread *, MAX (n_threads, 1));
+  for (i = 0; i < n_threads; i++)
+    threads[i] = g_thread_new ("discoverer",
+        (GThreadFunc) discover_batch_worker, &batch);
+  for (i = 0; i < n_threads; i++)
+    g_thread_join (threads[i]);
+
+  res = g_ptr_array_new_full (batch.n_uris, g_object_unref);
+  for (i = 0; i < batch.n_uris; i++)
+    g_ptr_array_add (res, batch.infos[i]);
+  g_free (batch.infos);
+
+  return res;
+}
+
 /**
  * gst_discoverer_new:
  * @timeout: timeout per file, in nanoseconds. Allowed are values between
@@ -430,6 +430,11 @@ gst_discoverer_discover_uri (GstDiscoverer * discoverer,
 			     const gchar * uri,
 			     GError ** err);
 
+GST_PBUTILS_API
+GPtrArray *    gst_discoverer_discover_uris (GstDiscoverer * discoverer,
+					      const gchar * const * uris,
+					      guint max_pipelines);
+
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstDiscoverer, gst_object_unref)
 
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstDiscovererAudioInfo, gst_object_unref)
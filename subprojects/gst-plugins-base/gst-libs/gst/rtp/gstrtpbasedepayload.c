@@ -115,6 +115,9 @@ struct _GstRTPBaseDepayloadPrivate
   GstBuffer *hdrext_delayed;
   GstBuffer *hdrext_outbuf;
   gboolean hdrext_read_result;
+
+  /* headers of the buffer list being processed */
+  GstRTPBufferListHeaders list_headers;
 };
 
 /* Filter signals and args */
@@ -498,6 +501,7 @@ gst_rtp_base_depayload_finalize (GObject * object)
 
   g_ptr_array_unref (rtpbasedepayload->priv->header_exts);
   gst_clear_buffer_list (&rtpbasedepayload->priv->hdrext_buffers);
+  gst_rtp_buffer_list_headers_clear (&rtpbasedepayload->priv->list_headers);
   if (priv->hdrext_delayed)
     gst_buffer_unref (priv->hdrext_delayed);
 
@@ -754,10 +758,14 @@ caps_not_changed:
   }
 }
 
-/* takes ownership of the input buffer */
+/* takes ownership of the input buffer. When @in is part of a buffer list,
+ * @headers can contain its already parsed header at @idx. This is only
+ * done for subclasses with a process method, so the buffer is then not
+ * mapped at all. */
 static GstFlowReturn
 gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
-    GstRTPBaseDepayloadClass * bclass, GstBuffer * in)
+    GstRTPBaseDepayloadClass * bclass, GstBuffer * in,
+    const GstRTPBufferListHeaders * headers, guint idx)
 {
   GstBuffer *(*process_rtp_packet_func) (GstRTPBaseDepayload * base,
       GstRTPBuffer * rtp_buffer);
@@ -772,6 +780,8 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
   GstRTPBuffer rtp = { NULL };
   GstReferenceTimestampMeta *meta;
   GstCaps *ref_caps;
+  gboolean has_extension;
+  guint header_len;
 
   priv = filter->priv;
   priv->process_flow_ret = GST_FLOW_OK;
@@ -798,8 +808,25 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
     }
   }
 
-  if (G_UNLIKELY (!gst_rtp_buffer_map (in, GST_MAP_READ, &rtp)))
-    goto invalid_buffer;
+  if (headers) {
+    if (G_UNLIKELY (!headers->valid[idx]))
+      goto invalid_buffer;
+
+    ssrc = headers->ssrc[idx];
+    seqnum = headers->seq[idx];
+    rtptime = headers->timestamp[idx];
+    has_extension = headers->extension_offset[idx] != 0;
+    header_len = headers->header_len[idx];
+  } else {
+    if (G_UNLIKELY (!gst_rtp_buffer_map (in, GST_MAP_READ, &rtp)))
+      goto invalid_buffer;
+
+    ssrc = gst_rtp_buffer_get_ssrc (&rtp);
+    seqnum = gst_rtp_buffer_get_seq (&rtp);
+    rtptime = gst_rtp_buffer_get_timestamp (&rtp);
+    has_extension = gst_rtp_buffer_get_extension (&rtp);
+    header_len = gst_rtp_buffer_get_header_len (&rtp);
+  }
 
   buf_discont = GST_BUFFER_IS_DISCONT (in);
 
@@ -807,10 +834,6 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
   priv->dts = GST_BUFFER_DTS (in);
   priv->duration = GST_BUFFER_DURATION (in);
 
-  ssrc = gst_rtp_buffer_get_ssrc (&rtp);
-  seqnum = gst_rtp_buffer_get_seq (&rtp);
-  rtptime = gst_rtp_buffer_get_timestamp (&rtp);
-
   priv->last_seqnum = seqnum;
   priv->last_rtptime = rtptime;
 
@@ -876,7 +899,7 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
       /* depayloaders will check flag on rtpbuffer->buffer, so if the input
        * buffer was not writable already we need to remap to make our
        * newly-flagged buffer current on the rtpbuffer */
-      if (in != old_inbuf) {
+      if (in != old_inbuf && rtp.buffer) {
         gst_rtp_buffer_unmap (&rtp);
         if (G_UNLIKELY (!gst_rtp_buffer_map (in, GST_MAP_READ, &rtp)))
           goto invalid_buffer;
@@ -899,8 +922,7 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
   }
 
   /* update RTP buffer cache for header extensions if any */
-  if (priv->hdrext_aggregate &&
-      !priv->hdrext_seen && gst_rtp_buffer_get_extension (&rtp)) {
+  if (priv->hdrext_aggregate && !priv->hdrext_seen && has_extension) {
     GST_INFO_OBJECT (filter, "Activate RTP header ext aggregation");
     priv->hdrext_seen = priv->hdrext_aggregate;
   }
@@ -909,9 +931,8 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
     GstBuffer *b = gst_buffer_new ();
     /* make a copy of the buffer that only contains the RTP header
        with the extensions to not waste too much memory */
-    guint s = gst_rtp_buffer_get_header_len (&rtp);
     gst_buffer_copy_into (b, in,
-        GST_BUFFER_COPY_MEMORY | GST_BUFFER_COPY_DEEP, 0, s);
+        GST_BUFFER_COPY_MEMORY | GST_BUFFER_COPY_DEEP, 0, header_len);
     gst_buffer_list_add (priv->hdrext_buffers, b);
   }
 
@@ -919,7 +940,8 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
     out_buf = process_rtp_packet_func (filter, &rtp);
     gst_rtp_buffer_unmap (&rtp);
   } else if (process_func != NULL) {
-    gst_rtp_buffer_unmap (&rtp);
+    if (rtp.buffer)
+      gst_rtp_buffer_unmap (&rtp);
     out_buf = process_func (filter, in);
   } else {
     goto no_process;
@@ -975,13 +997,15 @@ invalid_buffer:
   }
 dropping:
   {
-    gst_rtp_buffer_unmap (&rtp);
+    if (rtp.buffer)
+      gst_rtp_buffer_unmap (&rtp);
     gst_buffer_unref (in);
     return GST_FLOW_OK;
   }
 no_process:
   {
-    gst_rtp_buffer_unmap (&rtp);
+    if (rtp.buffer)
+      gst_rtp_buffer_unmap (&rtp);
     /* this is not fatal but should be filtered earlier */
     GST_ELEMENT_ERROR (filter, STREAM, NOT_IMPLEMENTED, (NULL),
         ("The subclass does not have a process or process_rtp_packet method"));
@@ -1001,7 +1025,8 @@ gst_rtp_base_depayload_chain (GstPad * pad, GstObject * parent, GstBuffer * in)
 
   bclass = GST_RTP_BASE_DEPAYLOAD_GET_CLASS (basedepay);
 
-  flow_ret = gst_rtp_base_depayload_handle_buffer (basedepay, bclass, in);
+  flow_ret = gst_rtp_base_depayload_handle_buffer (basedepay, bclass, in,
+      NULL, 0);
 
   return flow_ret;
 }
@@ -1012,6 +1037,7 @@ gst_rtp_base_depayload_chain_list (GstPad * pad, GstObject * parent,
 {
   GstRTPBaseDepayloadClass *bclass;
   GstRTPBaseDepayload *basedepay;
+  GstRTPBufferListHeaders *headers = NULL;
   GstFlowReturn flow_ret;
   GstBuffer *buffer;
   guint i, len;
@@ -1028,6 +1054,14 @@ gst_rtp_base_depayload_chain_list (GstPad * pad, GstObject * parent,
   if (len == 0)
     goto done;
 
+  /* parse all headers at once so the buffers don't need to be mapped. A
+   * process_rtp_packet subclass needs every buffer mapped anyway, parsing
+   * the headers first would only map them twice */
+  if (bclass->process_rtp_packet == NULL) {
+    headers = &basedepay->priv->list_headers;
+    gst_rtp_buffer_list_parse_headers (list, headers);
+  }
+
   for (i = 0; i < len; i++) {
     buffer = gst_buffer_list_get (list, i);
 
@@ -1038,7 +1072,8 @@ gst_rtp_base_depayload_chain_list (GstPad * pad, GstObject * parent,
     /* Should we fix up any missing timestamps for list buffers here
      * (e.g. set to first or previous timestamp in list) or just assume
      * the's a jitterbuffer that will have done that for us? */
-    flow_ret = gst_rtp_base_depayload_handle_buffer (basedepay, bclass, buffer);
+    flow_ret = gst_rtp_base_depayload_handle_buffer (basedepay, bclass, buffer,
+        headers, i);
     if (flow_ret != GST_FLOW_OK)
       break;
   }
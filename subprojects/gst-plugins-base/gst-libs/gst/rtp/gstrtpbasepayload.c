@@ -1995,8 +1995,22 @@ gst_rtp_base_payload_prepare_push (GstRTPBasePayload * payload,
   /* set ssrc, payload type, seq number, caps and rtptime */
   /* remove unwanted meta */
   if (is_list) {
-    gst_buffer_list_foreach (GST_BUFFER_LIST_CAST (obj), set_headers, &data);
-    gst_buffer_list_foreach (GST_BUFFER_LIST_CAST (obj), filter_meta, NULL);
+    GstBufferList *list = GST_BUFFER_LIST_CAST (obj);
+    gboolean write_hdrext;
+
+    GST_OBJECT_LOCK (payload);
+    write_hdrext = priv->header_exts->len > 0 && priv->input_meta_buffer;
+    GST_OBJECT_UNLOCK (payload);
+
+    /* without header extensions to write only the fixed header changes,
+     * which can be done for all packets in one go */
+    if (!write_hdrext && gst_buffer_list_is_writable (list)) {
+      data.seqnum += gst_rtp_buffer_list_set_headers (list, data.ssrc,
+          data.pt, data.seqnum, data.rtptime);
+    } else {
+      gst_buffer_list_foreach (list, set_headers, &data);
+    }
+    gst_buffer_list_foreach (list, filter_meta, NULL);
     /* sequence number has increased more if this was a buffer list */
     payload->seqnum = data.seqnum - 1;
   } else {
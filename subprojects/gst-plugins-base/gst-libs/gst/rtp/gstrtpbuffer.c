@@ -1766,3 +1766,182 @@ gst_rtp_buffer_add_extension_twobytes_header (GstRTPBuffer * rtp,
 
   return TRUE;
 }
+
+static void
+rtp_buffer_list_headers_alloc (GstRTPBufferListHeaders * headers, guint n)
+{
+  guint8 *mem;
+
+  if (n > headers->allocated) {
+    /* all arrays in one block, sorted by alignment */
+    g_free (headers->timestamp);
+    mem = g_malloc (n * (4 * sizeof (guint32) + 2 * sizeof (guint16) + 3));
+
+    headers->timestamp = (guint32 *) mem;
+    headers->ssrc = headers->timestamp + n;
+    headers->header_len = (guint *) (headers->ssrc + n);
+    headers->payload_len = headers->header_len + n;
+    headers->seq = (guint16 *) (headers->payload_len + n);
+    headers->extension_offset = headers->seq + n;
+    headers->valid = (guint8 *) (headers->extension_offset + n);
+    headers->marker = headers->valid + n;
+    headers->payload_type = headers->marker + n;
+    headers->allocated = n;
+  }
+  headers->n_packets = n;
+}
+
+static gboolean
+rtp_buffer_list_parse_header (GstRTPBufferListHeaders * headers, guint i,
+    GstBuffer * buffer)
+{
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+
+  /* accept exactly the packets that can be mapped later */
+  if (!gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp))
+    return FALSE;
+
+  headers->marker[i] = gst_rtp_buffer_get_marker (&rtp);
+  headers->payload_type[i] = gst_rtp_buffer_get_payload_type (&rtp);
+  headers->seq[i] = gst_rtp_buffer_get_seq (&rtp);
+  headers->timestamp[i] = gst_rtp_buffer_get_timestamp (&rtp);
+  headers->ssrc[i] = gst_rtp_buffer_get_ssrc (&rtp);
+  headers->header_len[i] = gst_rtp_buffer_get_header_len (&rtp);
+  if (gst_rtp_buffer_get_extension (&rtp))
+    headers->extension_offset[i] = headers->header_len[i] - rtp.size[1];
+  else
+    headers->extension_offset[i] = 0;
+  headers->payload_len[i] = gst_rtp_buffer_get_payload_len (&rtp);
+
+  gst_rtp_buffer_unmap (&rtp);
+
+  return TRUE;
+}
+
+/**
+ * gst_rtp_buffer_list_parse_headers:
+ * @list: a #GstBufferList with RTP packets
+ * @headers: (out caller-allocates): a #GstRTPBufferListHeaders
+ *
+ * Validates all packets in @list and extracts their header fields into
+ * @headers in a single pass, e.g. for deciding which packets to process or
+ * drop before looking at any of them in detail.
+ *
+ * A packet is valid exactly when gst_rtp_buffer_map() succeeds on it.
+ *
+ * Release the arrays with gst_rtp_buffer_list_headers_clear() when done.
+ *
+ * Returns: the number of valid RTP packets in @list
+ *
+ * Since: 1.28
+ */
+guint
+gst_rtp_buffer_list_parse_headers (GstBufferList * list,
+    GstRTPBufferListHeaders * headers)
+{
+  guint i, len, n_valid = 0;
+
+  g_return_val_if_fail (GST_IS_BUFFER_LIST (list), 0);
+  g_return_val_if_fail (headers != NULL, 0);
+
+  len = gst_buffer_list_length (list);
+  rtp_buffer_list_headers_alloc (headers, len);
+
+  for (i = 0; i < len; i++) {
+    if (rtp_buffer_list_parse_header (headers, i,
+            gst_buffer_list_get (list, i))) {
+      headers->valid[i] = TRUE;
+      n_valid++;
+    } else {
+      GST_DEBUG ("packet %u of list %p is not a valid RTP packet", i, list);
+      headers->valid[i] = FALSE;
+      headers->marker[i] = 0;
+      headers->payload_type[i] = 0;
+      headers->seq[i] = 0;
+      headers->timestamp[i] = 0;
+      headers->ssrc[i] = 0;
+      headers->header_len[i] = 0;
+      headers->extension_offset[i] = 0;
+      headers->payload_len[i] = 0;
+    }
+  }
+
+  return n_valid;
+}
+
+/**
+ * gst_rtp_buffer_list_headers_clear:
+ * @headers: a #GstRTPBufferListHeaders
+ *
+ * Frees the arrays of @headers and resets it so it can be reused.
+ *
+ * Since: 1.28
+ */
+void
+gst_rtp_buffer_list_headers_clear (GstRTPBufferListHeaders * headers)
+{
+  g_return_if_fail (headers != NULL);
+
+  /* the start of the allocated block */
+  g_free (headers->timestamp);
+  memset (headers, 0, sizeof (GstRTPBufferListHeaders));
+}
+
+/**
+ * gst_rtp_buffer_list_set_headers:
+ * @list: a writable #GstBufferList with RTP packets
+ * @ssrc: the SSRC to set
+ * @payload_type: the payload type to set
+ * @seq: the sequence number of the first packet
+ * @timestamp: the RTP timestamp to set
+ *
+ * Sets @ssrc, @payload_type and @timestamp on all packets of @list and
+ * numbers them with consecutive sequence numbers starting at @seq. Only the
+ * fixed RTP header is touched, which avoids mapping and validating the
+ * whole packet as gst_rtp_buffer_map() would.
+ *
+ * Stops at the first packet that is not a valid RTP packet.
+ *
+ * Returns: the number of packets that were updated
+ *
+ * Since: 1.28
+ */
+guint
+gst_rtp_buffer_list_set_headers (GstBufferList * list, guint32 ssrc,
+    guint8 payload_type, guint16 seq, guint32 timestamp)
+{
+  guint i, len;
+
+  g_return_val_if_fail (GST_IS_BUFFER_LIST (list), 0);
+  g_return_val_if_fail (gst_buffer_list_is_writable (list), 0);
+  g_return_val_if_fail (payload_type < 0x80, 0);
+
+  len = gst_buffer_list_length (list);
+  for (i = 0; i < len; i++) {
+    GstBuffer *buffer = gst_buffer_list_get_writable (list, i);
+    GstMapInfo map;
+    guint8 *data;
+
+    if (gst_buffer_n_memory (buffer) < 1 ||
+        !gst_buffer_map_range (buffer, 0, 1, &map, GST_MAP_READWRITE))
+      break;
+
+    data = map.data;
+    if (G_UNLIKELY (map.size < GST_RTP_HEADER_LEN ||
+            (data[0] & 0xc0) != (GST_RTP_VERSION << 6))) {
+      GST_ERROR ("packet %u of list %p is not a valid RTP packet", i, list);
+      gst_buffer_unmap (buffer, &map);
+      break;
+    }
+
+    data[1] = (data[1] & 0x80) | payload_type;
+    GST_WRITE_UINT16_BE (data + 2, seq);
+    GST_WRITE_UINT32_BE (data + 4, timestamp);
+    GST_WRITE_UINT32_BE (data + 8, ssrc);
+    gst_buffer_unmap (buffer, &map);
+
+    seq++;
+  }
+
+  return i;
+}
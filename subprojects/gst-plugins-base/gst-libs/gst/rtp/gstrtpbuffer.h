@@ -239,6 +239,74 @@ gboolean gst_rtp_buffer_get_extension_onebyte_header_from_bytes (GBytes * bytes,
                                                                  gpointer * data,
                                                                  guint * size);
 
+/**
+ * GstRTPBufferListHeaders:
+ * @n_packets: the number of packets in the parsed #GstBufferList
+ * @valid: for each packet, whether it is a valid RTP packet. All other
+ *     fields are 0 for invalid packets.
+ * @marker: the marker bit of each packet
+ * @payload_type: the payload type of each packet
+ * @seq: the sequence number of each packet
+ * @timestamp: the RTP timestamp of each packet
+ * @ssrc: the SSRC of each packet
+ * @header_len: the length of the RTP header of each packet, including the
+ *     CSRC list and the header extension. This is the offset of the payload.
+ * @extension_offset: the offset of the header extension of each packet, or
+ *     0 if it has none
+ * @payload_len: the length of the payload of each packet, without padding
+ *
+ * The RTP header fields of all packets in a #GstBufferList, as filled in by
+ * gst_rtp_buffer_list_parse_headers(). Each field is an array with
+ * @n_packets entries.
+ *
+ * The structure must be initialized with %GST_RTP_BUFFER_LIST_HEADERS_INIT
+ * and can be reused for parsing several lists, which avoids allocations.
+ *
+ * Since: 1.28
+ */
+typedef struct _GstRTPBufferListHeaders GstRTPBufferListHeaders;
+
+struct _GstRTPBufferListHeaders
+{
+  guint     n_packets;
+  guint8   *valid;
+  guint8   *marker;
+  guint8   *payload_type;
+  guint16  *seq;
+  guint32  *timestamp;
+  guint32  *ssrc;
+  guint    *header_len;
+  guint16  *extension_offset;
+  guint    *payload_len;
+
+  /*< private >*/
+  guint     allocated;
+  gpointer  _gst_reserved[GST_PADDING];
+};
+
+/**
+ * GST_RTP_BUFFER_LIST_HEADERS_INIT:
+ *
+ * Initializer for a #GstRTPBufferListHeaders.
+ *
+ * Since: 1.28
+ */
+#define GST_RTP_BUFFER_LIST_HEADERS_INIT { 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, { NULL, } }
+
+GST_RTP_API
+guint          gst_rtp_buffer_list_parse_headers  (GstBufferList * list,
+                                                   GstRTPBufferListHeaders * headers);
+
+GST_RTP_API
+void           gst_rtp_buffer_list_headers_clear  (GstRTPBufferListHeaders * headers);
+
+GST_RTP_API
+guint          gst_rtp_buffer_list_set_headers    (GstBufferList * list,
+                                                   guint32 ssrc,
+                                                   guint8 payload_type,
+                                                   guint16 seq,
+                                                   guint32 timestamp);
+
 /**
  * GstRTPBufferFlags:
  * @GST_RTP_BUFFER_FLAG_RETRANSMISSION: The #GstBuffer was once wrapped
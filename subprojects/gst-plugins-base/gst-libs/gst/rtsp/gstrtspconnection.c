@@ -2558,7 +2558,8 @@ parse_line (guint8 * buffer, GstRTSPMessage * msg)
       if (field != GST_RTSP_HDR_INVALID)
         gst_rtsp_message_add_header (msg, field, value);
       else
-        gst_rtsp_message_add_header_by_name (msg, field_name, value);
+        gst_rtsp_message_take_header_by_name (msg, field_name,
+            g_strdup (value));
     }
 
     value = next_value;
@@ -190,6 +190,42 @@ static struct rtsp_header rtsp_headers[] = {
   {NULL, FALSE}
 };
 
+/* header names are case insensitive, hash them like g_str_hash() does but on
+ * the lowercase characters */
+static guint
+rtsp_header_hash (gconstpointer key)
+{
+  const gchar *p;
+  guint32 h = 5381;
+
+  for (p = key; *p != '\0'; p++)
+    h = (h << 5) + h + g_ascii_tolower (*p);
+
+  return h;
+}
+
+static gboolean
+rtsp_header_equal (gconstpointer a, gconstpointer b)
+{
+  return g_ascii_strcasecmp (a, b) == 0;
+}
+
+/* maps the header names to their GstRTSPHeaderField, header parsing looks up
+ * every received header line in here */
+static GHashTable *
+rtsp_init_headers (void)
+{
+  GHashTable *headers;
+  gint idx;
+
+  headers = g_hash_table_new (rtsp_header_hash, rtsp_header_equal);
+  for (idx = 0; rtsp_headers[idx].name; idx++)
+    g_hash_table_insert (headers, (gpointer) rtsp_headers[idx].name,
+        GINT_TO_POINTER (idx + 1));
+
+  return headers;
+}
+
 #define DEF_STATUS(c, t) \
   g_hash_table_insert (statuses, GUINT_TO_POINTER(c), (gpointer) t)
 
@@ -406,14 +442,12 @@ gst_rtsp_status_as_text (GstRTSPStatusCode code)
 GstRTSPHeaderField
 gst_rtsp_find_header_field (const gchar * header)
 {
-  gint idx;
+  static GHashTable *headers;
 
-  for (idx = 0; rtsp_headers[idx].name; idx++) {
-    if (g_ascii_strcasecmp (rtsp_headers[idx].name, header) == 0) {
-      return idx + 1;
-    }
-  }
-  return GST_RTSP_HDR_INVALID;
+  if (g_once_init_enter (&headers))
+    g_once_init_leave (&headers, rtsp_init_headers ());
+
+  return GPOINTER_TO_INT (g_hash_table_lookup (headers, header));
 }
 
 /**
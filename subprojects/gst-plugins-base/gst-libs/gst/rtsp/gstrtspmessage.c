@@ -931,7 +931,10 @@ gst_rtsp_message_append_headers (const GstRTSPMessage * msg, GString * str)
     else
       keystr = gst_rtsp_header_as_text (key_value->field);
 
-    g_string_append_printf (str, "%s: %s\r\n", keystr, key_value->value);
+    g_string_append (str, keystr);
+    g_string_append_len (str, ": ", 2);
+    g_string_append (str, key_value->value);
+    g_string_append_len (str, "\r\n", 2);
   }
   return GST_RTSP_OK;
 }
@@ -2989,23 +2989,26 @@ read_string (gchar * dest, guint size, gchar ** src)
     dest[idx] = '\0';
 }
 
-static void
-read_string_del (gchar * dest, guint size, gchar del, gchar ** src)
+/* reads up to @del and terminates the string in place instead of copying it,
+ * @src is left after the delimiter */
+static gchar *
+split_string_del (gchar del, gchar ** src)
 {
-  guint idx;
+  gchar *start, *end;
 
-  idx = 0;
   /* skip spaces */
   while (g_ascii_isspace (**src))
     (*src)++;
 
-  while (**src != del && **src != '\0') {
-    if (idx < size - 1)
-      dest[idx++] = **src;
-    (*src)++;
+  start = *src;
+  if ((end = strchr (start, del))) {
+    *end = '\0';
+    *src = end + 1;
+  } else {
+    *src = start + strlen (start);
   }
-  if (size > 0)
-    dest[idx] = '\0';
+
+  return start;
 }
 
 enum
@@ -3095,38 +3098,41 @@ gst_sdp_parse_line (SDPContext * c, gchar type, gchar * buffer)
     }
     case 'b':
     {
-      gchar str2[32];
+      gchar *bwtype;
 
-      read_string_del (str, sizeof (str), ':', &p);
-      if (*p != '\0')
-        p++;
-      read_string (str2, sizeof (str2), &p);
+      bwtype = split_string_del (':', &p);
+      read_string (str, sizeof (str), &p);
       if (c->state == SDP_SESSION)
-        gst_sdp_message_add_bandwidth (c->msg, str, atoi (str2));
+        gst_sdp_message_add_bandwidth (c->msg, bwtype, atoi (str));
       else
-        gst_sdp_media_add_bandwidth (c->media, str, atoi (str2));
+        gst_sdp_media_add_bandwidth (c->media, bwtype, atoi (str));
       break;
     }
     case 't':
       break;
     case 'k':
-      read_string_del (str, sizeof (str), ':', &p);
-      if (*p != '\0')
-        p++;
+    {
+      gchar *type;
+
+      type = split_string_del (':', &p);
       if (c->state == SDP_SESSION)
-        gst_sdp_message_set_key (c->msg, str, p);
+        gst_sdp_message_set_key (c->msg, type, p);
       else
-        gst_sdp_media_set_key (c->media, str, p);
+        gst_sdp_media_set_key (c->media, type, p);
       break;
+    }
     case 'a':
-      read_string_del (str, sizeof (str), ':', &p);
-      if (*p != '\0')
-        p++;
+    {
+      gchar *key;
+
+      /* most lines of a typical SDP are attributes, parse them in place */
+      key = split_string_del (':', &p);
       if (c->state == SDP_SESSION)
-        gst_sdp_message_add_attribute (c->msg, str, p);
+        gst_sdp_message_add_attribute (c->msg, key, p);
       else
-        gst_sdp_media_add_attribute (c->media, str, p);
+        gst_sdp_media_add_attribute (c->media, key, p);
       break;
+    }
     case 'm':
     {
       gchar *slash;
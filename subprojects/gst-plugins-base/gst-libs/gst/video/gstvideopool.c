@@ -37,7 +37,8 @@ GST_DEBUG_CATEGORY_STATIC (gst_video_pool_debug);
  *
  * Allows configuration of video-specific requirements such as
  * stride alignments or pixel padding, and can also be configured
- * to automatically add #GstVideoMeta to the buffers.
+ * to automatically add #GstVideoMeta to the buffers or to allocate
+ * the frames in shareable memory.
  */
 
 /**
@@ -115,7 +116,8 @@ static const gchar **
 video_buffer_pool_get_options (GstBufferPool * pool)
 {
   static const gchar *options[] = { GST_BUFFER_POOL_OPTION_VIDEO_META,
-    GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT, NULL
+    GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT,
+    GST_BUFFER_POOL_OPTION_VIDEO_SHAREABLE_MEMORY, NULL
   };
   return options;
 }
@@ -149,6 +151,23 @@ video_buffer_pool_set_config (GstBufferPool * pool, GstStructure * config)
   if (!gst_buffer_pool_config_get_allocator (config, &allocator, &params))
     goto wrong_config;
 
+  /* an explicitly configured allocator takes precedence, as downstream
+   * might have proposed a shareable allocator of its own */
+  if (allocator == NULL && gst_buffer_pool_config_has_option (config,
+          GST_BUFFER_POOL_OPTION_VIDEO_SHAREABLE_MEMORY)) {
+    allocator = gst_allocator_find ("shm");
+    if (allocator) {
+      GST_DEBUG_OBJECT (pool, "using shareable memory allocator %"
+          GST_PTR_FORMAT, allocator);
+      gst_buffer_pool_config_set_allocator (config, allocator, &params);
+      /* the config keeps a ref */
+      gst_object_unref (allocator);
+    } else {
+      GST_WARNING_OBJECT (pool, "no shareable memory allocator registered, "
+          "using system memory");
+    }
+  }
+
   width = info.width;
   height = info.height;
 
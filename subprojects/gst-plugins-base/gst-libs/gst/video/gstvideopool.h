@@ -45,6 +45,22 @@ G_BEGIN_DECLS
  */
 #define GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT "GstBufferPoolOptionVideoAlignment"
 
+/**
+ * GST_BUFFER_POOL_OPTION_VIDEO_SHAREABLE_MEMORY:
+ *
+ * A bufferpool option to allocate the frames in memory that can be shared
+ * with other processes by passing a file descriptor. When no allocator is
+ * configured, the pool then uses the allocator registered as "shm" (see
+ * gst_shm_allocator_init_once()) instead of system memory.
+ *
+ * Sinks passing frames to other processes can propose a pool with this
+ * option in the ALLOCATION query, so that upstream elements produce frames
+ * directly in shareable memory instead of having them copied.
+ *
+ * Since: 1.28
+ */
+#define GST_BUFFER_POOL_OPTION_VIDEO_SHAREABLE_MEMORY "GstBufferPoolOptionVideoShareableMemory"
+
 /* setting a bufferpool config */
 
 GST_VIDEO_API
@@ -0,0 +1,194 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef VIDEO_SCALER_NEON_H
+#define VIDEO_SCALER_NEON_H
+
+/* NEON is part of the base aarch64 ISA, so unlike the AVX2 kernels these
+ * are built into video-scaler.c directly and used unconditionally. They
+ * compute the same results as the ORC kernels and the AVX2 versions. */
+
+#include <arm_neon.h>
+
+static inline guint8
+neon_scale_u8_lq (guint16 acc)
+{
+  gint16 v = (gint16) (guint16) (acc + 32);
+
+  v >>= 6;
+  return CLAMP (v, 0, 255);
+}
+
+static inline guint16
+neon_scale_u16 (guint32 acc)
+{
+  gint32 v = (gint32) (acc + 4095);
+
+  v >>= 12;
+  return CLAMP (v, 0, 65535);
+}
+
+static inline uint8x16_t
+neon_pack_u8_lq (uint16x8_t a0, uint16x8_t a1)
+{
+  const int16x8_t round = vdupq_n_s16 (32);
+  int16x8_t s0, s1;
+
+  s0 = vshrq_n_s16 (vaddq_s16 (vreinterpretq_s16_u16 (a0), round), 6);
+  s1 = vshrq_n_s16 (vaddq_s16 (vreinterpretq_s16_u16 (a1), round), 6);
+  return vcombine_u8 (vqmovun_s16 (s0), vqmovun_s16 (s1));
+}
+
+static inline uint16x8_t
+neon_pack_u16 (int32x4_t a0, int32x4_t a1)
+{
+  const int32x4_t round = vdupq_n_s32 (4095);
+
+  a0 = vshrq_n_s32 (vaddq_s32 (a0, round), 12);
+  a1 = vshrq_n_s32 (vaddq_s32 (a1, round), 12);
+  return vcombine_u16 (vqmovun_s32 (a0), vqmovun_s32 (a1));
+}
+
+static void
+video_scaler_h_ntap_u8_lq_neon (gpointer dest, gconstpointer src,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  guint8 *d = dest;
+  const guint8 *pixels = src;
+  gint i, j;
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    uint16x8_t a0 = vdupq_n_u16 (0);
+    uint16x8_t a1 = vdupq_n_u16 (0);
+
+    for (j = 0; j < n_taps; j++) {
+      uint8x16_t p = vld1q_u8 (pixels + j * count + i);
+      const gint16 *t = taps + j * count + i;
+
+      a0 = vmlaq_u16 (a0, vmovl_u8 (vget_low_u8 (p)),
+          vreinterpretq_u16_s16 (vld1q_s16 (t)));
+      a1 = vmlaq_u16 (a1, vmovl_u8 (vget_high_u8 (p)),
+          vreinterpretq_u16_s16 (vld1q_s16 (t + 8)));
+    }
+    vst1q_u8 (d + i, neon_pack_u8_lq (a0, a1));
+  }
+  for (; i < count; i++) {
+    guint16 acc = 0;
+
+    for (j = 0; j < n_taps; j++)
+      acc += (guint16) (pixels[j * count + i] * taps[j * count + i]);
+    d[i] = neon_scale_u8_lq (acc);
+  }
+}
+
+static void
+video_scaler_h_ntap_u16_neon (gpointer dest, gconstpointer src,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  guint16 *d = dest;
+  const guint16 *pixels = src;
+  gint i, j;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    int32x4_t a0 = vdupq_n_s32 (0);
+    int32x4_t a1 = vdupq_n_s32 (0);
+
+    for (j = 0; j < n_taps; j++) {
+      uint16x8_t p = vld1q_u16 (pixels + j * count + i);
+      int16x8_t t = vld1q_s16 (taps + j * count + i);
+
+      a0 = vmlaq_s32 (a0,
+          vreinterpretq_s32_u32 (vmovl_u16 (vget_low_u16 (p))),
+          vmovl_s16 (vget_low_s16 (t)));
+      a1 = vmlaq_s32 (a1,
+          vreinterpretq_s32_u32 (vmovl_u16 (vget_high_u16 (p))),
+          vmovl_s16 (vget_high_s16 (t)));
+    }
+    vst1q_u16 (d + i, neon_pack_u16 (a0, a1));
+  }
+  for (; i < count; i++) {
+    guint32 acc = 0;
+
+    for (j = 0; j < n_taps; j++)
+      acc += (guint32) ((gint32) pixels[j * count + i] * taps[j * count + i]);
+    d[i] = neon_scale_u16 (acc);
+  }
+}
+
+static void
+video_scaler_v_ntap_u8_lq_neon (gpointer dest, gpointer srcs[], gint src_inc,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  guint8 *d = dest;
+  gint i, j;
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    uint16x8_t a0 = vdupq_n_u16 (0);
+    uint16x8_t a1 = vdupq_n_u16 (0);
+
+    for (j = 0; j < n_taps; j++) {
+      uint8x16_t p = vld1q_u8 ((const guint8 *) srcs[j * src_inc] + i);
+      uint16x8_t t = vdupq_n_u16 ((guint16) taps[j]);
+
+      a0 = vmlaq_u16 (a0, vmovl_u8 (vget_low_u8 (p)), t);
+      a1 = vmlaq_u16 (a1, vmovl_u8 (vget_high_u8 (p)), t);
+    }
+    vst1q_u8 (d + i, neon_pack_u8_lq (a0, a1));
+  }
+  for (; i < count; i++) {
+    guint16 acc = 0;
+
+    for (j = 0; j < n_taps; j++)
+      acc += (guint16) (((const guint8 *) srcs[j * src_inc])[i] * taps[j]);
+    d[i] = neon_scale_u8_lq (acc);
+  }
+}
+
+static void
+video_scaler_v_ntap_u16_neon (gpointer dest, gpointer srcs[], gint src_inc,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  guint16 *d = dest;
+  gint i, j;
+
+  for (i = 0; i + 8 <= count; i += 8) {
+    int32x4_t a0 = vdupq_n_s32 (0);
+    int32x4_t a1 = vdupq_n_s32 (0);
+
+    for (j = 0; j < n_taps; j++) {
+      uint16x8_t p = vld1q_u16 ((const guint16 *) srcs[j * src_inc] + i);
+      int32x4_t t = vdupq_n_s32 (taps[j]);
+
+      a0 = vmlaq_s32 (a0,
+          vreinterpretq_s32_u32 (vmovl_u16 (vget_low_u16 (p))), t);
+      a1 = vmlaq_s32 (a1,
+          vreinterpretq_s32_u32 (vmovl_u16 (vget_high_u16 (p))), t);
+    }
+    vst1q_u16 (d + i, neon_pack_u16 (a0, a1));
+  }
+  for (; i < count; i++) {
+    guint32 acc = 0;
+
+    for (j = 0; j < n_taps; j++)
+      acc += (guint32) ((gint32) ((const guint16 *) srcs[j * src_inc])[i] *
+          taps[j]);
+    d[i] = neon_scale_u16 (acc);
+  }
+}
+
+#endif /* VIDEO_SCALER_NEON_H */
@@ -0,0 +1,204 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "video-scaler-x86-avx2.h"
+
+#if defined (HAVE_IMMINTRIN_H) && defined (__AVX2__)
+#include <immintrin.h>
+
+static inline guint8
+scale_u8_lq (guint16 acc)
+{
+  gint16 v = (gint16) (guint16) (acc + 32);
+
+  v >>= 6;
+  return CLAMP (v, 0, 255);
+}
+
+static inline guint16
+scale_u16 (guint32 acc)
+{
+  gint32 v = (gint32) (acc + 4095);
+
+  v >>= 12;
+  return CLAMP (v, 0, 65535);
+}
+
+static inline __m256i
+pack_u8_lq (__m256i a, __m256i b)
+{
+  const __m256i round = _mm256_set1_epi16 (32);
+
+  a = _mm256_srai_epi16 (_mm256_add_epi16 (a, round), 6);
+  b = _mm256_srai_epi16 (_mm256_add_epi16 (b, round), 6);
+  /* packus works per 128 bit lane, put the quadwords back in order */
+  return _mm256_permute4x64_epi64 (_mm256_packus_epi16 (a, b), 0xd8);
+}
+
+static inline __m256i
+pack_u16 (__m256i a, __m256i b)
+{
+  const __m256i round = _mm256_set1_epi32 (4095);
+
+  a = _mm256_srai_epi32 (_mm256_add_epi32 (a, round), 12);
+  b = _mm256_srai_epi32 (_mm256_add_epi32 (b, round), 12);
+  return _mm256_permute4x64_epi64 (_mm256_packus_epi32 (a, b), 0xd8);
+}
+
+void
+video_scaler_h_ntap_u8_lq_avx2 (gpointer dest, gconstpointer src,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  guint8 *d = dest;
+  const guint8 *pixels = src;
+  gint i, j;
+
+  for (i = 0; i + 32 <= count; i += 32) {
+    __m256i a0 = _mm256_setzero_si256 ();
+    __m256i a1 = _mm256_setzero_si256 ();
+
+    for (j = 0; j < n_taps; j++) {
+      const guint8 *p = pixels + j * count + i;
+      const gint16 *t = taps + j * count + i;
+      __m256i p0, p1;
+
+      p0 = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *) p));
+      p1 = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *) (p +
+                  16)));
+      a0 = _mm256_add_epi16 (a0, _mm256_mullo_epi16 (p0,
+              _mm256_loadu_si256 ((const __m256i *) t)));
+      a1 = _mm256_add_epi16 (a1, _mm256_mullo_epi16 (p1,
+              _mm256_loadu_si256 ((const __m256i *) (t + 16))));
+    }
+    _mm256_storeu_si256 ((__m256i *) (d + i), pack_u8_lq (a0, a1));
+  }
+  for (; i < count; i++) {
+    guint16 acc = 0;
+
+    for (j = 0; j < n_taps; j++)
+      acc += (guint16) (pixels[j * count + i] * taps[j * count + i]);
+    d[i] = scale_u8_lq (acc);
+  }
+}
+
+void
+video_scaler_h_ntap_u16_avx2 (gpointer dest, gconstpointer src,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  guint16 *d = dest;
+  const guint16 *pixels = src;
+  gint i, j;
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    __m256i a0 = _mm256_setzero_si256 ();
+    __m256i a1 = _mm256_setzero_si256 ();
+
+    for (j = 0; j < n_taps; j++) {
+      const guint16 *p = pixels + j * count + i;
+      const gint16 *t = taps + j * count + i;
+      __m256i p0, p1, t0, t1;
+
+      p0 = _mm256_cvtepu16_epi32 (_mm_loadu_si128 ((const __m128i *) p));
+      p1 = _mm256_cvtepu16_epi32 (_mm_loadu_si128 ((const __m128i *) (p + 8)));
+      t0 = _mm256_cvtepi16_epi32 (_mm_loadu_si128 ((const __m128i *) t));
+      t1 = _mm256_cvtepi16_epi32 (_mm_loadu_si128 ((const __m128i *) (t + 8)));
+      a0 = _mm256_add_epi32 (a0, _mm256_mullo_epi32 (p0, t0));
+      a1 = _mm256_add_epi32 (a1, _mm256_mullo_epi32 (p1, t1));
+    }
+    _mm256_storeu_si256 ((__m256i *) (d + i), pack_u16 (a0, a1));
+  }
+  for (; i < count; i++) {
+    guint32 acc = 0;
+
+    for (j = 0; j < n_taps; j++)
+      acc += (guint32) ((gint32) pixels[j * count + i] * taps[j * count + i]);
+    d[i] = scale_u16 (acc);
+  }
+}
+
+void
+video_scaler_v_ntap_u8_lq_avx2 (gpointer dest, gpointer srcs[], gint src_inc,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  guint8 *d = dest;
+  gint i, j;
+
+  for (i = 0; i + 32 <= count; i += 32) {
+    __m256i a0 = _mm256_setzero_si256 ();
+    __m256i a1 = _mm256_setzero_si256 ();
+
+    for (j = 0; j < n_taps; j++) {
+      const guint8 *p = (const guint8 *) srcs[j * src_inc] + i;
+      __m256i t = _mm256_set1_epi16 (taps[j]);
+      __m256i p0, p1;
+
+      p0 = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *) p));
+      p1 = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *) (p +
+                  16)));
+      a0 = _mm256_add_epi16 (a0, _mm256_mullo_epi16 (p0, t));
+      a1 = _mm256_add_epi16 (a1, _mm256_mullo_epi16 (p1, t));
+    }
+    _mm256_storeu_si256 ((__m256i *) (d + i), pack_u8_lq (a0, a1));
+  }
+  for (; i < count; i++) {
+    guint16 acc = 0;
+
+    for (j = 0; j < n_taps; j++)
+      acc += (guint16) (((const guint8 *) srcs[j * src_inc])[i] * taps[j]);
+    d[i] = scale_u8_lq (acc);
+  }
+}
+
+void
+video_scaler_v_ntap_u16_avx2 (gpointer dest, gpointer srcs[], gint src_inc,
+    const gint16 * taps, gint n_taps, gint count)
+{
+  guint16 *d = dest;
+  gint i, j;
+
+  for (i = 0; i + 16 <= count; i += 16) {
+    __m256i a0 = _mm256_setzero_si256 ();
+    __m256i a1 = _mm256_setzero_si256 ();
+
+    for (j = 0; j < n_taps; j++) {
+      const guint16 *p = (const guint16 *) srcs[j * src_inc] + i;
+      __m256i t = _mm256_set1_epi32 (taps[j]);
+      __m256i p0, p1;
+
+      p0 = _mm256_cvtepu16_epi32 (_mm_loadu_si128 ((const __m128i *) p));
+      p1 = _mm256_cvtepu16_epi32 (_mm_loadu_si128 ((const __m128i *) (p + 8)));
+      a0 = _mm256_add_epi32 (a0, _mm256_mullo_epi32 (p0, t));
+      a1 = _mm256_add_epi32 (a1, _mm256_mullo_epi32 (p1, t));
+    }
+    _mm256_storeu_si256 ((__m256i *) (d + i), pack_u16 (a0, a1));
+  }
+  for (; i < count; i++) {
+    guint32 acc = 0;
+
+    for (j = 0; j < n_taps; j++)
+      acc += (guint32) ((gint32) ((const guint16 *) srcs[j * src_inc])[i] *
+          taps[j]);
+    d[i] = scale_u16 (acc);
+  }
+}
+
+#endif
@@ -44,6 +44,14 @@
 #include "video-orc.h"
 #include "video-scaler.h"
 
+#ifdef HAVE_AVX2
+#include "video-scaler-x86-avx2.h"
+#endif
+#if defined (__aarch64__) && defined (__ARM_NEON)
+#define HAVE_SCALER_NEON
+#include "video-scaler-neon.h"
+#endif
+
 #ifndef GST_DISABLE_GST_DEBUG
 #define GST_CAT_DEFAULT ensure_debug_category()
 static GstDebugCategory *
@@ -76,6 +84,42 @@ ensure_debug_category (void)
 
 #define LQ
 
+typedef void (*GstVideoScalerHTapsFunc) (gpointer d, gconstpointer pixels,
+    const gint16 * taps, gint n_taps, gint count);
+typedef void (*GstVideoScalerVTapsFunc) (gpointer d, gpointer srcs[],
+    gint src_inc, const gint16 * taps, gint n_taps, gint count);
+
+/* SIMD versions of the n-tap kernels, NULL when ORC is used */
+static GstVideoScalerHTapsFunc h_ntap_u8_lq_simd;
+static GstVideoScalerHTapsFunc h_ntap_u16_simd;
+static GstVideoScalerVTapsFunc v_ntap_u8_lq_simd;
+static GstVideoScalerVTapsFunc v_ntap_u16_simd;
+
+static void
+scaler_init_simd (void)
+{
+  static gsize init_gonce = 0;
+
+  if (g_once_init_enter (&init_gonce)) {
+#if defined (HAVE_AVX2)
+    if (__builtin_cpu_supports ("avx2")) {
+      GST_DEBUG ("enable AVX2 optimisations");
+      h_ntap_u8_lq_simd = video_scaler_h_ntap_u8_lq_avx2;
+      h_ntap_u16_simd = video_scaler_h_ntap_u16_avx2;
+      v_ntap_u8_lq_simd = video_scaler_v_ntap_u8_lq_avx2;
+      v_ntap_u16_simd = video_scaler_v_ntap_u16_avx2;
+    }
+#elif defined (HAVE_SCALER_NEON)
+    GST_DEBUG ("enable NEON optimisations");
+    h_ntap_u8_lq_simd = video_scaler_h_ntap_u8_lq_neon;
+    h_ntap_u16_simd = video_scaler_h_ntap_u16_neon;
+    v_ntap_u8_lq_simd = video_scaler_v_ntap_u8_lq_neon;
+    v_ntap_u16_simd = video_scaler_v_ntap_u16_neon;
+#endif
+    g_once_init_leave (&init_gonce, 1);
+  }
+}
+
 typedef void (*GstVideoScalerHFunc) (GstVideoScaler * scale,
     gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems);
 typedef void (*GstVideoScalerVFunc) (GstVideoScaler * scale,
@@ -192,6 +236,165 @@ scaler_dump (GstVideoScaler * scale)
 
 #define INTERLACE_SHIFT 0.5
 
+/* Computing the taps for the windowed methods is expensive and the same
+ * configurations are requested over and over again: the converter makes one
+ * scaler per thread and elements rebuild their converters on every caps
+ * change. Keep the most recently used resamplers around and hand out copies
+ * of them. */
+#define SCALER_CACHE_SIZE 16
+
+typedef struct
+{
+  GstVideoResamplerMethod method;
+  GstVideoScalerFlags flags;
+  guint n_taps;
+  guint in_size;
+  guint out_size;
+  /* only the GstVideoResampler options, NULL when there are none */
+  GstStructure *options;
+
+  GstVideoResampler resampler;
+} ScalerCacheEntry;
+
+static const gchar *resampler_options[] = {
+  GST_VIDEO_RESAMPLER_OPT_CUBIC_B,
+  GST_VIDEO_RESAMPLER_OPT_CUBIC_C,
+  GST_VIDEO_RESAMPLER_OPT_ENVELOPE,
+  GST_VIDEO_RESAMPLER_OPT_SHARPNESS,
+  GST_VIDEO_RESAMPLER_OPT_SHARPEN,
+  GST_VIDEO_RESAMPLER_OPT_MAX_TAPS,
+};
+
+static GMutex scaler_cache_lock;
+/* most recently used entry first, at most SCALER_CACHE_SIZE entries are kept
+ * for the lifetime of the process */
+static GQueue scaler_cache = G_QUEUE_INIT;
+
+static GstStructure *
+scaler_cache_options (GstStructure * options)
+{
+  GstStructure *res = NULL;
+  guint i;
+
+  if (options == NULL)
+    return NULL;
+
+  for (i = 0; i < G_N_ELEMENTS (resampler_options); i++) {
+    const GValue *v = gst_structure_get_value (options, resampler_options[i]);
+
+    if (v == NULL)
+      continue;
+
+    if (res == NULL)
+      res = gst_structure_new_empty ("GstVideoScaler.options");
+    gst_structure_set_value (res, resampler_options[i], v);
+  }
+  return res;
+}
+
+static void
+resampler_copy (GstVideoResampler * dest, const GstVideoResampler * src)
+{
+  dest->in_size = src->in_size;
+  dest->out_size = src->out_size;
+  dest->max_taps = src->max_taps;
+  dest->n_phases = src->n_phases;
+  dest->offset = g_memdup2 (src->offset, sizeof (guint32) * src->out_size);
+  dest->phase = g_memdup2 (src->phase, sizeof (guint32) * src->out_size);
+  dest->n_taps = g_memdup2 (src->n_taps, sizeof (guint32) * src->out_size);
+  dest->taps = g_memdup2 (src->taps,
+      sizeof (gdouble) * src->max_taps * src->n_phases);
+}
+
+static void
+scaler_cache_entry_free (ScalerCacheEntry * entry)
+{
+  if (entry->options)
+    gst_structure_free (entry->options);
+  gst_video_resampler_clear (&entry->resampler);
+  g_free (entry);
+}
+
+/* call with scaler_cache_lock, moves the matching entry to the front */
+static ScalerCacheEntry *
+scaler_cache_find_locked (GstVideoResamplerMethod method,
+    GstVideoScalerFlags flags, guint n_taps, guint in_size, guint out_size,
+    GstStructure * options)
+{
+  GList *l;
+
+  for (l = scaler_cache.head; l; l = l->next) {
+    ScalerCacheEntry *entry = l->data;
+
+    if (entry->method != method || entry->flags != flags ||
+        entry->n_taps != n_taps || entry->in_size != in_size ||
+        entry->out_size != out_size)
+      continue;
+
+    if (entry->options == NULL || options == NULL) {
+      if (entry->options != options)
+        continue;
+    } else if (!gst_structure_is_equal (entry->options, options)) {
+      continue;
+    }
+
+    if (l != scaler_cache.head) {
+      g_queue_unlink (&scaler_cache, l);
+      g_queue_push_head_link (&scaler_cache, l);
+    }
+    return entry;
+  }
+
+  return NULL;
+}
+
+static gboolean
+scaler_cache_lookup (GstVideoResamplerMethod method,
+    GstVideoScalerFlags flags, guint n_taps, guint in_size, guint out_size,
+    GstStructure * options, GstVideoResampler * resampler)
+{
+  ScalerCacheEntry *entry;
+
+  g_mutex_lock (&scaler_cache_lock);
+  entry = scaler_cache_find_locked (method, flags, n_taps, in_size, out_size,
+      options);
+  if (entry)
+    resampler_copy (resampler, &entry->resampler);
+  g_mutex_unlock (&scaler_cache_lock);
+
+  return entry != NULL;
+}
+
+static void
+scaler_cache_insert (GstVideoResamplerMethod method,
+    GstVideoScalerFlags flags, guint n_taps, guint in_size, guint out_size,
+    GstStructure * options, const GstVideoResampler * resampler)
+{
+  ScalerCacheEntry *entry;
+
+  g_mutex_lock (&scaler_cache_lock);
+  /* another thread may have computed the same taps in the meantime */
+  if (scaler_cache_find_locked (method, flags, n_taps, in_size, out_size,
+          options)) {
+    g_mutex_unlock (&scaler_cache_lock);
+    return;
+  }
+
+  entry = g_new0 (ScalerCacheEntry, 1);
+  entry->method = method;
+  entry->flags = flags;
+  entry->n_taps = n_taps;
+  entry->in_size = in_size;
+  entry->out_size = out_size;
+  entry->options = options ? gst_structure_copy (options) : NULL;
+  resampler_copy (&entry->resampler, resampler);
+
+  g_queue_push_head (&scaler_cache, entry);
+  while (scaler_cache.length > SCALER_CACHE_SIZE)
+    scaler_cache_entry_free (g_queue_pop_tail (&scaler_cache));
+  g_mutex_unlock (&scaler_cache_lock);
+}
+
 /**
  * gst_video_scaler_new: (skip)
  * @method: a #GstVideoResamplerMethod
@@ -215,10 +418,14 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
     guint n_taps, guint in_size, guint out_size, GstStructure * options)
 {
   GstVideoScaler *scale;
+  GstStructure *cache_options;
+  guint cache_n_taps = n_taps;
 
   g_return_val_if_fail (in_size != 0, NULL);
   g_return_val_if_fail (out_size != 0, NULL);
 
+  scaler_init_simd ();
+
   scale = g_new0 (GstVideoScaler, 1);
 
   GST_DEBUG ("%d %u  %u->%u", method, n_taps, in_size, out_size);
@@ -226,7 +433,12 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
   scale->method = method;
   scale->flags = flags;
 
-  if (flags & GST_VIDEO_SCALER_FLAG_INTERLACED) {
+  cache_options = scaler_cache_options (options);
+
+  if (scaler_cache_lookup (method, flags, cache_n_taps, in_size, out_size,
+          cache_options, &scale->resampler)) {
+    GST_DEBUG ("reusing cached taps");
+  } else if (flags & GST_VIDEO_SCALER_FLAG_INTERLACED) {
     GstVideoResampler tresamp, bresamp;
     gdouble shift;
 
@@ -245,12 +457,19 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
     resampler_zip (&scale->resampler, &tresamp, &bresamp);
     gst_video_resampler_clear (&tresamp);
     gst_video_resampler_clear (&bresamp);
+    scaler_cache_insert (method, flags, cache_n_taps, in_size, out_size,
+        cache_options, &scale->resampler);
   } else {
     gst_video_resampler_init (&scale->resampler, method,
         GST_VIDEO_RESAMPLER_FLAG_NONE, out_size, n_taps, 0.0, in_size, out_size,
         options);
+    scaler_cache_insert (method, flags, cache_n_taps, in_size, out_size,
+        cache_options, &scale->resampler);
   }
 
+  if (cache_options)
+    gst_structure_free (cache_options);
+
   if (out_size == 1)
     scale->inc = 0;
   else
@@ -698,7 +917,9 @@ video_scale_h_ntap_u8 (GstVideoScaler * scale,
   count = width * n_elems;
 
 #ifdef LQ
-  if (max_taps == 2) {
+  if (h_ntap_u8_lq_simd) {
+    h_ntap_u8_lq_simd (d, pixels, taps, max_taps, count);
+  } else if (max_taps == 2) {
     video_orc_resample_h_2tap_u8_lq (d, pixels, pixels + count, taps,
         taps + count, count);
   } else {
@@ -814,6 +1035,8 @@ video_scale_h_ntap_u16 (GstVideoScaler * scale,
   if (max_taps == 2) {
     video_orc_resample_h_2tap_u16 (d, pixels, pixels + count, taps,
         taps + count, count);
+  } else if (h_ntap_u16_simd) {
+    h_ntap_u16_simd (d, pixels, taps, max_taps, count);
   } else {
     /* first pixels with first tap to t4 */
     video_orc_resample_h_multaps_u16 (temp, pixels, taps, count);
@@ -975,6 +1198,10 @@ video_scale_v_4tap_u8 (GstVideoScaler * scale,
   p4 = taps[3];
 
 #ifdef LQ
+  if (v_ntap_u8_lq_simd) {
+    v_ntap_u8_lq_simd (d, srcs, src_inc, taps, 4, width * n_elems);
+    return;
+  }
   video_orc_resample_v_4tap_u8_lq (d, s1, s2, s3, s4, p1, p2, p3, p4,
       width * n_elems);
 #else
@@ -1014,6 +1241,11 @@ video_scale_v_ntap_u8 (GstVideoScaler * scale,
   count = width * n_elems;
 
 #ifdef LQ
+  if (v_ntap_u8_lq_simd) {
+    v_ntap_u8_lq_simd (d, srcs, src_inc, taps, max_taps, count);
+    return;
+  }
+
   if (max_taps >= 4) {
     video_orc_resample_v_multaps4_u8_lq (temp, srcs[0], srcs[1 * src_inc],
         srcs[2 * src_inc], srcs[3 * src_inc], taps[0], taps[1], taps[2],
@@ -1097,6 +1329,11 @@ video_scale_v_ntap_u16 (GstVideoScaler * scale,
   temp = (gint32 *) scale->tmpline2;
   count = width * n_elems;
 
+  if (v_ntap_u16_simd) {
+    v_ntap_u16_simd (d, srcs, src_inc, taps, max_taps, count);
+    return;
+  }
+
   video_orc_resample_v_multaps_u16 (temp, srcs[0], taps[0], count);
   for (i = 1; i < max_taps; i++) {
     video_orc_resample_v_muladdtaps_u16 (temp, srcs[i * src_inc], taps[i],
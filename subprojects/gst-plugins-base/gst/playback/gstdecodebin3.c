@@ -3638,8 +3638,8 @@ create_decoder_factory_list (GstDecodebin3 * dbin, GstCaps * caps)
 
   g_mutex_lock (&dbin->factories_lock);
   gst_decode_bin_update_factories_list (dbin);
-  res = gst_element_factory_list_filter (dbin->decoder_factories,
-      caps, GST_PAD_SINK, TRUE);
+  res = gst_playback_utils_filter_factories ("decodebin3-decoders",
+      dbin->decoder_factories, dbin->factories_cookie, caps, TRUE);
   g_mutex_unlock (&dbin->factories_lock);
   return res;
 }
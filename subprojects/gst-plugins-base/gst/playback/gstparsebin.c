@@ -1119,7 +1119,8 @@ gst_parse_bin_autoplug_factories (GstElement * element, GstPad * pad,
   g_mutex_lock (&parsebin->factories_lock);
   gst_parse_bin_update_factories_list (parsebin);
   list =
-      gst_element_factory_list_filter (parsebin->factories, caps, GST_PAD_SINK,
+      gst_playback_utils_filter_factories ("parsebin-decodables",
+      parsebin->factories, parsebin->factories_cookie, caps,
       gst_caps_is_fixed (caps));
   g_mutex_unlock (&parsebin->factories_lock);
 
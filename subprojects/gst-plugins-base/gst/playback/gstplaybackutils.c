@@ -165,6 +165,122 @@ gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2)
   return gst_plugin_feature_rank_compare_func (p1, p2);
 }
 
+/* Process-wide cache of gst_element_factory_list_filter() results. Every
+ * decodebin3 and parsebin instance filters the same factory lists against
+ * the caps of every new stream, and with hundreds of factories that is a
+ * significant part of setting up a pipeline. Since all instances use
+ * lists derived from the registry in the same way, results are shared
+ * between them and only invalidated when the registry changes. */
+#define FILTER_CACHE_MAX_ENTRIES 256
+
+static GMutex filter_cache_lock;
+static GHashTable *filter_cache = NULL;
+static guint32 filter_cache_cookie;
+
+static gboolean
+strip_buffer_field (const GstIdStr * fieldname, GValue * value,
+    gpointer user_data)
+{
+  GType type = G_VALUE_TYPE (value);
+
+  if (type == GST_TYPE_BUFFER)
+    return FALSE;
+
+  if (type == GST_TYPE_ARRAY && gst_value_array_get_size (value) > 0 &&
+      G_VALUE_TYPE (gst_value_array_get_value (value, 0)) == GST_TYPE_BUFFER)
+    return FALSE;
+
+  return TRUE;
+}
+
+/* Buffer fields such as codec_data or streamheader differ between streams
+ * but can't be matched by pad templates, so leave them out of the key */
+static gchar *
+filter_cache_key (const gchar * list_id, GstCaps * caps, gboolean subsetonly)
+{
+  GstCaps *stripped;
+  gchar *caps_str, *key;
+  guint i;
+
+  stripped = gst_caps_copy (caps);
+  for (i = 0; i < gst_caps_get_size (stripped); i++)
+    gst_structure_filter_and_map_in_place_id_str (gst_caps_get_structure
+        (stripped, i), strip_buffer_field, NULL);
+
+  caps_str = gst_caps_to_string (stripped);
+  key = g_strdup_printf ("%s:%d:%s", list_id, subsetonly, caps_str);
+  g_free (caps_str);
+  gst_caps_unref (stripped);
+
+  return key;
+}
+
+/* gst_playback_utils_filter_factories:
+ * @list_id: A name identifying @factories
+ * @factories: A list of #GstElementFactory
+ * @cookie: The registry feature list cookie @factories was created with
+ * @caps: The #GstCaps to filter for
+ * @subsetonly: whether to only keep factories accepting a superset of @caps
+ *
+ * Same as gst_element_factory_list_filter() with %GST_PAD_SINK, but
+ * reuses the result of earlier calls for the same @list_id and @caps.
+ * All callers passing the same @list_id must pass the same list contents
+ * for the same @cookie.
+ *
+ * Returns: (transfer full): the list of factories accepting @caps
+ */
+GList *
+gst_playback_utils_filter_factories (const gchar * list_id,
+    GList * factories, guint32 cookie, GstCaps * caps, gboolean subsetonly)
+{
+  GList *res, *cached;
+  gchar *key;
+
+  /* Non-fixed caps are rare here and would just pollute the cache */
+  if (!gst_caps_is_fixed (caps))
+    return gst_element_factory_list_filter (factories, caps, GST_PAD_SINK,
+        subsetonly);
+
+  key = filter_cache_key (list_id, caps, subsetonly);
+
+  g_mutex_lock (&filter_cache_lock);
+  if (!filter_cache) {
+    filter_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+        (GDestroyNotify) gst_plugin_feature_list_free);
+    filter_cache_cookie = cookie;
+  } else if (filter_cache_cookie != cookie) {
+    GST_DEBUG ("registry changed, dropping cached factory lists");
+    g_hash_table_remove_all (filter_cache);
+    filter_cache_cookie = cookie;
+  }
+
+  if (g_hash_table_lookup_extended (filter_cache, key, NULL,
+          (gpointer *) & cached)) {
+    res = gst_plugin_feature_list_copy (cached);
+    g_mutex_unlock (&filter_cache_lock);
+    g_free (key);
+    return res;
+  }
+  g_mutex_unlock (&filter_cache_lock);
+
+  res = gst_element_factory_list_filter (factories, caps, GST_PAD_SINK,
+      subsetonly);
+
+  g_mutex_lock (&filter_cache_lock);
+  /* Only store results for the registry state they were computed for */
+  if (filter_cache_cookie == cookie) {
+    if (g_hash_table_size (filter_cache) >= FILTER_CACHE_MAX_ENTRIES)
+      g_hash_table_remove_all (filter_cache);
+    g_hash_table_insert (filter_cache, key,
+        gst_plugin_feature_list_copy (res));
+    key = NULL;
+  }
+  g_mutex_unlock (&filter_cache_lock);
+  g_free (key);
+
+  return res;
+}
+
 /* gst_playback_utils_stream_in_list:
  * @streams: A list of #GstStream
  * @stream: A #GstStream
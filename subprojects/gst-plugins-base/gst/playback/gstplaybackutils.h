@@ -37,6 +37,13 @@ G_GNUC_INTERNAL
 gint gst_playback_utils_compare_factories_func(gconstpointer p1,
                                                gconstpointer p2);
 
+G_GNUC_INTERNAL
+GList *gst_playback_utils_filter_factories (const gchar * list_id,
+                                            GList * factories,
+                                            guint32 cookie,
+                                            GstCaps * caps,
+                                            gboolean subsetonly);
+
 G_GNUC_INTERNAL
 gboolean gst_playback_utils_stream_in_list(GList *streams, GstStream *stream);
 
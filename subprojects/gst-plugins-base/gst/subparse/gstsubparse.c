@@ -121,6 +121,8 @@ GST_ELEMENT_REGISTER_DEFINE_WITH_CODE (subparse, "subparse",
     subparse->textbuf = NULL;
   }
 
+  g_clear_pointer (&subparse->cues, g_array_unref);
+
   GST_CALL_PARENT (G_OBJECT_CLASS, dispose, (object));
 }
 
@@ -179,6 +181,7 @@ gst_sub_parse_init (GstSubParse * subparse)
   gst_element_add_pad (GST_ELEMENT (subparse), subparse->srcpad);
 
   subparse->textbuf = g_string_new (NULL);
+  subparse->cues = g_array_new (FALSE, FALSE, sizeof (GstSubParseCue));
   subparse->parser_type = GST_SUB_PARSE_FORMAT_UNKNOWN;
   subparse->strip_pango_markup = FALSE;
   subparse->flushing = FALSE;
@@ -246,6 +249,56 @@ gst_sub_parse_src_query (GstPad * pad, GstObject * parent, GstQuery * query)
   return ret;
 }
 
+/* returns the position of the first cue at or after @offset */
+static guint
+gst_sub_parse_find_cue (GstSubParse * self, guint64 offset)
+{
+  guint lo = 0, hi = self->cues->len;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (g_array_index (self->cues, GstSubParseCue, mid).offset < offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/* Where to start parsing for a seek to @start: the first cue that can
+ * still be shown at that time, as all cues before it end earlier. */
+static guint64
+gst_sub_parse_get_seek_offset (GstSubParse * self, gdouble rate,
+    GstSeekType start_type, gint64 start)
+{
+  guint64 offset = 0;
+  guint lo = 0, hi;
+
+  if (rate < 0.0 || start_type != GST_SEEK_TYPE_SET || start <= 0)
+    return 0;
+
+  GST_OBJECT_LOCK (self);
+  hi = self->cues->len;
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (g_array_index (self->cues, GstSubParseCue, mid).max_end <= start)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  /* past the cues we know, continue from the last one */
+  if (lo == self->cues->len && lo > 0)
+    lo--;
+  if (lo < self->cues->len)
+    offset = g_array_index (self->cues, GstSubParseCue, lo).offset;
+  GST_OBJECT_UNLOCK (self);
+
+  return offset;
+}
+
 static gboolean
 gst_sub_parse_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
 {
@@ -263,6 +316,7 @@ gst_sub_parse_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
       gint64 start, stop;
       gdouble rate;
       gboolean update;
+      guint64 offset;
 
       gst_event_parse_seek (event, &rate, &format, &flags,
           &start_type, &start, &stop_type, &stop);
@@ -278,11 +332,14 @@ gst_sub_parse_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
       if (ret)
         break;
 
-      /* Convert that seek to a seeking in bytes at position 0,
-         FIXME: could use an index */
+      /* Convert that seek to a seeking in bytes, to the first cue we know
+       * to be relevant or position 0 */
+      offset = gst_sub_parse_get_seek_offset (self, rate, start_type, start);
+      GST_DEBUG_OBJECT (self, "seeking to byte offset %" G_GUINT64_FORMAT,
+          offset);
       ret = gst_pad_push_event (self->sinkpad,
           gst_event_new_seek (rate, GST_FORMAT_BYTES, flags,
-              GST_SEEK_TYPE_SET, 0, GST_SEEK_TYPE_NONE, 0));
+              GST_SEEK_TYPE_SET, offset, GST_SEEK_TYPE_NONE, 0));
 
       if (ret) {
         /* Apply the seek to our segment */
@@ -296,7 +353,8 @@ gst_sub_parse_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
          * after FLUSH and all that has happened,
          * rather than racing with chain */
       } else {
-        GST_WARNING_OBJECT (self, "seek to 0 bytes failed");
+        GST_WARNING_OBJECT (self, "seek to %" G_GUINT64_FORMAT
+            " bytes failed", offset);
       }
 
       break;
@@ -472,31 +530,30 @@ convert_encoding (GstSubParse * self, const gchar * str, gsize len,
   return ret;
 }
 
-static gchar *
-get_next_line (GstSubParse * self)
+/* Returns the next line in textbuf, terminated in place. It stays valid
+ * until more input is fed. @offset is set to the byte offset of the line
+ * in the input, if known. */
+static const gchar *
+get_next_line (GstSubParse * self, guint64 * offset)
 {
-  char *line = NULL;
-  const char *line_end;
-  int line_len;
-  gboolean have_r = FALSE;
+  gchar *line = self->textbuf->str + self->textbuf_pos;
+  gchar *line_end;
 
-  line_end = strchr (self->textbuf->str, '\n');
+  line_end = memchr (line, '\n', self->textbuf->len - self->textbuf_pos);
 
   if (!line_end) {
     /* end-of-line not found; return for more data */
     return NULL;
   }
 
+  *offset = self->textbuf_offset + self->textbuf_pos;
+  self->textbuf_pos += line_end - line + 1;
+
   /* get rid of '\r' */
-  if (line_end != self->textbuf->str && *(line_end - 1) == '\r') {
+  if (line_end != line && *(line_end - 1) == '\r')
     line_end--;
-    have_r = TRUE;
-  }
+  *line_end = '\0';
 
-  line_len = line_end - self->textbuf->str;
-  line = g_strndup (self->textbuf->str, line_len);
-  self->textbuf = g_string_erase (self->textbuf, 0,
-      line_len + (have_r ? 2 : 1));
   return line;
 }
 
@@ -1417,12 +1474,12 @@ gst_sub_parse_format_autodetect (GstSubParse * self)
   gchar *data;
   GstSubParseFormat format;
 
-  if (strlen (self->textbuf->str) < 6) {
+  if (strlen (self->textbuf->str + self->textbuf_pos) < 6) {
     GST_DEBUG ("File too small to be a subtitles file");
     return NULL;
   }
 
-  data = g_strndup (self->textbuf->str, 35);
+  data = g_strndup (self->textbuf->str + self->textbuf_pos, 35);
   format = gst_sub_parse_data_format_autodetect (data);
   g_free (data);
 
@@ -1514,7 +1571,19 @@ feed_textbuf (GstSubParse * self, GstBuffer * buf)
     /* flush the parser state */
     parser_state_init (&self->state);
     g_string_truncate (self->textbuf, 0);
+    self->textbuf_pos = 0;
+    self->textbuf_offset = self->offset;
+    self->textbuf_offset_valid = TRUE;
     gst_adapter_clear (self->adapter);
+
+    /* new cues only extend the index if we continue from a known one */
+    GST_OBJECT_LOCK (self);
+    self->cues_contiguous = self->offset == 0 ||
+        (gst_sub_parse_find_cue (self, self->offset) < self->cues->len &&
+        g_array_index (self->cues, GstSubParseCue,
+            gst_sub_parse_find_cue (self, self->offset)).offset ==
+        self->offset);
+    GST_OBJECT_UNLOCK (self);
     if (self->parser_type == GST_SUB_PARSE_FORMAT_SAMI)
       sami_context_reset (&self->state);
     /* we could set a flag to make sure that the next buffer we push out also
@@ -1524,13 +1593,39 @@ feed_textbuf (GstSubParse * self, GstBuffer * buf)
 
   self->offset += gst_buffer_get_size (buf);
 
+  /* drop the lines that were parsed already */
+  if (self->textbuf_pos > 0) {
+    g_string_erase (self->textbuf, 0, self->textbuf_pos);
+    self->textbuf_offset += self->textbuf_pos;
+    self->textbuf_pos = 0;
+  }
+
   gst_adapter_push (self->adapter, buf);
 
   avail = gst_adapter_available (self->adapter);
   data = gst_adapter_map (self->adapter, avail);
+
+  /* UTF-8 input is appended as is. A character that is split over two
+   * buffers is kept for the next one. */
+  if (!self->detected_encoding && self->valid_utf8) {
+    const gchar *end;
+
+    if (g_utf8_validate ((const gchar *) data, avail, &end) ||
+        g_utf8_get_char_validated (end,
+            avail - (end - (const gchar *) data)) == (gunichar) - 2) {
+      consumed = end - (const gchar *) data;
+      g_string_append_len (self->textbuf, (const gchar *) data, consumed);
+      gst_adapter_unmap (self->adapter);
+      gst_adapter_flush (self->adapter, consumed);
+      return;
+    }
+  }
+
   input = convert_encoding (self, (const gchar *) data, avail, &consumed);
 
   if (input && consumed > 0) {
+    /* byte offsets in the input don't match the text anymore */
+    self->textbuf_offset_valid = FALSE;
     self->textbuf = g_string_append (self->textbuf, input);
     gst_adapter_unmap (self->adapter);
     gst_adapter_flush (self->adapter, consumed);
@@ -1676,11 +1771,46 @@ check_initial_events (GstSubParse * self)
   return GST_FLOW_OK;
 }
 
+/* remember where the cue whose timing line was just parsed starts */
+static void
+gst_sub_parse_add_cue (GstSubParse * self)
+{
+  GstSubParseCue cue;
+  GstClockTime end = self->state.start_time + self->state.duration;
+
+  if (!self->textbuf_offset_valid || !self->cues_contiguous)
+    return;
+
+  cue.offset = self->cue_offset;
+  cue.max_end = end;
+
+  GST_OBJECT_LOCK (self);
+  if (self->cues->len > 0) {
+    GstSubParseCue *last =
+        &g_array_index (self->cues, GstSubParseCue, self->cues->len - 1);
+
+    /* parsing this part again after a seek */
+    if (cue.offset <= last->offset) {
+      GST_OBJECT_UNLOCK (self);
+      return;
+    }
+    cue.max_end = MAX (last->max_end, end);
+  }
+  g_array_append_val (self->cues, cue);
+  GST_OBJECT_UNLOCK (self);
+
+  GST_LOG_OBJECT (self, "cue at offset %" G_GUINT64_FORMAT " ends at %"
+      GST_TIME_FORMAT, cue.offset, GST_TIME_ARGS (end));
+}
+
 static GstFlowReturn
 handle_buffer (GstSubParse * self, GstBuffer * buf)
 {
   GstFlowReturn ret = GST_FLOW_OK;
-  gchar *line, *subtitle;
+  const gchar *line;
+  gchar *subtitle;
+  guint64 line_offset;
+  gboolean index_cues;
 
   GST_DEBUG_OBJECT (self, "%" GST_PTR_FORMAT, buf);
 
@@ -1702,16 +1832,25 @@ handle_buffer (GstSubParse * self, GstBuffer * buf)
   if (ret != GST_FLOW_OK)
     return ret;
 
-  while (!self->flushing && (line = get_next_line (self))) {
-    guint offset = 0;
+  /* in these formats, state 2 is entered after the timing line of a cue */
+  index_cues = self->parser_type == GST_SUB_PARSE_FORMAT_SUBRIP ||
+      self->parser_type == GST_SUB_PARSE_FORMAT_VTT;
+
+  while (!self->flushing && (line = get_next_line (self, &line_offset))) {
+    gint prev_state = self->state.state;
+
+    if (index_cues && prev_state == 0)
+      self->cue_offset = line_offset;
 
     /* Set segment on our parser state machine */
     self->state.segment = &self->segment;
     /* Now parse the line, out of segment lines will just return NULL */
     GST_LOG_OBJECT (self, "State %d. Parsing line '%s'", self->state.state,
-        line + offset);
-    subtitle = self->parse_line (&self->state, line + offset);
-    g_free (line);
+        line);
+    subtitle = self->parse_line (&self->state, line);
+
+    if (index_cues && prev_state != 2 && self->state.state == 2)
+      gst_sub_parse_add_cue (self);
 
     if (subtitle) {
       guint subtitle_len;
@@ -1903,7 +2042,14 @@ gst_sub_parse_change_state (GstElement * element, GstStateChange transition)
       g_free (self->detected_encoding);
       self->detected_encoding = NULL;
       g_string_truncate (self->textbuf, 0);
+      self->textbuf_pos = 0;
+      self->textbuf_offset = 0;
+      self->textbuf_offset_valid = TRUE;
       gst_adapter_clear (self->adapter);
+      GST_OBJECT_LOCK (self);
+      g_array_set_size (self->cues, 0);
+      self->cues_contiguous = TRUE;
+      GST_OBJECT_UNLOCK (self);
       break;
     default:
       break;
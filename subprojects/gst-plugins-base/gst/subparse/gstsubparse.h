@@ -54,6 +54,11 @@ typedef struct {
 
 typedef gchar* (*Parser) (ParserState *state, const gchar *line);
 
+typedef struct {
+  guint64      offset;   /* byte offset of the first line of the cue */
+  GstClockTime max_end;  /* latest end time of this and all earlier cues */
+} GstSubParseCue;
+
 struct _GstSubParse {
   GstElement element;
 
@@ -63,6 +68,19 @@ struct _GstSubParse {
   GstAdapter *adapter;
   /* contains the UTF-8 decoded input */
   GString *textbuf;
+  /* start of the lines in textbuf that were not parsed yet */
+  gsize textbuf_pos;
+  /* byte offset of textbuf in the input, valid as long as the input
+   * needed no conversion */
+  guint64 textbuf_offset;
+  gboolean textbuf_offset_valid;
+
+  /* cues in input order, built up while parsing subrip and WebVTT to
+   * know where to start parsing after a seek. Protected by the object
+   * lock. */
+  GArray *cues;
+  gboolean cues_contiguous;
+  guint64 cue_offset;
 
   GstSubParseFormat parser_type;
   gboolean parser_detected;
@@ -426,6 +426,31 @@ gst_volume_init (GstVolume * self)
   gst_base_transform_set_gap_aware (GST_BASE_TRANSFORM (self), TRUE);
 }
 
+/* Repeats the volume of each frame for all of its channels, so that the
+ * controlled volume of any number of channels can be applied by the
+ * vectorized mono kernels instead of a per sample loop */
+static gdouble *
+volume_expand_volumes (GstVolume * self, const gdouble * volume,
+    guint channels, guint num_samples)
+{
+  guint i, j, n = num_samples * channels;
+  gdouble *out;
+
+  if (self->expanded_volumes_count < n) {
+    self->expanded_volumes =
+        g_realloc (self->expanded_volumes, sizeof (gdouble) * n);
+    self->expanded_volumes_count = n;
+  }
+
+  out = self->expanded_volumes;
+  for (i = 0; i < num_samples; i++) {
+    for (j = 0; j < channels; j++)
+      *out++ = volume[i];
+  }
+
+  return self->expanded_volumes;
+}
+
 static void
 volume_process_double (GstVolume * self, gpointer bytes, guint n_bytes)
 {
@@ -441,19 +466,10 @@ volume_process_controlled_double (GstVolume * self, gpointer bytes,
 {
   gdouble *data = (gdouble *) bytes;
   guint num_samples = n_bytes / (sizeof (gdouble) * channels);
-  guint i, j;
-  gdouble vol;
 
-  if (channels == 1) {
-    volume_orc_process_controlled_f64_1ch (data, volume, num_samples);
-  } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        *data++ *= vol;
-      }
-    }
-  }
+  if (channels > 1)
+    volume = volume_expand_volumes (self, volume, channels, num_samples);
+  volume_orc_process_controlled_f64_1ch (data, volume, num_samples * channels);
 }
 
 static void
@@ -471,20 +487,14 @@ volume_process_controlled_float (GstVolume * self, gpointer bytes,
 {
   gfloat *data = (gfloat *) bytes;
   guint num_samples = n_bytes / (sizeof (gfloat) * channels);
-  guint i, j;
-  gdouble vol;
 
-  if (channels == 1) {
-    volume_orc_process_controlled_f32_1ch (data, volume, num_samples);
-  } else if (channels == 2) {
+  if (channels == 2) {
     volume_orc_process_controlled_f32_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        *data++ *= vol;
-      }
-    }
+    if (channels > 1)
+      volume = volume_expand_volumes (self, volume, channels, num_samples);
+    volume_orc_process_controlled_f32_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -536,21 +546,12 @@ volume_process_controlled_int32_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint32 *data = (gint32 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint32) * channels);
-  gdouble vol, val;
 
-  if (channels == 1) {
-    volume_orc_process_controlled_int32_1ch (data, volume, num_samples);
-  } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint32) CLAMP (val, VOLUME_MIN_INT32, VOLUME_MAX_INT32);
-      }
-    }
-  }
+  if (channels > 1)
+    volume = volume_expand_volumes (self, volume, channels, num_samples);
+  volume_orc_process_controlled_int32_1ch (data, volume,
+      num_samples * channels);
 }
 
 #if (G_BYTE_ORDER == G_LITTLE_ENDIAN)
@@ -713,22 +714,15 @@ volume_process_controlled_int16_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint16 *data = (gint16 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint16) * channels);
-  gdouble vol, val;
 
-  if (channels == 1) {
-    volume_orc_process_controlled_int16_1ch (data, volume, num_samples);
-  } else if (channels == 2) {
+  if (channels == 2) {
     volume_orc_process_controlled_int16_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint16) CLAMP (val, VOLUME_MIN_INT16, VOLUME_MAX_INT16);
-      }
-    }
+    if (channels > 1)
+      volume = volume_expand_volumes (self, volume, channels, num_samples);
+    volume_orc_process_controlled_int16_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -779,22 +773,15 @@ volume_process_controlled_int8_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint8 *data = (gint8 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint8) * channels);
-  gdouble val, vol;
 
-  if (channels == 1) {
-    volume_orc_process_controlled_int8_1ch (data, volume, num_samples);
-  } else if (channels == 2) {
+  if (channels == 2) {
     volume_orc_process_controlled_int8_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint8) CLAMP (val, VOLUME_MIN_INT8, VOLUME_MAX_INT8);
-      }
-    }
+    if (channels > 1)
+      volume = volume_expand_volumes (self, volume, channels, num_samples);
+    volume_orc_process_controlled_int8_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -833,6 +820,10 @@ volume_stop (GstBaseTransform * base)
   self->volumes = NULL;
   self->volumes_count = 0;
 
+  g_free (self->expanded_volumes);
+  self->expanded_volumes = NULL;
+  self->expanded_volumes_count = 0;
+
   g_free (self->mutes);
   self->mutes = NULL;
   self->mutes_count = 0;
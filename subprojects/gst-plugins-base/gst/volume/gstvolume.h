@@ -64,6 +64,9 @@ struct _GstVolume {
   guint mutes_count;
   gdouble *volumes;
   guint volumes_count;
+  /* volumes repeated for every channel */
+  gdouble *expanded_volumes;
+  guint expanded_volumes_count;
 };
 
 GST_ELEMENT_REGISTER_DECLARE (volume);
@@ -1242,6 +1242,129 @@ GST_START_TEST (test_buffering_limits)
 
 GST_END_TEST;
 
+GST_START_TEST (test_pull_batch)
+{
+  GstElement *sink;
+  GstSample *s;
+  GstBufferList *list;
+  GstCaps *caps;
+  GstBuffer *buffer;
+  gint i;
+
+  sink = setup_appsink ();
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  for (i = 0; i < 5; i++) {
+    buffer = gst_buffer_new_and_alloc (4);
+    GST_BUFFER_OFFSET (buffer) = i;
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  /* limited by max_buffers */
+  s = gst_app_sink_try_pull_batch (GST_APP_SINK (sink), 3, 0);
+  fail_unless (s != NULL);
+  fail_unless (gst_sample_get_buffer (s) == NULL);
+  list = gst_sample_get_buffer_list (s);
+  fail_unless_equals_int (gst_buffer_list_length (list), 3);
+  for (i = 0; i < 3; i++)
+    fail_unless_equals_int (GST_BUFFER_OFFSET (gst_buffer_list_get (list, i)),
+        i);
+  gst_sample_unref (s);
+
+  /* everything that is left */
+  s = gst_app_sink_try_pull_batch (GST_APP_SINK (sink), 16, 0);
+  fail_unless (s != NULL);
+  list = gst_sample_get_buffer_list (s);
+  fail_unless_equals_int (gst_buffer_list_length (list), 2);
+  fail_unless_equals_int (GST_BUFFER_OFFSET (gst_buffer_list_get (list, 0)),
+      3);
+  gst_sample_unref (s);
+
+  s = gst_app_sink_try_pull_batch (GST_APP_SINK (sink), 16, 0);
+  fail_unless (s == NULL);
+
+  /* a caps change ends the batch */
+  fail_unless (gst_pad_push (mysrcpad, gst_buffer_new ()) == GST_FLOW_OK);
+  caps = gst_caps_new_simple ("application/x-gst-check", "changed",
+      G_TYPE_BOOLEAN, TRUE, NULL);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_caps (caps)));
+  fail_unless (gst_pad_push (mysrcpad, gst_buffer_new ()) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad, gst_buffer_new ()) == GST_FLOW_OK);
+
+  s = gst_app_sink_try_pull_batch (GST_APP_SINK (sink), 16, 0);
+  fail_unless (s != NULL);
+  fail_unless_equals_int (gst_buffer_list_length (gst_sample_get_buffer_list
+          (s)), 1);
+  fail_if (gst_caps_is_equal (gst_sample_get_caps (s), caps));
+  gst_sample_unref (s);
+
+  s = gst_app_sink_try_pull_batch (GST_APP_SINK (sink), 16, 0);
+  fail_unless (s != NULL);
+  fail_unless_equals_int (gst_buffer_list_length (gst_sample_get_buffer_list
+          (s)), 2);
+  fail_unless (gst_caps_is_equal (gst_sample_get_caps (s), caps));
+  gst_sample_unref (s);
+  gst_caps_unref (caps);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_appsink (sink);
+}
+
+GST_END_TEST;
+
+#ifdef G_OS_UNIX
+static gboolean
+wakeup_fd_is_readable (gint fd)
+{
+  GPollFD pfd = { fd, G_IO_IN, 0 };
+
+  return g_poll (&pfd, 1, 0) == 1 && (pfd.revents & G_IO_IN);
+}
+
+GST_START_TEST (test_wakeup_fd)
+{
+  GstElement *sink;
+  GstSample *s;
+  gint fd;
+
+  sink = setup_appsink ();
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  fd = gst_app_sink_get_wakeup_fd (GST_APP_SINK (sink));
+  fail_unless (fd >= 0);
+  fail_unless_equals_int (gst_app_sink_get_wakeup_fd (GST_APP_SINK (sink)),
+      fd);
+  fail_if (wakeup_fd_is_readable (fd));
+
+  fail_unless (gst_pad_push (mysrcpad, gst_buffer_new ()) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad, gst_buffer_new ()) == GST_FLOW_OK);
+  fail_unless (wakeup_fd_is_readable (fd));
+
+  s = gst_app_sink_try_pull_sample (GST_APP_SINK (sink), 0);
+  fail_unless (s != NULL);
+  gst_sample_unref (s);
+  fail_unless (wakeup_fd_is_readable (fd));
+
+  s = gst_app_sink_try_pull_sample (GST_APP_SINK (sink), 0);
+  fail_unless (s != NULL);
+  gst_sample_unref (s);
+  fail_if (wakeup_fd_is_readable (fd));
+
+  /* EOS wakes up as well */
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+  fail_unless (wakeup_fd_is_readable (fd));
+  fail_unless (gst_app_sink_is_eos (GST_APP_SINK (sink)));
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  fail_if (wakeup_fd_is_readable (fd));
+  cleanup_appsink (sink);
+}
+
+GST_END_TEST;
+#endif
+
 static Suite *
 appsink_suite (void)
 {
@@ -1270,6 +1393,10 @@ appsink_suite (void)
   tcase_add_test (tc_chain, test_caps_before_flush_race_condition);
   tcase_add_test (tc_chain, test_query_allocation_callback);
   tcase_add_test (tc_chain, test_query_allocation_signals);
+  tcase_add_test (tc_chain, test_pull_batch);
+#ifdef G_OS_UNIX
+  tcase_add_test (tc_chain, test_wakeup_fd);
+#endif
   tcase_add_loop_test (tc_chain, test_buffering_limits, 0,
       G_N_ELEMENTS (test_buffering_limit_params) * 2);
 
@@ -0,0 +1,241 @@
+/* GStreamer
+ *
+ * unit tests for oggdemux
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <glib/gstdio.h>
+#include <gst/check/gstcheck.h>
+
+/* first timestamp that came out of a demuxer pad since the last flush */
+typedef struct
+{
+  GMutex lock;
+  GstClockTime first_pts;
+} StreamState;
+
+static GPtrArray *streams;
+
+static GstPadProbeReturn
+stream_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  StreamState *state = user_data;
+
+  g_mutex_lock (&state->lock);
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER) {
+    GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER (info);
+
+    if (!GST_CLOCK_TIME_IS_VALID (state->first_pts)
+        && !GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_HEADER))
+      state->first_pts = GST_BUFFER_PTS (buf);
+  } else if (GST_EVENT_TYPE (GST_PAD_PROBE_INFO_EVENT (info)) ==
+      GST_EVENT_FLUSH_STOP) {
+    state->first_pts = GST_CLOCK_TIME_NONE;
+  }
+  g_mutex_unlock (&state->lock);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+stream_state_free (StreamState * state)
+{
+  g_mutex_clear (&state->lock);
+  g_free (state);
+}
+
+static void
+pad_added_cb (GstElement * demux, GstPad * pad, GstBin * pipeline)
+{
+  GstElement *queue, *sink;
+  GstPad *sinkpad;
+  StreamState *state;
+
+  state = g_new0 (StreamState, 1);
+  g_mutex_init (&state->lock);
+  state->first_pts = GST_CLOCK_TIME_NONE;
+  g_ptr_array_add (streams, state);
+  gst_pad_add_probe (pad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_FLUSH,
+      stream_probe, state, NULL);
+
+  queue = gst_element_factory_make ("queue", NULL);
+  sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (sink, "sync", FALSE, NULL);
+  gst_bin_add_many (pipeline, queue, sink, NULL);
+  fail_unless (gst_element_link (queue, sink));
+  sinkpad = gst_element_get_static_pad (queue, "sink");
+  fail_unless_equals_int (gst_pad_link (pad, sinkpad), GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+  gst_element_sync_state_with_parent (sink);
+  gst_element_sync_state_with_parent (queue);
+}
+
+static void
+wait_for_eos (GstElement * pipeline)
+{
+  GstBus *bus;
+  GstMessage *msg;
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+}
+
+/* 20 seconds of theora with a keyframe every second, interleaved with
+ * vorbis */
+static gchar *
+create_theora_vorbis_file (void)
+{
+  GstElement *pipeline, *sink;
+  gchar *path;
+  gint fd;
+
+  fd = g_file_open_tmp ("oggdemux-XXXXXX.ogg", &path, NULL);
+  fail_unless (fd >= 0);
+  g_close (fd, NULL);
+
+  pipeline = gst_parse_launch ("videotestsrc num-buffers=300 ! "
+      "video/x-raw, width=64, height=48, framerate=15/1 ! "
+      "theoraenc keyframe-auto=false keyframe-freq=15 ! oggmux name=mux ! "
+      "filesink name=sink "
+      "audiotestsrc num-buffers=157 samplesperbuffer=2048 ! "
+      "audio/x-raw, rate=16000, channels=1 ! vorbisenc ! mux.", NULL);
+  fail_unless (pipeline != NULL);
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_object_set (sink, "location", path, NULL);
+  gst_object_unref (sink);
+
+  fail_unless (gst_element_set_state (pipeline, GST_STATE_PLAYING) !=
+      GST_STATE_CHANGE_FAILURE);
+  wait_for_eos (pipeline);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return path;
+}
+
+/* every stream has to start at or before the seek target, and not much
+ * earlier than the keyframe before it and the pages around it */
+static void
+check_seeks (GstElement * pipeline)
+{
+  static const GstClockTime targets[] = {
+    13300 * GST_MSECOND, 2500 * GST_MSECOND, 17800 * GST_MSECOND,
+    7100 * GST_MSECOND, 500 * GST_MSECOND, 7200 * GST_MSECOND,
+  };
+  guint i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (targets); i++) {
+    fail_unless (gst_element_seek_simple (pipeline, GST_FORMAT_TIME,
+            GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE, targets[i]));
+    fail_unless_equals_int (gst_element_get_state (pipeline, NULL, NULL,
+            GST_CLOCK_TIME_NONE), GST_STATE_CHANGE_SUCCESS);
+
+    for (j = 0; j < streams->len; j++) {
+      StreamState *state = g_ptr_array_index (streams, j);
+      GstClockTime pts;
+
+      g_mutex_lock (&state->lock);
+      pts = state->first_pts;
+      g_mutex_unlock (&state->lock);
+
+      GST_DEBUG ("seek to %" GST_TIME_FORMAT ", stream %u starts at %"
+          GST_TIME_FORMAT, GST_TIME_ARGS (targets[i]), j,
+          GST_TIME_ARGS (pts));
+      fail_unless (GST_CLOCK_TIME_IS_VALID (pts));
+      fail_unless (pts <= targets[i]);
+      fail_unless (targets[i] - pts < 5 * GST_SECOND);
+    }
+  }
+}
+
+GST_START_TEST (test_seek_interleaved)
+{
+  GstElement *pipeline, *src, *demux;
+  gchar *path;
+
+  path = create_theora_vorbis_file ();
+  streams =
+      g_ptr_array_new_with_free_func ((GDestroyNotify) stream_state_free);
+
+  pipeline = gst_pipeline_new (NULL);
+  src = gst_element_factory_make ("filesrc", NULL);
+  demux = gst_element_factory_make ("oggdemux", NULL);
+  g_object_set (src, "location", path, NULL);
+  gst_bin_add_many (GST_BIN (pipeline), src, demux, NULL);
+  fail_unless (gst_element_link (src, demux));
+  g_signal_connect (demux, "pad-added", G_CALLBACK (pad_added_cb), pipeline);
+
+  fail_unless_equals_int (gst_element_set_state (pipeline, GST_STATE_PAUSED),
+      GST_STATE_CHANGE_ASYNC);
+  fail_unless_equals_int (gst_element_get_state (pipeline, NULL, NULL,
+          GST_CLOCK_TIME_NONE), GST_STATE_CHANGE_SUCCESS);
+  fail_unless_equals_int (streams->len, 2);
+
+  /* only a few pages are known, the seeks mostly bisect the whole file */
+  check_seeks (pipeline);
+
+  /* playing the file indexes the pages of both streams, and the seeks are
+   * narrowed down with them */
+  fail_unless (gst_element_seek_simple (pipeline, GST_FORMAT_TIME,
+          GST_SEEK_FLAG_FLUSH, 0));
+  fail_unless (gst_element_set_state (pipeline, GST_STATE_PLAYING) !=
+      GST_STATE_CHANGE_FAILURE);
+  wait_for_eos (pipeline);
+  fail_unless (gst_element_set_state (pipeline, GST_STATE_PAUSED) !=
+      GST_STATE_CHANGE_FAILURE);
+
+  check_seeks (pipeline);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+  g_ptr_array_unref (streams);
+  streams = NULL;
+
+  g_unlink (path);
+  g_free (path);
+}
+
+GST_END_TEST;
+
+static Suite *
+oggdemux_suite (void)
+{
+  Suite *s = suite_create ("oggdemux");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+
+  if (gst_registry_check_feature_version (gst_registry_get (), "theoraenc",
+          GST_VERSION_MAJOR, GST_VERSION_MINOR, 0)
+      && gst_registry_check_feature_version (gst_registry_get (), "vorbisenc",
+          GST_VERSION_MAJOR, GST_VERSION_MINOR, 0)) {
+    tcase_add_test (tc_chain, test_seek_interleaved);
+  }
+
+  return s;
+}
+
+GST_CHECK_MAIN (oggdemux);
@@ -484,6 +484,61 @@ GST_START_TEST (test_opus_decode_plc_timestamps_with_fec)
 
 GST_END_TEST;
 
+static void
+run_parallel_encoding (const gchar * bitrate_type)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+  GstCaps *caps;
+  GstAudioInfo info;
+  gsize packet_size = 0;
+  gchar *launch;
+  gint i;
+
+  h = gst_harness_new_parse ("opusdec");
+  launch = g_strdup_printf ("audiotestsrc samplesperbuffer=960 ! "
+      "audio/x-raw,format=" GST_AUDIO_NE (S16) ",rate=48000,channels=6,"
+      "channel-mask=(bitmask)0x3f ! opusenc max-threads=4 bitrate-type=%s",
+      bitrate_type);
+  gst_harness_add_src_parse (h, launch, TRUE);
+  g_free (launch);
+
+  for (i = 0; i < 10; i++) {
+    gst_harness_src_crank_and_push_many (h, 1, 0);
+    fail_unless (buf = gst_harness_pull (h->src_harness));
+
+    /* the streams are put together into one constant size packet */
+    if (g_str_equal (bitrate_type, "cbr")) {
+      if (i == 0)
+        packet_size = gst_buffer_get_size (buf);
+      fail_unless_equals_int (gst_buffer_get_size (buf), packet_size);
+    }
+
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+    /* and the decoder can split them up again */
+    fail_unless (buf = gst_harness_pull (h));
+    caps = gst_pad_get_current_caps (h->sinkpad);
+    fail_unless (gst_audio_info_from_caps (&info, caps));
+    gst_caps_unref (caps);
+    fail_unless_equals_int (GST_AUDIO_INFO_CHANNELS (&info), 6);
+    fail_unless (gst_buffer_get_size (buf) > 0);
+    fail_unless_equals_int (gst_buffer_get_size (buf) %
+        GST_AUDIO_INFO_BPF (&info), 0);
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_START_TEST (test_opus_encode_parallel_streams)
+{
+  run_parallel_encoding ("constrained-vbr");
+  run_parallel_encoding ("cbr");
+}
+
+GST_END_TEST;
+
 static Suite *
 opus_suite (void)
 {
@@ -498,6 +553,7 @@ opus_suite (void)
   tcase_add_test (tc_chain, test_opus_encode_properties);
   tcase_add_test (tc_chain, test_opusdec_getcaps);
   tcase_add_test (tc_chain, test_opus_decode_plc_timestamps_with_fec);
+  tcase_add_test (tc_chain, test_opus_encode_parallel_streams);
 
   return s;
 }
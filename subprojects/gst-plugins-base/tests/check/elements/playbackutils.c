@@ -0,0 +1,142 @@
+/* GStreamer
+ *
+ * unit tests for the factory filter cache of the playback elements
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <gst/check/gstcheck.h>
+
+/* the cache is internal to the playback plugin */
+#include "../../../gst/playback/gstplaybackutils.c"
+
+static GList *
+factory_list_new (const gchar * name)
+{
+  GstElementFactory *factory = gst_element_factory_find (name);
+
+  fail_unless (factory != NULL);
+
+  return g_list_append (NULL, factory);
+}
+
+static void
+check_filter_result (GList * result, GList * expected)
+{
+  fail_unless_equals_int (g_list_length (result), 1);
+  fail_unless (result->data == expected->data);
+  gst_plugin_feature_list_free (result);
+}
+
+static guint
+filter_cache_size (void)
+{
+  guint size;
+
+  g_mutex_lock (&filter_cache_lock);
+  size = filter_cache ? g_hash_table_size (filter_cache) : 0;
+  g_mutex_unlock (&filter_cache_lock);
+
+  return size;
+}
+
+GST_START_TEST (test_filter_cache)
+{
+  GList *identity, *fakesink, *result;
+  guint32 cookie;
+  GstCaps *caps;
+  guint i;
+
+  /* both accept any caps, so the result shows which list was filtered */
+  identity = factory_list_new ("identity");
+  fakesink = factory_list_new ("fakesink");
+  cookie = gst_registry_get_feature_list_cookie (gst_registry_get ());
+
+  caps = gst_caps_from_string ("audio/x-test, rate=(int)48000");
+  result = gst_playback_utils_filter_factories ("test", identity, cookie,
+      caps, FALSE);
+  check_filter_result (result, identity);
+  fail_unless_equals_int (filter_cache_size (), 1);
+
+  /* same list id, cookie and caps: the cached result is returned */
+  result = gst_playback_utils_filter_factories ("test", fakesink, cookie,
+      caps, FALSE);
+  check_filter_result (result, identity);
+  fail_unless_equals_int (filter_cache_size (), 1);
+
+  /* a different list id is a different entry */
+  result = gst_playback_utils_filter_factories ("test-other", fakesink,
+      cookie, caps, FALSE);
+  check_filter_result (result, fakesink);
+  fail_unless_equals_int (filter_cache_size (), 2);
+
+  /* a new registry cookie drops all cached results */
+  cookie++;
+  result = gst_playback_utils_filter_factories ("test", fakesink, cookie,
+      caps, FALSE);
+  check_filter_result (result, fakesink);
+  fail_unless_equals_int (filter_cache_size (), 1);
+  gst_caps_unref (caps);
+
+  /* the cache is emptied when it is full */
+  cookie++;
+  for (i = 0; i < FILTER_CACHE_MAX_ENTRIES; i++) {
+    caps = gst_caps_new_simple ("audio/x-test", "index", G_TYPE_INT, i, NULL);
+    result = gst_playback_utils_filter_factories ("test", identity, cookie,
+        caps, FALSE);
+    check_filter_result (result, identity);
+    gst_caps_unref (caps);
+  }
+  fail_unless_equals_int (filter_cache_size (), FILTER_CACHE_MAX_ENTRIES);
+
+  caps = gst_caps_new_simple ("audio/x-test", "index", G_TYPE_INT, i, NULL);
+  result = gst_playback_utils_filter_factories ("test", fakesink, cookie,
+      caps, FALSE);
+  check_filter_result (result, fakesink);
+  fail_unless_equals_int (filter_cache_size (), 1);
+  gst_caps_unref (caps);
+
+  /* and the earlier entries are computed again */
+  caps = gst_caps_new_simple ("audio/x-test", "index", G_TYPE_INT, 0, NULL);
+  result = gst_playback_utils_filter_factories ("test", fakesink, cookie,
+      caps, FALSE);
+  check_filter_result (result, fakesink);
+  fail_unless_equals_int (filter_cache_size (), 2);
+  gst_caps_unref (caps);
+
+  gst_plugin_feature_list_free (identity);
+  gst_plugin_feature_list_free (fakesink);
+}
+
+GST_END_TEST;
+
+static Suite *
+playbackutils_suite (void)
+{
+  Suite *s = suite_create ("playbackutils");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_filter_cache);
+
+  return s;
+}
+
+GST_CHECK_MAIN (playbackutils);
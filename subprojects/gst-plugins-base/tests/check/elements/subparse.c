@@ -23,6 +23,8 @@
 
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstharness.h>
+#include <gst/app/gstappsink.h>
+#include <glib/gstdio.h>
 
 #include <string.h>
 
@@ -1095,6 +1097,150 @@ GST_START_TEST (test_raw_conversion)
 
 GST_END_TEST;
 
+GST_START_TEST (test_srt_split_utf8)
+{
+  GstHarness *h;
+  GstBuffer *buffer;
+  GstMapInfo map;
+
+  h = gst_harness_new ("subparse");
+
+  gst_harness_set_src_caps_str (h, "application/x-subtitle");
+  gst_harness_set_sink_caps_str (h, "text/x-raw, format=utf8");
+
+  /* a character split over two buffers must not make the input look like
+   * invalid UTF-8 */
+  fail_unless_equals_int (gst_harness_push (h,
+          buffer_from_static_string ("1\n00:00:01,000 --> 00:00:02,000\n"
+              "Caf\xc3")), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_push (h,
+          buffer_from_static_string ("\xa9\n\n")), GST_FLOW_OK);
+
+  buffer = gst_harness_pull (h);
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  fail_unless_equals_string ((gchar *) map.data, "Caf\xc3\xa9");
+  gst_buffer_unmap (buffer, &map);
+  gst_clear_buffer (&buffer);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static gchar *
+srt_time (guint ms)
+{
+  return g_strdup_printf ("%02u:%02u:%02u,%03u", ms / 3600000,
+      ms / 60000 % 60, ms / 1000 % 60, ms % 1000);
+}
+
+static GstPadProbeReturn
+seek_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  GstEvent *event = GST_PAD_PROBE_INFO_EVENT (info);
+  gint64 *offset = user_data;
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_SEEK) {
+    GstFormat format;
+
+    gst_event_parse_seek (event, NULL, &format, NULL, NULL, offset, NULL,
+        NULL);
+    fail_unless_equals_int (format, GST_FORMAT_BYTES);
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+check_sample_text (GstSample * sample, GstClockTime pts, const gchar * text)
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+
+  fail_unless (sample != NULL);
+  buffer = gst_sample_get_buffer (sample);
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer), pts);
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  fail_unless_equals_string ((gchar *) map.data, text);
+  gst_buffer_unmap (buffer, &map);
+  gst_sample_unref (sample);
+}
+
+GST_START_TEST (test_srt_seek_index)
+{
+  GstElement *pipeline, *src, *sink;
+  GstSample *sample;
+  GstPad *pad;
+  GString *srt;
+  gchar *path;
+  gint64 seek_offset = -1;
+  gsize cue_100_offset = 0;
+  guint i, n = 0;
+  gint fd;
+
+  /* cue 100 is still shown at 150s, all others last half a second */
+  srt = g_string_new (NULL);
+  for (i = 0; i < 200; i++) {
+    gchar *start = srt_time (i * 1000);
+    gchar *end = srt_time (i == 100 ? 150200 : i * 1000 + 500);
+
+    if (i == 100)
+      cue_100_offset = srt->len;
+    g_string_append_printf (srt, "%u\n%s --> %s\nCue %u\n\n", i + 1, start,
+        end, i);
+    g_free (start);
+    g_free (end);
+  }
+
+  fd = g_file_open_tmp ("subparse-XXXXXX.srt", &path, NULL);
+  fail_unless (fd >= 0);
+  g_close (fd, NULL);
+  fail_unless (g_file_set_contents (path, srt->str, srt->len, NULL));
+  g_string_free (srt, TRUE);
+
+  pipeline = gst_parse_launch ("filesrc name=src ! subparse ! "
+      "appsink name=sink sync=false", NULL);
+  fail_unless (pipeline != NULL);
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src");
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_object_set (src, "location", path, NULL);
+
+  /* the first run through the file builds the cue index */
+  fail_unless (gst_element_set_state (pipeline, GST_STATE_PLAYING) !=
+      GST_STATE_CHANGE_FAILURE);
+  while ((sample = gst_app_sink_pull_sample (GST_APP_SINK (sink)))) {
+    gst_sample_unref (sample);
+    n++;
+  }
+  fail_unless_equals_int (n, 200);
+
+  pad = gst_element_get_static_pad (src, "src");
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_EVENT_UPSTREAM, seek_probe,
+      &seek_offset, NULL);
+  gst_object_unref (pad);
+
+  /* so the seek starts reading at cue 100 and not at the start */
+  fail_unless (gst_element_seek_simple (pipeline, GST_FORMAT_TIME,
+          GST_SEEK_FLAG_FLUSH, 150 * GST_SECOND));
+  fail_unless_equals_int64 (seek_offset, cue_100_offset);
+
+  check_sample_text (gst_app_sink_pull_sample (GST_APP_SINK (sink)),
+      150 * GST_SECOND, "Cue 100");
+  check_sample_text (gst_app_sink_pull_sample (GST_APP_SINK (sink)),
+      150 * GST_SECOND, "Cue 150");
+
+  fail_unless_equals_int (gst_element_set_state (pipeline, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (src);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  g_unlink (path);
+  g_free (path);
+}
+
+GST_END_TEST;
+
 /* TODO:
  *  - add/modify tests so that lines aren't dogfed to the parsers in complete
  *    lines or sets of complete lines, but rather in random chunks
@@ -1132,6 +1278,8 @@ subparse_suite (void)
   tcase_add_test (tc_chain, test_sami_self_contained_tags);
   tcase_add_test (tc_chain, test_lrc);
   tcase_add_test (tc_chain, test_raw_conversion);
+  tcase_add_test (tc_chain, test_srt_split_utf8);
+  tcase_add_test (tc_chain, test_srt_seek_index);
   return s;
 }
 
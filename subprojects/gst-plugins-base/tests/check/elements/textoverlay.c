@@ -815,6 +815,163 @@ GST_START_TEST (test_video_render_static_text)
 
 GST_END_TEST;
 
+static GstBuffer *
+render_static_text (GstElement * textoverlay, GstCaps * caps,
+    const gchar * text, GstClockTime ts)
+{
+  GstBuffer *inbuffer, *outbuffer;
+
+  g_object_set (textoverlay, "text", text, NULL);
+
+  inbuffer = create_black_buffer (caps);
+  GST_BUFFER_TIMESTAMP (inbuffer) = ts;
+  GST_BUFFER_DURATION (inbuffer) = GST_SECOND / 10;
+  fail_unless (gst_pad_push (myvideosrcpad, inbuffer) == GST_FLOW_OK);
+
+  fail_unless (buffers != NULL);
+  outbuffer = GST_BUFFER_CAST (g_list_last (buffers)->data);
+  fail_unless (buffer_is_all_black (outbuffer, caps) == FALSE);
+
+  return outbuffer;
+}
+
+static gboolean
+buffers_are_equal (GstBuffer * buf1, GstBuffer * buf2)
+{
+  GstMapInfo map;
+  gboolean res;
+
+  fail_unless (gst_buffer_map (buf1, &map, GST_MAP_READ));
+  res = gst_buffer_get_size (buf2) == map.size &&
+      gst_buffer_memcmp (buf2, 0, map.data, map.size) == 0;
+  gst_buffer_unmap (buf1, &map);
+
+  return res;
+}
+
+GST_START_TEST (test_render_changing_text)
+{
+  GstElement *textoverlay;
+  GstBuffer *first, *second, *third, *markup;
+  GstCaps *incaps;
+
+  textoverlay = setup_textoverlay (TRUE);
+  g_object_set (textoverlay, "draw-outline", TRUE, "draw-shadow", TRUE, NULL);
+
+  fail_unless (gst_element_set_state (textoverlay,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  incaps = create_video_caps (VIDEO_CAPS_STRING);
+  gst_check_setup_events_textoverlay (myvideosrcpad, textoverlay, incaps,
+      GST_FORMAT_TIME, "video");
+
+  /* text composed from glyphs rendered for earlier frames must look the
+   * same as when it was rendered for the first time */
+  first = render_static_text (textoverlay, incaps, "12:34:56", 0);
+  second = render_static_text (textoverlay, incaps, "12:43:65",
+      GST_SECOND / 10);
+  third = render_static_text (textoverlay, incaps, "12:34:56",
+      2 * GST_SECOND / 10);
+  fail_unless (!buffers_are_equal (first, second));
+  fail_unless (buffers_are_equal (first, third));
+
+  /* styled text is rendered by Pango */
+  markup = render_static_text (textoverlay, incaps,
+      "<span foreground=\"red\">12:34:56</span>", 3 * GST_SECOND / 10);
+  fail_unless (!buffers_are_equal (first, markup));
+
+  fail_unless_equals_int (g_list_length (buffers), 4);
+  gst_caps_unref (incaps);
+
+  g_list_foreach (buffers, (GFunc) gst_mini_object_unref, NULL);
+  g_list_free (buffers);
+  buffers = NULL;
+
+  cleanup_textoverlay (textoverlay);
+}
+
+GST_END_TEST;
+
+/* largest and average difference of the luma of two I420 frames */
+static void
+compare_luma (GstBuffer * buf1, GstBuffer * buf2, GstCaps * caps,
+    gint * max_diff, gdouble * avg_diff)
+{
+  GstStructure *s;
+  GstMapInfo map1, map2;
+  gint x, y, w, h;
+  guint64 sum = 0;
+
+  s = gst_caps_get_structure (caps, 0);
+  fail_unless (gst_structure_get_int (s, "width", &w));
+  fail_unless (gst_structure_get_int (s, "height", &h));
+
+  *max_diff = 0;
+  fail_unless (gst_buffer_map (buf1, &map1, GST_MAP_READ));
+  fail_unless (gst_buffer_map (buf2, &map2, GST_MAP_READ));
+  for (y = 0; y < h; ++y) {
+    guint8 *ptr1 = map1.data + (y * GST_ROUND_UP_4 (w));
+    guint8 *ptr2 = map2.data + (y * GST_ROUND_UP_4 (w));
+
+    for (x = 0; x < w; ++x) {
+      gint diff = ABS (ptr1[x] - ptr2[x]);
+
+      *max_diff = MAX (*max_diff, diff);
+      sum += diff;
+    }
+  }
+  gst_buffer_unmap (buf2, &map2);
+  gst_buffer_unmap (buf1, &map1);
+
+  *avg_diff = (gdouble) sum / (w * h);
+}
+
+GST_START_TEST (test_render_cached_glyphs_like_pango)
+{
+  GstElement *textoverlay;
+  GstBuffer *cached, *pango;
+  GstCaps *incaps;
+  gint max_diff;
+  gdouble avg_diff;
+
+  textoverlay = setup_textoverlay (TRUE);
+  g_object_set (textoverlay, "draw-outline", TRUE, "draw-shadow", TRUE, NULL);
+
+  fail_unless (gst_element_set_state (textoverlay,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  incaps = create_video_caps (VIDEO_CAPS_STRING);
+  gst_check_setup_events_textoverlay (myvideosrcpad, textoverlay, incaps,
+      GST_FORMAT_TIME, "video");
+
+  /* the default colour as markup makes Pango render the same text */
+  cached = render_static_text (textoverlay, incaps, "12:34:56 Wavy", 0);
+  pango = render_static_text (textoverlay, incaps,
+      "<span foreground=\"#FFFFFF\">12:34:56 Wavy</span>", GST_SECOND / 10);
+
+  /* glyphs are placed at the nearest quarter pixel, which moves an edge by
+   * at most 1/8 pixel, i.e. about 30 levels of full contrast. Overlapping
+   * outlines and shadows differ a bit more along their edges, but on
+   * average the two frames hardly differ */
+  compare_luma (cached, pango, incaps, &max_diff, &avg_diff);
+  GST_INFO ("largest difference %d, average %f", max_diff, avg_diff);
+  fail_unless (max_diff <= 48, "largest difference %d", max_diff);
+  fail_unless (avg_diff < 1.0, "average difference %f", avg_diff);
+
+  fail_unless_equals_int (g_list_length (buffers), 2);
+  gst_caps_unref (incaps);
+
+  g_list_foreach (buffers, (GFunc) gst_mini_object_unref, NULL);
+  g_list_free (buffers);
+  buffers = NULL;
+
+  cleanup_textoverlay (textoverlay);
+}
+
+GST_END_TEST;
+
 static gpointer
 test_video_waits_for_text_send_text_newsegment_thread (gpointer data)
 {
@@ -1153,6 +1310,8 @@ textoverlay_suite (void)
   tcase_add_test (tc_chain,
       test_video_render_with_any_features_and_no_allocation_meta);
   tcase_add_test (tc_chain, test_video_render_static_text);
+  tcase_add_test (tc_chain, test_render_changing_text);
+  tcase_add_test (tc_chain, test_render_cached_glyphs_like_pango);
   tcase_add_test (tc_chain, test_render_continuity);
   tcase_add_test (tc_chain, test_video_waits_for_text);
 
@@ -2936,6 +2936,95 @@ GST_START_TEST (test_controller_defaults_at_ts0)
 
 GST_END_TEST;
 
+static void
+check_controlled_volume (const gchar * caps_str, gconstpointer in,
+    gconstpointer expected, gsize size)
+{
+  GstControlSource *cs;
+  GstTimedValueControlSource *tvcs;
+  GstElement *volume;
+  GstBuffer *inbuffer, *outbuffer;
+  GstCaps *caps;
+  GstMapInfo map;
+  GstSegment seg;
+
+  volume = setup_volume ();
+
+  cs = gst_interpolation_control_source_new ();
+  g_object_set (cs, "mode", GST_INTERPOLATION_MODE_LINEAR, NULL);
+  gst_object_add_control_binding (GST_OBJECT_CAST (volume),
+      gst_direct_control_binding_new (GST_OBJECT_CAST (volume), "volume", cs));
+
+  /* the value range for volume is 0.0 ... 10.0, so this is half volume */
+  tvcs = (GstTimedValueControlSource *) cs;
+  gst_timed_value_control_source_set (tvcs, 0 * GST_SECOND, 0.05);
+
+  fail_unless (gst_element_set_state (volume,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  inbuffer = gst_buffer_new_and_alloc (size);
+  gst_buffer_fill (inbuffer, 0, in, size);
+  caps = gst_caps_from_string (caps_str);
+  gst_check_setup_events (mysrcpad, volume, caps, GST_FORMAT_TIME);
+  GST_BUFFER_TIMESTAMP (inbuffer) = 0;
+  gst_caps_unref (caps);
+
+  gst_segment_init (&seg, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad,
+          gst_event_new_segment (&seg)) == TRUE);
+
+  fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 1);
+  fail_if ((outbuffer = (GstBuffer *) buffers->data) == NULL);
+  gst_buffer_map (outbuffer, &map, GST_MAP_READ);
+  fail_unless (memcmp (map.data, expected, size) == 0);
+  gst_buffer_unmap (outbuffer, &map);
+
+  gst_object_unref (cs);
+  cleanup_volume (volume);
+}
+
+GST_START_TEST (test_controller_processing_multichannel)
+{
+  gint16 in[8] = { 1000, -1000, 2000, -2000, 4000, -4000, 8000, -8000 };
+  gint16 out[8] = { 500, -500, 1000, -1000, 2000, -2000, 4000, -4000 };
+
+  /* more channels than the specialized stereo kernels handle */
+  check_controlled_volume ("audio/x-raw, format = (string) "
+      GST_AUDIO_NE (S16) ", channels = (int) 4, "
+      "channel-mask = (bitmask) 0, rate = (int) 44100, "
+      "layout = (string) interleaved", in, out, sizeof (in));
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_controller_processing_s24)
+{
+  /* -2000 and 4000 in both byte orders */
+  guint8 in[6] = {
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+    0x30, 0xf8, 0xff, 0xa0, 0x0f, 0x00
+#else
+    0xff, 0xf8, 0x30, 0x00, 0x0f, 0xa0
+#endif
+  };
+  /* -1000 and 2000 */
+  guint8 out[6] = {
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+    0x18, 0xfc, 0xff, 0xd0, 0x07, 0x00
+#else
+    0xff, 0xfc, 0x18, 0x00, 0x07, 0xd0
+#endif
+  };
+
+  check_controlled_volume ("audio/x-raw, format = (string) "
+      GST_AUDIO_NE (S24) ", channels = (int) 1, rate = (int) 44100, "
+      "layout = (string) interleaved", in, out, sizeof (in));
+}
+
+GST_END_TEST;
+
 static Suite *
 volume_suite (void)
 {
@@ -2999,6 +3088,8 @@ volume_suite (void)
   tcase_add_test (tc_chain, test_controller_usability);
   tcase_add_test (tc_chain, test_controller_processing);
   tcase_add_test (tc_chain, test_controller_defaults_at_ts0);
+  tcase_add_test (tc_chain, test_controller_processing_multichannel);
+  tcase_add_test (tc_chain, test_controller_processing_s24);
 
   return s;
 }
@@ -28,6 +28,8 @@
 #include <fcntl.h>
 #include <gst/allocators/gstdmabuf.h>
 #include <gst/allocators/gstfdmemory.h>
+#include <gst/allocators/gstshmallocator.h>
+#include <gst/video/video.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -137,6 +139,45 @@ GST_START_TEST (test_fdmem_dont_close)
 
 GST_END_TEST;
 
+GST_START_TEST (test_video_pool_shareable_memory)
+{
+  GstBufferPool *pool;
+  GstStructure *config;
+  GstVideoInfo info;
+  GstCaps *caps;
+  GstBuffer *buf;
+  GstMemory *mem;
+
+  gst_shm_allocator_init_once ();
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 320, 240);
+  caps = gst_video_info_to_caps (&info);
+
+  pool = gst_video_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, info.size, 0, 0);
+  gst_buffer_pool_config_add_option (config,
+      GST_BUFFER_POOL_OPTION_VIDEO_SHAREABLE_MEMORY);
+  fail_unless (gst_buffer_pool_set_config (pool, config));
+  fail_unless (gst_buffer_pool_set_active (pool, TRUE));
+
+  fail_unless_equals_int (gst_buffer_pool_acquire_buffer (pool, &buf, NULL),
+      GST_FLOW_OK);
+  fail_unless_equals_int (gst_buffer_n_memory (buf), 1);
+  mem = gst_buffer_peek_memory (buf, 0);
+  fail_unless (gst_is_fd_memory (mem));
+  fail_unless (gst_memory_is_type (mem, GST_ALLOCATOR_SHM));
+  fail_unless (gst_fd_memory_get_fd (mem) >= 0);
+  fail_unless (gst_buffer_get_size (buf) >= info.size);
+  gst_buffer_unref (buf);
+
+  fail_unless (gst_buffer_pool_set_active (pool, FALSE));
+  gst_object_unref (pool);
+  gst_caps_unref (caps);
+}
+
+GST_END_TEST;
+
 static Suite *
 allocators_suite (void)
 {
@@ -147,6 +188,7 @@ allocators_suite (void)
   tcase_add_test (tc_chain, test_dmabuf);
   tcase_add_test (tc_chain, test_fdmem);
   tcase_add_test (tc_chain, test_fdmem_dont_close);
+  tcase_add_test (tc_chain, test_video_pool_shareable_memory);
 
   return s;
 }
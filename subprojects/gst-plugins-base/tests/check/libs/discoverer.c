@@ -384,6 +384,67 @@ GST_START_TEST (test_disco_async_custom_context)
 
 GST_END_TEST;
 
+GST_START_TEST (test_disco_batch)
+{
+  GError *err = NULL;
+  GstDiscoverer *dc;
+  GPtrArray *infos;
+  gchar *path, *ogg_uri, *missing_uri;
+  const gchar *uris[6];
+  guint i;
+
+  dc = gst_discoverer_new (30 * GST_SECOND, &err);
+  fail_unless (dc != NULL);
+  fail_unless (err == NULL);
+
+  path = g_build_filename (GST_TEST_FILES_PATH, "theora-vorbis.ogg", NULL);
+  ogg_uri = gst_filename_to_uri (path, &err);
+  g_free (path);
+  fail_unless (err == NULL);
+
+  path = g_build_filename (GST_TEST_FILES_PATH, "does-not-exist.ogg", NULL);
+  missing_uri = gst_filename_to_uri (path, &err);
+  g_free (path);
+  fail_unless (err == NULL);
+
+  uris[0] = ogg_uri;
+  uris[1] = missing_uri;
+  uris[2] = ogg_uri;
+  uris[3] = ogg_uri;
+  uris[4] = missing_uri;
+  uris[5] = NULL;
+
+  infos = gst_discoverer_discover_uris (dc, uris, 2);
+  fail_unless (infos != NULL);
+  fail_unless_equals_int (infos->len, 5);
+
+  for (i = 0; i < infos->len; i++) {
+    GstDiscovererInfo *info = g_ptr_array_index (infos, i);
+    GstDiscovererResult result = gst_discoverer_info_get_result (info);
+
+    fail_unless_equals_string (gst_discoverer_info_get_uri (info), uris[i]);
+    if (uris[i] == missing_uri)
+      fail_unless (result != GST_DISCOVERER_OK);
+    else if (have_theora && have_ogg)
+      fail_unless_equals_int (result, GST_DISCOVERER_OK);
+    else
+      fail_unless_equals_int (result, GST_DISCOVERER_MISSING_PLUGINS);
+  }
+  g_ptr_array_unref (infos);
+
+  /* an empty batch */
+  uris[0] = NULL;
+  infos = gst_discoverer_discover_uris (dc, uris, 0);
+  fail_unless_equals_int (infos->len, 0);
+  g_ptr_array_unref (infos);
+
+  g_free (ogg_uri);
+  g_free (missing_uri);
+  g_object_unref (dc);
+}
+
+GST_END_TEST;
+
 static Suite *
 discoverer_suite (void)
 {
@@ -406,6 +467,7 @@ discoverer_suite (void)
   tcase_add_test (tc_chain, test_disco_async);
   tcase_add_test (tc_chain, test_disco_async_custom_context);
   tcase_add_test (tc_chain, test_disco_async_reuse);
+  tcase_add_test (tc_chain, test_disco_batch);
   return s;
 }
 
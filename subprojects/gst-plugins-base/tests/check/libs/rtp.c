@@ -2339,6 +2339,117 @@ GST_START_TEST (test_rtp_buffer_remove_extension_data)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtp_buffer_list_headers)
+{
+  GstRTPBufferListHeaders headers = GST_RTP_BUFFER_LIST_HEADERS_INIT;
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstBufferList *list;
+  GstBuffer *buf;
+  guint i;
+
+  list = gst_buffer_list_new ();
+
+  /* plain packet */
+  buf = gst_rtp_buffer_new_allocate (16, 0, 0);
+  gst_buffer_list_add (list, buf);
+
+  /* CSRCs, header extension, padding and marker */
+  buf = gst_rtp_buffer_new_allocate (16, 4, 2);
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp));
+  fail_unless (gst_rtp_buffer_set_extension_data (&rtp, 0xBEDE, 2));
+  gst_rtp_buffer_set_marker (&rtp, TRUE);
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_list_add (list, buf);
+
+  /* not RTP */
+  buf = gst_buffer_new_and_alloc (8);
+  gst_buffer_memset (buf, 0, 0, 8);
+  gst_buffer_list_add (list, buf);
+
+  /* header split over several memories */
+  buf = gst_rtp_buffer_new_allocate (16, 0, 0);
+  gst_buffer_list_add (list, gst_buffer_append (gst_buffer_copy_region (buf,
+              GST_BUFFER_COPY_ALL, 0, 12), gst_buffer_copy_region (buf,
+              GST_BUFFER_COPY_ALL, 12, 16)));
+  gst_buffer_unref (buf);
+
+  /* header extension split over several memories, which
+   * gst_rtp_buffer_map() rejects */
+  buf = gst_rtp_buffer_new_allocate (16, 0, 0);
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp));
+  fail_unless (gst_rtp_buffer_set_extension_data (&rtp, 0xBEDE, 2));
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_list_add (list,
+      gst_buffer_append (gst_buffer_append (gst_buffer_copy_region (buf,
+                  GST_BUFFER_COPY_ALL, 0, 12), gst_buffer_copy_region (buf,
+                  GST_BUFFER_COPY_ALL, 12, 6)), gst_buffer_copy_region (buf,
+              GST_BUFFER_COPY_ALL, 18, -1)));
+  gst_buffer_unref (buf);
+
+  fail_unless_equals_int (gst_rtp_buffer_list_set_headers (list, 0x12345678,
+          96, 65534, 90000), 2);
+  /* writing stops at the invalid packet */
+  fail_unless_equals_int (gst_rtp_buffer_list_parse_headers (list, &headers),
+      3);
+  fail_unless_equals_int (headers.n_packets, 5);
+
+  fail_unless (headers.valid[0]);
+  fail_unless_equals_int (headers.seq[0], 65534);
+  fail_unless_equals_int (headers.timestamp[0], 90000);
+  fail_unless_equals_int (headers.ssrc[0], 0x12345678);
+  fail_unless_equals_int (headers.payload_type[0], 96);
+  fail_unless_equals_int (headers.marker[0], 0);
+  fail_unless_equals_int (headers.header_len[0], 12);
+  fail_unless_equals_int (headers.extension_offset[0], 0);
+  fail_unless_equals_int (headers.payload_len[0], 16);
+
+  fail_unless (headers.valid[1]);
+  fail_unless_equals_int (headers.seq[1], 65535);
+  fail_unless_equals_int (headers.payload_type[1], 96);
+  fail_unless_equals_int (headers.marker[1], 1);
+  fail_unless_equals_int (headers.header_len[1], 12 + 2 * 4 + 4 + 2 * 4);
+  fail_unless_equals_int (headers.extension_offset[1], 12 + 2 * 4);
+  fail_unless_equals_int (headers.payload_len[1], 16);
+
+  fail_if (headers.valid[2]);
+  fail_unless_equals_int (headers.seq[2], 0);
+
+  fail_unless (headers.valid[3]);
+  fail_unless_equals_int (headers.header_len[3], 12);
+  fail_unless_equals_int (headers.payload_len[3], 16);
+
+  fail_if (headers.valid[4]);
+
+  /* valid packets can be mapped and the values match what
+   * gst_rtp_buffer_map() reports, invalid ones can't */
+  for (i = 0; i < headers.n_packets; i++) {
+    buf = gst_buffer_list_get (list, i);
+    if (!headers.valid[i]) {
+      fail_if (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+      continue;
+    }
+    fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+    fail_unless_equals_int (headers.seq[i], gst_rtp_buffer_get_seq (&rtp));
+    fail_unless_equals_int (headers.ssrc[i], gst_rtp_buffer_get_ssrc (&rtp));
+    fail_unless_equals_int (headers.header_len[i],
+        gst_rtp_buffer_get_header_len (&rtp));
+    fail_unless_equals_int (headers.payload_len[i],
+        gst_rtp_buffer_get_payload_len (&rtp));
+    gst_rtp_buffer_unmap (&rtp);
+  }
+
+  /* reusing the arrays for a shorter list */
+  gst_buffer_list_remove (list, 1, 3);
+  fail_unless_equals_int (gst_rtp_buffer_list_parse_headers (list, &headers),
+      1);
+  fail_unless_equals_int (headers.n_packets, 2);
+
+  gst_rtp_buffer_list_headers_clear (&headers);
+  gst_buffer_list_unref (list);
+}
+
+GST_END_TEST;
+
 static Suite *
 rtp_suite (void)
 {
@@ -2396,6 +2507,7 @@ rtp_suite (void)
   tcase_add_test (tc_chain, test_rtp_buffer_extlen_wraparound);
   tcase_add_test (tc_chain, test_rtp_buffer_remove_extension_data);
   tcase_add_test (tc_chain, test_rtp_buffer_set_extension_data_shrink_data);
+  tcase_add_test (tc_chain, test_rtp_buffer_list_headers);
 
   return s;
 }
@@ -1000,6 +1000,36 @@ GST_START_TEST (test_rtsp_message_auth_credentials_boxed)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtsp_find_header_field)
+{
+  guint i;
+
+  fail_unless_equals_int (gst_rtsp_find_header_field ("CSeq"),
+      GST_RTSP_HDR_CSEQ);
+  fail_unless_equals_int (gst_rtsp_find_header_field ("cseq"),
+      GST_RTSP_HDR_CSEQ);
+  fail_unless_equals_int (gst_rtsp_find_header_field ("TRANSPORT"),
+      GST_RTSP_HDR_TRANSPORT);
+  fail_unless_equals_int (gst_rtsp_find_header_field ("x-Sessioncookie"),
+      GST_RTSP_HDR_X_SESSIONCOOKIE);
+  fail_unless_equals_int (gst_rtsp_find_header_field ("Frames"),
+      GST_RTSP_HDR_FRAMES);
+  fail_unless_equals_int (gst_rtsp_find_header_field ("X-Custom"),
+      GST_RTSP_HDR_INVALID);
+  fail_unless_equals_int (gst_rtsp_find_header_field ("CSeq2"),
+      GST_RTSP_HDR_INVALID);
+  fail_unless_equals_int (gst_rtsp_find_header_field (""),
+      GST_RTSP_HDR_INVALID);
+
+  /* every known header maps back to itself */
+  for (i = GST_RTSP_HDR_INVALID + 1; i < GST_RTSP_HDR_LAST; i++) {
+    fail_unless_equals_int (gst_rtsp_find_header_field (gst_rtsp_header_as_text
+            (i)), i);
+  }
+}
+
+GST_END_TEST;
+
 static Suite *
 rtsp_suite (void)
 {
@@ -1019,6 +1049,7 @@ rtsp_suite (void)
   tcase_add_test (tc_chain, test_rtsp_message);
   tcase_add_test (tc_chain, test_rtsp_message_auth_credentials);
   tcase_add_test (tc_chain, test_rtsp_message_auth_credentials_boxed);
+  tcase_add_test (tc_chain, test_rtsp_find_header_field);
 
   return s;
 }
@@ -2477,6 +2477,256 @@ GST_START_TEST (test_video_scaler)
 
 GST_END_TEST;
 
+static void
+check_scaler_coeff_equal (GstVideoScaler * s1, GstVideoScaler * s2,
+    guint out_size)
+{
+  guint i;
+
+  fail_unless_equals_int (gst_video_scaler_get_max_taps (s1),
+      gst_video_scaler_get_max_taps (s2));
+
+  for (i = 0; i < out_size; i++) {
+    const gdouble *c1, *c2;
+    guint o1, o2, t1, t2;
+
+    c1 = gst_video_scaler_get_coeff (s1, i, &o1, &t1);
+    c2 = gst_video_scaler_get_coeff (s2, i, &o2, &t2);
+    fail_unless (c1 != c2);
+    fail_unless_equals_int (o1, o2);
+    fail_unless_equals_int (t1, t2);
+    fail_unless (memcmp (c1, c2, sizeof (gdouble) * t1) == 0);
+  }
+}
+
+GST_START_TEST (test_video_scaler_cache)
+{
+  GstVideoScaler *s1, *s2, *s3;
+  GstStructure *options;
+  guint taps1, taps3;
+
+  options = gst_structure_new ("options",
+      GST_VIDEO_RESAMPLER_OPT_ENVELOPE, G_TYPE_DOUBLE, 2.0, NULL);
+
+  /* the same configuration twice gives independent but identical taps */
+  s1 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, 1920, 1280, options);
+  s2 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, 1920, 1280, options);
+  check_scaler_coeff_equal (s1, s2, 1280);
+  gst_video_scaler_free (s2);
+
+  /* a different option must not reuse the cached taps */
+  gst_structure_set (options, GST_VIDEO_RESAMPLER_OPT_ENVELOPE, G_TYPE_DOUBLE,
+      4.0, NULL);
+  s3 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, 1920, 1280, options);
+  gst_video_scaler_get_coeff (s1, 0, NULL, &taps1);
+  gst_video_scaler_get_coeff (s3, 0, NULL, &taps3);
+  fail_unless (taps1 != taps3);
+  gst_video_scaler_free (s3);
+
+  /* unrelated fields in the options don't matter */
+  gst_structure_set (options, GST_VIDEO_RESAMPLER_OPT_ENVELOPE, G_TYPE_DOUBLE,
+      2.0, "foo", G_TYPE_INT, 1, NULL);
+  s2 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, 0, 1920, 1280, options);
+  check_scaler_coeff_equal (s1, s2, 1280);
+  gst_video_scaler_free (s2);
+  gst_video_scaler_free (s1);
+
+  /* interlaced scalers are cached separately */
+  s1 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_CUBIC,
+      GST_VIDEO_SCALER_FLAG_INTERLACED, 0, 1080, 720, NULL);
+  s2 = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_CUBIC,
+      GST_VIDEO_SCALER_FLAG_INTERLACED, 0, 1080, 720, NULL);
+  check_scaler_coeff_equal (s1, s2, 720);
+  gst_video_scaler_free (s1);
+  gst_video_scaler_free (s2);
+
+  gst_structure_free (options);
+}
+
+GST_END_TEST;
+
+/* rounds the taps to fixed point like the scaler does, adjusting the bias
+ * until they add up to exactly 1 << precision */
+static void
+scaler_convert_taps (const gdouble * coeff, gint16 * taps, guint n_taps,
+    guint precision)
+{
+  gdouble offset = 0.5, l_offset = 0.0, h_offset = 1.0;
+  guint i, j;
+
+  for (i = 0; i < 64; i++) {
+    gint sum = 0;
+
+    for (j = 0; j < n_taps; j++) {
+      taps[j] = floor (offset + coeff[j] * (1 << precision));
+      sum += taps[j];
+    }
+    if (sum == (1 << precision) || l_offset == h_offset)
+      break;
+
+    if (sum < (1 << precision)) {
+      if (offset > l_offset)
+        l_offset = offset;
+      offset += (h_offset - l_offset) / 2;
+    } else {
+      if (offset < h_offset)
+        h_offset = offset;
+      offset -= (h_offset - l_offset) / 2;
+    }
+  }
+}
+
+/* computes one output sample exactly like the ORC kernels do: 8 bit samples
+ * are accumulated in wrapping 16 bit with 6 bits of tap precision, 16 bit
+ * samples in 32 bit with 12 bits of precision */
+static gint
+scaler_reference (GstVideoScaler * scale, guint out, guint stride,
+    gint (*get) (gconstpointer data, guint idx), gconstpointer data,
+    guint elem, guint bits)
+{
+  const gdouble *coeff;
+  guint in_offset, n_taps, i;
+  gint16 *taps;
+
+  coeff = gst_video_scaler_get_coeff (scale, out, &in_offset, &n_taps);
+  taps = g_newa (gint16, n_taps);
+
+  if (bits == 8) {
+    guint16 acc = 0;
+    gint16 res;
+
+    scaler_convert_taps (coeff, taps, n_taps, 6);
+    for (i = 0; i < n_taps; i++)
+      acc += (guint16) (get (data, (in_offset + i) * stride + elem) * taps[i]);
+    res = (gint16) (guint16) (acc + 32);
+    return CLAMP (res >> 6, 0, 255);
+  } else {
+    guint32 acc = 0;
+    gint32 res;
+
+    scaler_convert_taps (coeff, taps, n_taps, 12);
+    for (i = 0; i < n_taps; i++)
+      acc += (guint32) (get (data, (in_offset + i) * stride + elem) * taps[i]);
+    res = (gint32) (acc + 4095);
+    return CLAMP (res >> 12, 0, 65535);
+  }
+}
+
+static gint
+get_u8 (gconstpointer data, guint idx)
+{
+  return ((const guint8 *) data)[idx];
+}
+
+static gint
+get_u16 (gconstpointer data, guint idx)
+{
+  return ((const guint16 *) data)[idx];
+}
+
+static void
+check_scaler_kernels (GstVideoFormat format, guint n_elems, guint bits,
+    GstVideoResamplerMethod method, guint in_size, guint out_size)
+{
+  GstVideoScaler *hscale, *vscale;
+  gint (*get) (gconstpointer data, guint idx);
+  gpointer src, dest, *lines;
+  guint i, x, y, pstride, max_taps;
+
+  hscale = gst_video_scaler_new (method, GST_VIDEO_SCALER_FLAG_NONE, 0,
+      in_size, out_size, NULL);
+  vscale = gst_video_scaler_new (method, GST_VIDEO_SCALER_FLAG_NONE, 0,
+      in_size, out_size, NULL);
+
+  pstride = (bits / 8) * n_elems;
+  get = bits == 8 ? get_u8 : get_u16;
+
+  src = g_malloc (in_size * in_size * pstride);
+  dest = g_malloc (out_size * pstride);
+  for (i = 0; i < in_size * in_size * pstride; i++)
+    ((guint8 *) src)[i] = g_random_int_range (0, 256);
+
+  /* constant lines must come out unchanged */
+  memset (src, 0x40, in_size * pstride);
+  gst_video_scaler_horizontal (hscale, format, src, dest, 0, out_size);
+  for (i = 0; i < out_size * pstride; i++)
+    fail_unless_equals_int (((guint8 *) dest)[i], 0x40);
+
+  /* random pixels against the fixed point arithmetic of the ORC kernels,
+   * which the SIMD kernels have to match bit for bit */
+  for (y = 0; y < 3; y++) {
+    guint8 *line = (guint8 *) src + (y + 1) * in_size * pstride;
+
+    gst_video_scaler_horizontal (hscale, format, line, dest, 0, out_size);
+    for (x = 0; x < out_size; x++) {
+      for (i = 0; i < n_elems; i++) {
+        gint expected, res;
+
+        expected = scaler_reference (hscale, x, n_elems, get, line, i, bits);
+        res = get (dest, x * n_elems + i);
+        fail_unless (expected == res,
+            "%s h %u->%u at %u/%u: %d != %d",
+            gst_video_format_to_string (format), in_size, out_size, x, i,
+            expected, res);
+      }
+    }
+  }
+
+  max_taps = gst_video_scaler_get_max_taps (vscale);
+  lines = g_new (gpointer, max_taps);
+  for (y = 0; y < out_size; y += 7) {
+    guint in_offset;
+
+    gst_video_scaler_get_coeff (vscale, y, &in_offset, NULL);
+    for (i = 0; i < max_taps; i++)
+      lines[i] = (guint8 *) src + (in_offset + i) * in_size * pstride;
+
+    /* the vertical scaler works on lines of in_size pixels here */
+    gst_video_scaler_vertical (vscale, format, lines, dest, y, in_size);
+    for (x = 0; x < in_size * n_elems; x++) {
+      gint expected, res;
+
+      expected =
+          scaler_reference (vscale, y, in_size * n_elems, get, src, x, bits);
+      res = get (dest, x);
+      fail_unless (expected == res,
+          "%s v %u->%u at %u/%u: %d != %d",
+          gst_video_format_to_string (format), in_size, out_size, x, y,
+          expected, res);
+    }
+  }
+
+  g_free (lines);
+  g_free (src);
+  g_free (dest);
+  gst_video_scaler_free (hscale);
+  gst_video_scaler_free (vscale);
+}
+
+GST_START_TEST (test_video_scaler_kernels)
+{
+  /* sizes that are not a multiple of the SIMD width, so that the tails are
+   * exercised too */
+  check_scaler_kernels (GST_VIDEO_FORMAT_GRAY8, 1, 8,
+      GST_VIDEO_RESAMPLER_METHOD_LANCZOS, 203, 77);
+  check_scaler_kernels (GST_VIDEO_FORMAT_GRAY8, 1, 8,
+      GST_VIDEO_RESAMPLER_METHOD_CUBIC, 131, 89);
+  check_scaler_kernels (GST_VIDEO_FORMAT_NV12, 2, 8,
+      GST_VIDEO_RESAMPLER_METHOD_LANCZOS, 155, 61);
+  check_scaler_kernels (GST_VIDEO_FORMAT_AYUV, 4, 8,
+      GST_VIDEO_RESAMPLER_METHOD_SINC, 99, 53);
+  check_scaler_kernels (GST_VIDEO_FORMAT_GRAY16_LE, 1, 16,
+      GST_VIDEO_RESAMPLER_METHOD_LANCZOS, 203, 77);
+  check_scaler_kernels (GST_VIDEO_FORMAT_AYUV64, 4, 16,
+      GST_VIDEO_RESAMPLER_METHOD_LANCZOS, 117, 45);
+}
+
+GST_END_TEST;
+
 typedef enum
 {
   RGB,
@@ -4370,6 +4620,8 @@ video_suite (void)
   tcase_add_test (tc_chain, test_video_chroma);
   tcase_add_test (tc_chain, test_video_chroma_site);
   tcase_add_test (tc_chain, test_video_scaler);
+  tcase_add_test (tc_chain, test_video_scaler_cache);
+  tcase_add_test (tc_chain, test_video_scaler_kernels);
   tcase_add_test (tc_chain, test_video_color_convert_rgb_rgb);
   tcase_add_test (tc_chain, test_video_color_convert_rgb_yuv);
   tcase_add_test (tc_chain, test_video_color_convert_yuv_yuv);
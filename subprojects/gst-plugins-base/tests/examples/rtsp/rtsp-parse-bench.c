@@ -0,0 +1,270 @@
+/* GStreamer
+ *
+ * rtsp-parse-bench.c: measure parsing of RTSP messages and SDP descriptions
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Replays the requests of a client setting up a camera stream and the
+ * responses of the camera over a loopback RTSP connection, and parses the
+ * SDP of the camera:
+ *
+ *   rtsp-parse-bench --iterations 10000
+ */
+
+#include <string.h>
+
+#include <gio/gio.h>
+#include <gst/gst.h>
+#include <gst/rtsp/rtsp.h>
+#include <gst/sdp/sdp.h>
+
+static gint iterations = 10000;
+
+static GOptionEntry entries[] = {
+  {"iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+      "Number of times to parse the recorded session", NULL},
+  {NULL}
+};
+
+#define SDP \
+  "v=0\r\n" \
+  "o=- 1698764512397412 1 IN IP4 192.168.1.64\r\n" \
+  "s=Media Presentation\r\n" \
+  "e=NONE\r\n" \
+  "b=AS:5100\r\n" \
+  "t=0 0\r\n" \
+  "a=control:rtsp://192.168.1.64:554/Streaming/Channels/101/\r\n" \
+  "m=video 0 RTP/AVP 96\r\n" \
+  "c=IN IP4 0.0.0.0\r\n" \
+  "b=AS:5000\r\n" \
+  "a=recvonly\r\n" \
+  "a=x-dimensions:1920,1080\r\n" \
+  "a=control:rtsp://192.168.1.64:554/Streaming/Channels/101/trackID=1\r\n" \
+  "a=rtpmap:96 H264/90000\r\n" \
+  "a=fmtp:96 profile-level-id=420029; packetization-mode=1; " \
+  "sprop-parameter-sets=Z00AKp2oHgCJ+WbgICAoAAADAAgAAAMBlCA=,aO48gA==\r\n" \
+  "m=audio 0 RTP/AVP 8\r\n" \
+  "c=IN IP4 0.0.0.0\r\n" \
+  "b=AS:50\r\n" \
+  "a=recvonly\r\n" \
+  "a=control:rtsp://192.168.1.64:554/Streaming/Channels/101/trackID=2\r\n" \
+  "a=rtpmap:8 PCMA/8000\r\n" \
+  "a=Media_header:MEDIAINFO=494D4B48010200000400000111710110401F000000FA000000000000000000000000000000000000;\r\n" \
+  "a=appversion:1.0\r\n" \
+  "m=application 0 RTP/AVP 107\r\n" \
+  "c=IN IP4 0.0.0.0\r\n" \
+  "a=recvonly\r\n" \
+  "a=control:rtsp://192.168.1.64:554/Streaming/Channels/101/trackID=3\r\n" \
+  "a=rtpmap:107 vnd.onvif.metadata/90000\r\n"
+
+#define DESCRIBE_RESPONSE \
+  "RTSP/1.0 200 OK\r\n" \
+  "CSeq: 3\r\n" \
+  "Content-Type: application/sdp\r\n" \
+  "Content-Base: rtsp://192.168.1.64:554/Streaming/Channels/101/\r\n" \
+  "Content-Length: %" G_GSIZE_FORMAT "\r\n" \
+  "\r\n" \
+  "%s"
+
+/* a client and a camera setting up a session, as seen on the wire */
+static const gchar *messages[] = {
+  "OPTIONS rtsp://192.168.1.64:554/Streaming/Channels/101 RTSP/1.0\r\n"
+      "CSeq: 2\r\n"
+      "User-Agent: LibVLC/3.0.18 (LIVE555 Streaming Media v2016.11.28)\r\n"
+      "\r\n",
+  "DESCRIBE rtsp://192.168.1.64:554/Streaming/Channels/101 RTSP/1.0\r\n"
+      "CSeq: 3\r\n"
+      "User-Agent: LibVLC/3.0.18 (LIVE555 Streaming Media v2016.11.28)\r\n"
+      "Accept: application/sdp\r\n"
+      "Authorization: Digest username=\"admin\", realm=\"IP Camera(C6214)\", "
+      "nonce=\"4e4459334d7a49784d544d364d6a49784d7a4d30\", "
+      "uri=\"rtsp://192.168.1.64:554/Streaming/Channels/101\", "
+      "response=\"0e9d5d4fa3b4fb2cbd8ba6cd5b1c1f2d\"\r\n"
+      "\r\n",
+  "SETUP rtsp://192.168.1.64:554/Streaming/Channels/101/trackID=1 RTSP/1.0\r\n"
+      "CSeq: 4\r\n"
+      "User-Agent: LibVLC/3.0.18 (LIVE555 Streaming Media v2016.11.28)\r\n"
+      "Transport: RTP/AVP/TCP;unicast;interleaved=0-1\r\n"
+      "X-Custom-Client-Id: 7f1c2a\r\n"
+      "\r\n",
+  "PLAY rtsp://192.168.1.64:554/Streaming/Channels/101/ RTSP/1.0\r\n"
+      "CSeq: 5\r\n"
+      "User-Agent: LibVLC/3.0.18 (LIVE555 Streaming Media v2016.11.28)\r\n"
+      "Session: 1273222269\r\n"
+      "Range: npt=0.000-\r\n"
+      "\r\n",
+  "RTSP/1.0 200 OK\r\n"
+      "CSeq: 2\r\n"
+      "Public: OPTIONS, DESCRIBE, PLAY, PAUSE, SETUP, TEARDOWN, "
+      "SET_PARAMETER, GET_PARAMETER\r\n"
+      "Date:  Tue, Oct 31 2023 14:21:52 GMT\r\n"
+      "\r\n",
+  /* DESCRIBE_RESPONSE */
+  NULL,
+  "RTSP/1.0 200 OK\r\n"
+      "CSeq: 4\r\n"
+      "Session: 1273222269;timeout=60\r\n"
+      "Transport: RTP/AVP/TCP;unicast;interleaved=0-1;ssrc=5f4c12a3;mode=\"play\"\r\n"
+      "Date:  Tue, Oct 31 2023 14:21:52 GMT\r\n"
+      "\r\n",
+  "RTSP/1.0 200 OK\r\n"
+      "CSeq: 5\r\n"
+      "Session: 1273222269\r\n"
+      "RTP-Info: url=rtsp://192.168.1.64:554/Streaming/Channels/101/trackID=1;"
+      "seq=12830;rtptime=2719530981\r\n"
+      "Date:  Tue, Oct 31 2023 14:21:52 GMT\r\n"
+      "\r\n",
+};
+
+typedef struct
+{
+  GOutputStream *output;
+  GString *session;
+} Writer;
+
+static gpointer
+writer_thread (gpointer user_data)
+{
+  Writer *writer = user_data;
+  gint i;
+
+  for (i = 0; i < iterations; i++) {
+    if (!g_output_stream_write_all (writer->output, writer->session->str,
+            writer->session->len, NULL, NULL, NULL))
+      break;
+  }
+
+  return NULL;
+}
+
+static gboolean
+bench_rtsp (void)
+{
+  GSocketListener *listener;
+  GSocketClient *client;
+  GSocketConnection *in_conn, *out_conn;
+  GstRTSPConnection *conn;
+  GstRTSPMessage msg = { 0 };
+  GThread *thread;
+  Writer writer;
+  GstClockTime start, end;
+  guint16 port;
+  guint i, n_messages, received = 0;
+
+  /* the connection is queued on the listener without accepting it first */
+  listener = g_socket_listener_new ();
+  port = g_socket_listener_add_any_inet_port (listener, NULL, NULL);
+  client = g_socket_client_new ();
+  out_conn = g_socket_client_connect_to_host (client, "localhost", port, NULL,
+      NULL);
+  in_conn = out_conn ? g_socket_listener_accept (listener, NULL, NULL,
+      NULL) : NULL;
+  g_object_unref (client);
+  g_object_unref (listener);
+  if (in_conn == NULL) {
+    g_print ("Failed to create loopback connection\n");
+    g_clear_object (&out_conn);
+    return FALSE;
+  }
+
+  gst_rtsp_connection_create_from_socket (g_socket_connection_get_socket
+      (in_conn), "127.0.0.1", port, NULL, &conn);
+
+  n_messages = G_N_ELEMENTS (messages);
+  writer.output = g_io_stream_get_output_stream (G_IO_STREAM (out_conn));
+  writer.session = g_string_new (NULL);
+  for (i = 0; i < n_messages; i++) {
+    if (messages[i] != NULL)
+      g_string_append (writer.session, messages[i]);
+    else
+      g_string_append_printf (writer.session, DESCRIBE_RESPONSE, strlen (SDP),
+          SDP);
+  }
+
+  start = gst_util_get_timestamp ();
+  thread = g_thread_new ("writer", writer_thread, &writer);
+  for (i = 0; i < iterations * n_messages; i++) {
+    if (gst_rtsp_connection_receive_usec (conn, &msg,
+            5 * G_USEC_PER_SEC) != GST_RTSP_OK)
+      break;
+    gst_rtsp_message_unset (&msg);
+    received++;
+  }
+  end = gst_util_get_timestamp ();
+  g_thread_join (thread);
+
+  g_print ("rtsp: %u messages (%" G_GSIZE_FORMAT " bytes each session), %.1f "
+      "us per message\n", received, writer.session->len,
+      (gdouble) (end - start) / MAX (received, 1) / 1000);
+
+  g_string_free (writer.session, TRUE);
+  gst_rtsp_connection_free (conn);
+  g_object_unref (in_conn);
+  g_object_unref (out_conn);
+
+  return received == iterations * n_messages;
+}
+
+static void
+bench_sdp (void)
+{
+  GstSDPMessage msg = { 0 };
+  GstClockTime start, end;
+  gint i;
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < iterations; i++) {
+    gst_sdp_message_init (&msg);
+    gst_sdp_message_parse_buffer ((const guint8 *) SDP, strlen (SDP), &msg);
+    gst_sdp_message_uninit (&msg);
+  }
+  end = gst_util_get_timestamp ();
+
+  g_print ("sdp:  %d descriptions (%" G_GSIZE_FORMAT " bytes each), %.1f us "
+      "per description\n", iterations, strlen (SDP),
+      (gdouble) (end - start) / iterations / 1000);
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *ctx;
+  GError *err = NULL;
+  gint ret = 0;
+
+  ctx = g_option_context_new ("- RTSP and SDP parsing benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", err->message);
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (iterations <= 0) {
+    g_print ("Invalid arguments\n");
+    return 1;
+  }
+
+  if (!bench_rtsp ())
+    ret = 1;
+  bench_sdp ();
+
+  return ret;
+}
@@ -0,0 +1,163 @@
+/* GStreamer video scaling benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#define DEFAULT_WIDTH 3840
+#define DEFAULT_HEIGHT 2160
+#define DEFAULT_FORMATS "I420,NV12,v210,AYUV64"
+#define DEFAULT_METHOD GST_VIDEO_RESAMPLER_METHOD_LANCZOS
+
+#define DEFAULT_DURATION 2.0
+
+/* a typical ABR ladder */
+static const struct
+{
+  guint width, height;
+} sizes[] = {
+  {1920, 1080},
+  {1280, 720},
+  {960, 540},
+  {640, 360},
+};
+
+static void
+do_benchmark_scaling (guint width, guint height, GstVideoFormat format,
+    gint method, guint n_threads, gdouble max_duration)
+{
+  GstVideoInfo ininfo;
+  GstVideoFrame inframe;
+  GstBuffer *inbuffer;
+  GTimer *timer;
+  guint i;
+
+  timer = g_timer_new ();
+
+  gst_video_info_set_format (&ininfo, format, width, height);
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_buffer_memset (inbuffer, 0, 0x80, -1);
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    GstVideoInfo outinfo;
+    GstVideoFrame outframe;
+    GstBuffer *outbuffer;
+    GstVideoConverter *convert;
+    gdouble elapsed, frames_sec;
+    gint count;
+
+    gst_video_info_set_format (&outinfo, format, sizes[i].width,
+        sizes[i].height);
+    outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+    gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+
+    convert = gst_video_converter_new (&ininfo, &outinfo,
+        gst_structure_new ("options",
+            GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+            GST_TYPE_VIDEO_RESAMPLER_METHOD, method,
+            GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+    /* warmup */
+    gst_video_converter_frame (convert, &inframe, &outframe);
+
+    count = 0;
+    g_timer_start (timer);
+    while (TRUE) {
+      gst_video_converter_frame (convert, &inframe, &outframe);
+
+      count++;
+      elapsed = g_timer_elapsed (timer, NULL);
+      if (elapsed >= max_duration)
+        break;
+    }
+
+    frames_sec = count / elapsed;
+
+    gst_println ("%8.1f frames/sec %8.1f Mpixels/sec %s @ %ux%u -> %ux%u",
+        frames_sec, frames_sec * width * height / 1e6,
+        gst_video_format_to_string (format), width, height,
+        sizes[i].width, sizes[i].height);
+
+    gst_video_converter_free (convert);
+
+    gst_video_frame_unmap (&outframe);
+    gst_buffer_unref (outbuffer);
+  }
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+
+  g_timer_destroy (timer);
+}
+
+int
+main (int argc, char **argv)
+{
+  GError *err = NULL;
+  gint width = DEFAULT_WIDTH;
+  gint height = DEFAULT_HEIGHT;
+  gint method = DEFAULT_METHOD;
+  gint n_threads = 1;
+  gdouble max_dur = DEFAULT_DURATION;
+  gchar *formats = NULL;
+  gchar **fmts;
+  GOptionContext *ctx;
+  GOptionEntry options[] = {
+    {"width", 'w', 0, G_OPTION_ARG_INT, &width, "Input width", NULL},
+    {"height", 'h', 0, G_OPTION_ARG_INT, &height, "Input height", NULL},
+    {"formats", 'f', 0, G_OPTION_ARG_STRING, &formats,
+        "Comma separated list of formats (default " DEFAULT_FORMATS ")", NULL},
+    {"method", 'm', 0, G_OPTION_ARG_INT, &method,
+        "Resampler method (0 = nearest ... 4 = lanczos)", NULL},
+    {"threads", 't', 0, G_OPTION_ARG_INT, &n_threads,
+        "Number of converter threads", NULL},
+    {"duration", 'd', 0, G_OPTION_ARG_DOUBLE, &max_dur,
+        "Benchmark duration for each run (in seconds)", NULL},
+    {NULL}
+  };
+  guint i;
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  fmts = g_strsplit (formats ? formats : DEFAULT_FORMATS, ",", -1);
+  for (i = 0; fmts[i]; i++) {
+    GstVideoFormat format = gst_video_format_from_string (fmts[i]);
+
+    if (format == GST_VIDEO_FORMAT_UNKNOWN) {
+      g_printerr ("Unknown format %s\n", fmts[i]);
+      continue;
+    }
+    do_benchmark_scaling (width, height, format, method, n_threads, max_dur);
+  }
+  g_strfreev (fmts);
+  g_free (formats);
+
+  return 0;
+}
@@ -60,6 +60,7 @@ GST_DEBUG_CATEGORY_STATIC (deinterlace_debug);
 #define DEFAULT_LOCKING         GST_DEINTERLACE_LOCKING_NONE
 #define DEFAULT_IGNORE_OBSCURE  TRUE
 #define DEFAULT_DROP_ORPHANS    TRUE
+#define DEFAULT_N_THREADS       1
 
 enum
 {
@@ -70,7 +71,8 @@ enum
   PROP_FIELD_LAYOUT,
   PROP_LOCKING,
   PROP_IGNORE_OBSCURE,
-  PROP_DROP_ORPHANS
+  PROP_DROP_ORPHANS,
+  PROP_N_THREADS
 };
 
 /* P is progressive, meaning the top and bottom fields belong to
@@ -459,6 +461,8 @@ gst_deinterlace_set_method (GstDeinterlace * self, GstDeinterlaceMethods method)
   GST_OBJECT_LOCK (self);
   self->method = g_object_new (method_type, "name", "method", NULL);
   gst_object_set_parent (GST_OBJECT (self->method), GST_OBJECT (self));
+  gst_deinterlace_method_set_n_threads (self->method, self->n_threads);
+  self->n_threads_changed = FALSE;
   GST_OBJECT_UNLOCK (self);
 
 #if 0
@@ -643,6 +647,21 @@ gst_deinterlace_class_init (GstDeinterlaceClass * klass)
           "active locking mode.", DEFAULT_DROP_ORPHANS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDeinterlace:n-threads:
+   *
+   * Maximum number of threads used to deinterlace slices of a frame in
+   * parallel (0 = number of processors). Only methods that work line by
+   * line, like yadif, linear or vfir, are split into slices.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = auto)", 0, G_MAXUINT,
+          DEFAULT_N_THREADS, GST_PARAM_MUTABLE_READY | G_PARAM_READWRITE |
+          G_PARAM_STATIC_STRINGS));
+
   element_class->change_state =
       GST_DEBUG_FUNCPTR (gst_deinterlace_change_state);
 
@@ -705,6 +724,7 @@ gst_deinterlace_init (GstDeinterlace * self)
 
   self->mode = DEFAULT_MODE;
   self->user_set_method_id = DEFAULT_METHOD;
+  self->n_threads = DEFAULT_N_THREADS;
   gst_video_info_init (&self->vinfo);
   gst_video_info_init (&self->vinfo_out);
   gst_deinterlace_set_method (self, self->user_set_method_id);
@@ -955,6 +975,13 @@ gst_deinterlace_set_property (GObject * object, guint prop_id,
     case PROP_DROP_ORPHANS:
       self->drop_orphans = g_value_get_boolean (value);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      self->n_threads = g_value_get_uint (value);
+      /* the method might be running, apply it on the next frame */
+      self->n_threads_changed = TRUE;
+      GST_OBJECT_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
   }
@@ -991,6 +1018,9 @@ gst_deinterlace_get_property (GObject * object, guint prop_id,
     case PROP_DROP_ORPHANS:
       g_value_set_boolean (value, self->drop_orphans);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, self->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
   }
@@ -2238,6 +2268,16 @@ gst_deinterlace_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     GST_OBJECT_UNLOCK (self);
   }
 
+  GST_OBJECT_LOCK (self);
+  if (self->n_threads_changed && self->method) {
+    self->n_threads_changed = FALSE;
+    gst_deinterlace_method_set_n_threads (self->method, self->n_threads);
+    GST_OBJECT_UNLOCK (self);
+    gst_deinterlace_method_setup (self->method, &self->vinfo);
+  } else {
+    GST_OBJECT_UNLOCK (self);
+  }
+
   GST_DEBUG_OBJECT (self,
       "[IN] ts %" GST_TIME_FORMAT ", dur %" GST_TIME_FORMAT ", end %"
       GST_TIME_FORMAT, GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (buf)),
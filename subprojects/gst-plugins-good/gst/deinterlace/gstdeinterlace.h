@@ -194,6 +194,10 @@ struct _GstDeinterlace
   GstClockTime pattern_base_ts;
   GstClockTime pattern_buf_dur;
 
+  guint n_threads;
+  /* n_threads changed, applied to the method by the streaming thread */
+  gboolean n_threads_changed;
+
   gboolean need_more;
   gboolean have_eos;
   gboolean telecine_tc_warned;
@@ -26,9 +26,133 @@
 
 #include "gstdeinterlacemethod.h"
 
+/* Don't split frames into slices smaller than this number of lines */
+#define MIN_LINES_PER_SLICE 64
+
 G_DEFINE_ABSTRACT_TYPE (GstDeinterlaceMethod, gst_deinterlace_method,
     GST_TYPE_OBJECT);
 
+/* copied from video-converter.c */
+struct _GstParallelizedTaskRunner
+{
+  GstTaskPool *pool;
+  guint n_threads;
+
+  GstVecDeque *tasks;
+
+  GstParallelizedTaskFunc func;
+  gpointer *task_data;
+
+  GMutex lock;
+  gint n_todo;
+};
+
+static void
+gst_parallelized_task_thread_func (gpointer data)
+{
+  GstParallelizedTaskRunner *runner = data;
+  gint idx;
+
+  g_mutex_lock (&runner->lock);
+  idx = runner->n_todo--;
+  g_assert (runner->n_todo >= -1);
+  g_mutex_unlock (&runner->lock);
+
+  g_assert (runner->func != NULL);
+
+  runner->func (runner->task_data[idx]);
+}
+
+static void
+gst_parallelized_task_runner_join (GstParallelizedTaskRunner * self)
+{
+  gboolean joined = FALSE;
+
+  while (!joined) {
+    g_mutex_lock (&self->lock);
+    if (!(joined = gst_vec_deque_is_empty (self->tasks))) {
+      gpointer task = gst_vec_deque_pop_head (self->tasks);
+      g_mutex_unlock (&self->lock);
+      gst_task_pool_join (self->pool, task);
+    } else {
+      g_mutex_unlock (&self->lock);
+    }
+  }
+}
+
+static void
+gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
+{
+  gst_parallelized_task_runner_join (self);
+
+  gst_vec_deque_free (self->tasks);
+  gst_task_pool_cleanup (self->pool);
+  gst_object_unref (self->pool);
+  g_mutex_clear (&self->lock);
+  g_free (self);
+}
+
+static GstParallelizedTaskRunner *
+gst_parallelized_task_runner_new (guint n_threads)
+{
+  GstParallelizedTaskRunner *self;
+
+  self = g_new0 (GstParallelizedTaskRunner, 1);
+
+  self->pool = gst_shared_task_pool_new ();
+  gst_shared_task_pool_set_max_threads (GST_SHARED_TASK_POOL (self->pool),
+      n_threads);
+  gst_task_pool_prepare (self->pool, NULL);
+
+  self->tasks = gst_vec_deque_new (n_threads);
+
+  self->n_threads = n_threads;
+
+  self->n_todo = -1;
+  g_mutex_init (&self->lock);
+
+  return self;
+}
+
+static void
+gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
+    GstParallelizedTaskFunc func, gpointer * task_data)
+{
+  guint n_threads = self->n_threads;
+
+  self->func = func;
+  self->task_data = task_data;
+
+  if (n_threads > 1) {
+    guint i;
+
+    g_mutex_lock (&self->lock);
+    /* perform one of the functions in the current thread */
+    self->n_todo = self->n_threads - 2;
+    for (i = 1; i < n_threads; i++) {
+      gpointer task =
+          gst_task_pool_push (self->pool, gst_parallelized_task_thread_func,
+          self, NULL);
+
+      /* The return value of push() is nullable but NULL is only returned
+       * with the shared task pool when gst_task_pool_prepare() has not been
+       * called and would thus be a programming error that we should hard-fail
+       * on.
+       */
+      g_assert (task != NULL);
+      gst_vec_deque_push_tail (self->tasks, task);
+    }
+    g_mutex_unlock (&self->lock);
+  }
+
+  self->func (self->task_data[self->n_threads - 1]);
+
+  gst_parallelized_task_runner_join (self);
+
+  self->func = NULL;
+  self->task_data = NULL;
+}
+
 gboolean
 gst_deinterlace_method_supported (GType type, GstVideoFormat format, gint width,
     gint height)
@@ -126,6 +250,8 @@ gst_deinterlace_method_setup_impl (GstDeinterlaceMethod * self,
 {
   GstDeinterlaceMethodClass *klass = GST_DEINTERLACE_METHOD_GET_CLASS (self);
 
+  guint n_threads;
+
   self->vinfo = vinfo;
 
   self->deinterlace_frame = NULL;
@@ -133,6 +259,23 @@ gst_deinterlace_method_setup_impl (GstDeinterlaceMethod * self,
   if (GST_VIDEO_INFO_FORMAT (self->vinfo) == GST_VIDEO_FORMAT_UNKNOWN)
     return;
 
+  if (self->n_threads == 0)
+    n_threads = g_get_num_processors ();
+  else
+    n_threads = self->n_threads;
+
+  if (GST_VIDEO_INFO_HEIGHT (self->vinfo) / n_threads < MIN_LINES_PER_SLICE)
+    n_threads = GST_VIDEO_INFO_HEIGHT (self->vinfo) / MIN_LINES_PER_SLICE;
+  if (n_threads < 1)
+    n_threads = 1;
+
+  if (self->runner && self->runner->n_threads != n_threads) {
+    gst_parallelized_task_runner_free (self->runner);
+    self->runner = NULL;
+  }
+  if (!self->runner && n_threads > 1)
+    self->runner = gst_parallelized_task_runner_new (n_threads);
+
   switch (GST_VIDEO_INFO_FORMAT (self->vinfo)) {
     case GST_VIDEO_FORMAT_YUY2:
       self->deinterlace_frame = klass->deinterlace_frame_yuy2;
@@ -214,9 +357,25 @@ gst_deinterlace_method_setup_impl (GstDeinterlaceMethod * self,
   }
 }
 
+static void
+gst_deinterlace_method_finalize (GObject * object)
+{
+  GstDeinterlaceMethod *self = GST_DEINTERLACE_METHOD (object);
+
+  if (self->runner)
+    gst_parallelized_task_runner_free (self->runner);
+  self->runner = NULL;
+
+  G_OBJECT_CLASS (gst_deinterlace_method_parent_class)->finalize (object);
+}
+
 static void
 gst_deinterlace_method_class_init (GstDeinterlaceMethodClass * klass)
 {
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+
+  gobject_class->finalize = gst_deinterlace_method_finalize;
+
   klass->setup = gst_deinterlace_method_setup_impl;
   klass->supported = gst_deinterlace_method_supported_impl;
 }
@@ -225,6 +384,8 @@ static void
 gst_deinterlace_method_init (GstDeinterlaceMethod * self)
 {
   self->vinfo = NULL;
+  self->n_threads = 1;
+  self->runner = NULL;
 }
 
 void
@@ -253,6 +414,32 @@ gst_deinterlace_method_get_latency (GstDeinterlaceMethod * self)
   return klass->latency;
 }
 
+/* Takes effect on the next call to gst_deinterlace_method_setup() */
+void
+gst_deinterlace_method_set_n_threads (GstDeinterlaceMethod * self,
+    guint n_threads)
+{
+  self->n_threads = n_threads;
+}
+
+guint
+gst_deinterlace_method_get_n_slices (GstDeinterlaceMethod * self)
+{
+  return self->runner ? self->runner->n_threads : 1;
+}
+
+/* Calls @func once for each of the gst_deinterlace_method_get_n_slices()
+ * entries of @task_data and waits until all of them are done */
+void
+gst_deinterlace_method_run_slices (GstDeinterlaceMethod * self,
+    GstParallelizedTaskFunc func, gpointer * task_data)
+{
+  if (self->runner)
+    gst_parallelized_task_runner_run (self->runner, func, task_data);
+  else
+    func (task_data[0]);
+}
+
 G_DEFINE_ABSTRACT_TYPE (GstDeinterlaceSimpleMethod,
     gst_deinterlace_simple_method, GST_TYPE_DEINTERLACE_METHOD);
 
@@ -379,7 +566,7 @@ typedef struct
 #define CLAMP_HI(i) (((i)>=(frame_height)) ? (i-2) : (i))
 
 static guint8 *
-get_line (LinesGetter * lg, gint field_offset, guint plane, gint line,
+get_line (const LinesGetter * lg, gint field_offset, guint plane, gint line,
     gint line_offset)
 {
   const GstVideoFrame *frame;
@@ -434,6 +621,135 @@ get_line (LinesGetter * lg, gint field_offset, guint plane, gint line,
   return data;
 }
 
+static void
+    gst_deinterlace_simple_method_deinterlace_lines
+    (GstDeinterlaceSimpleMethod * self, GstVideoFrame * dest,
+    const LinesGetter * lg, guint cur_field_flags, gint plane,
+    gint frame_width, GstDeinterlaceSimpleMethodFunction copy_scanline,
+    GstDeinterlaceSimpleMethodFunction interpolate_scanline, gint start,
+    gint end)
+{
+  GstDeinterlaceScanlineData scanlines;
+  gint i;
+
+  g_assert (interpolate_scanline != NULL);
+  g_assert (copy_scanline != NULL);
+
+#define LINE(x,i) (((guint8*)GST_VIDEO_FRAME_PLANE_DATA((x),plane)) + i * \
+    GST_VIDEO_FRAME_PLANE_STRIDE((x),plane))
+
+  for (i = start; i < end; i++) {
+    memset (&scanlines, 0, sizeof (scanlines));
+    scanlines.bottom_field = (cur_field_flags == PICTURE_INTERLACED_BOTTOM);
+
+    if (!((i & 1) ^ scanlines.bottom_field)) {
+      /* copying */
+      scanlines.tp = get_line (lg, -1, plane, i, -1);
+      scanlines.bp = get_line (lg, -1, plane, i, 1);
+
+      scanlines.tt0 = get_line (lg, 0, plane, i, -2);
+      scanlines.m0 = get_line (lg, 0, plane, i, 0);
+      scanlines.bb0 = get_line (lg, 0, plane, i, 2);
+
+      scanlines.t1 = get_line (lg, 1, plane, i, -1);
+      scanlines.b1 = get_line (lg, 1, plane, i, 1);
+
+      scanlines.tt2 = get_line (lg, 2, plane, i, -2);
+      scanlines.m2 = get_line (lg, 2, plane, i, 0);
+      scanlines.bb2 = get_line (lg, 2, plane, i, 2);
+
+      copy_scanline (self, LINE (dest, i), &scanlines, frame_width);
+    } else {
+      /* interpolating */
+      scanlines.tp2 = get_line (lg, -2, plane, i, -1);
+      scanlines.bp2 = get_line (lg, -2, plane, i, 1);
+
+      scanlines.ttp = get_line (lg, -1, plane, i, -2);
+      scanlines.mp = get_line (lg, -1, plane, i, 0);
+      scanlines.bbp = get_line (lg, -1, plane, i, 2);
+
+      scanlines.t0 = get_line (lg, 0, plane, i, -1);
+      scanlines.b0 = get_line (lg, 0, plane, i, 1);
+
+      scanlines.tt1 = get_line (lg, 1, plane, i, -2);
+      scanlines.m1 = get_line (lg, 1, plane, i, 0);
+      scanlines.bb1 = get_line (lg, 1, plane, i, 2);
+
+      scanlines.t2 = get_line (lg, 2, plane, i, -1);
+      scanlines.b2 = get_line (lg, 2, plane, i, 1);
+
+      interpolate_scanline (self, LINE (dest, i), &scanlines, frame_width);
+    }
+#undef LINE
+  }
+}
+
+/* Every output line only depends on the input fields, so a frame can be
+ * split into horizontal slices that are processed independently */
+typedef struct
+{
+  GstDeinterlaceSimpleMethod *self;
+  GstVideoFrame *dest;
+  const LinesGetter *lg;
+  guint cur_field_flags;
+
+  guint n_planes;
+  gint plane[3];
+  gint frame_width[3];
+  GstDeinterlaceSimpleMethodFunction copy_scanline[3];
+  GstDeinterlaceSimpleMethodFunction interpolate_scanline[3];
+
+  guint slice;
+  guint n_slices;
+} DeinterlaceSliceTask;
+
+static void
+gst_deinterlace_simple_method_deinterlace_slice (DeinterlaceSliceTask * task)
+{
+  guint i;
+
+  for (i = 0; i < task->n_planes; i++) {
+    gint plane = task->plane[i];
+    gint frame_height = GST_VIDEO_FRAME_COMP_HEIGHT (task->dest, plane);
+    gint n_slices = task->n_slices;
+    gint lines_per_slice, start, end;
+
+    /* Keep the slices field aligned */
+    lines_per_slice = GST_ROUND_UP_2 ((frame_height + n_slices - 1) / n_slices);
+    start = MIN ((gint) task->slice * lines_per_slice, frame_height);
+    end = MIN (start + lines_per_slice, frame_height);
+
+    gst_deinterlace_simple_method_deinterlace_lines (task->self, task->dest,
+        task->lg, task->cur_field_flags, plane, task->frame_width[i],
+        task->copy_scanline[i], task->interpolate_scanline[i], start, end);
+  }
+}
+
+static void
+gst_deinterlace_simple_method_deinterlace_slices (GstDeinterlaceSimpleMethod *
+    self, const DeinterlaceSliceTask * task_template)
+{
+  GstDeinterlaceMethod *method = GST_DEINTERLACE_METHOD (self);
+  DeinterlaceSliceTask *tasks;
+  DeinterlaceSliceTask **tasks_p;
+  guint i, n_slices;
+
+  n_slices = gst_deinterlace_method_get_n_slices (method);
+  tasks = g_newa (DeinterlaceSliceTask, n_slices);
+  tasks_p = g_newa (DeinterlaceSliceTask *, n_slices);
+
+  for (i = 0; i < n_slices; i++) {
+    tasks[i] = *task_template;
+    tasks[i].slice = i;
+    tasks[i].n_slices = n_slices;
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_deinterlace_method_run_slices (method,
+      (GstParallelizedTaskFunc) gst_deinterlace_simple_method_deinterlace_slice,
+      (gpointer *) tasks_p);
+}
+
 static void
 gst_deinterlace_simple_method_deinterlace_frame_packed (GstDeinterlaceMethod *
     method, const GstDeinterlaceField * history, guint history_count,
@@ -443,22 +759,18 @@ gst_deinterlace_simple_method_deinterlace_frame_packed (GstDeinterlaceMethod *
 #ifndef G_DISABLE_ASSERT
   GstDeinterlaceMethodClass *dm_class = GST_DEINTERLACE_METHOD_GET_CLASS (self);
 #endif
-  GstDeinterlaceScanlineData scanlines;
-  guint cur_field_flags;
-  gint i;
-  gint frame_height, frame_width;
+  DeinterlaceSliceTask task = { 0, };
+  gint frame_width;
   LinesGetter lg = { history, history_count, cur_field_idx };
   GstVideoFrame *framep, *frame0, *frame1, *frame2;
 
   g_assert (self->interpolate_scanline_packed != NULL);
   g_assert (self->copy_scanline_packed != NULL);
 
-  frame_height = GST_VIDEO_FRAME_HEIGHT (outframe);
   frame_width = GST_VIDEO_FRAME_PLANE_STRIDE (outframe, 0);
 
   frame0 = history[cur_field_idx].frame;
   frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (frame0, 0));
-  cur_field_flags = history[cur_field_idx].flags;
 
   framep = (cur_field_idx > 0 ? history[cur_field_idx - 1].frame : NULL);
   if (framep)
@@ -478,55 +790,17 @@ gst_deinterlace_simple_method_deinterlace_frame_packed (GstDeinterlaceMethod *
   if (frame2)
     frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (frame2, 0));
 
-#define LINE(x,i) (((guint8*)GST_VIDEO_FRAME_PLANE_DATA((x),0)) + i * \
-    GST_VIDEO_FRAME_PLANE_STRIDE((x),0))
-
-  for (i = 0; i < frame_height; i++) {
-    memset (&scanlines, 0, sizeof (scanlines));
-    scanlines.bottom_field = (cur_field_flags == PICTURE_INTERLACED_BOTTOM);
-
-    if (!((i & 1) ^ scanlines.bottom_field)) {
-      /* copying */
-      scanlines.tp = get_line (&lg, -1, 0, i, -1);
-      scanlines.bp = get_line (&lg, -1, 0, i, 1);
-
-      scanlines.tt0 = get_line (&lg, 0, 0, i, -2);
-      scanlines.m0 = get_line (&lg, 0, 0, i, 0);
-      scanlines.bb0 = get_line (&lg, 0, 0, i, 2);
-
-      scanlines.t1 = get_line (&lg, 1, 0, i, -1);
-      scanlines.b1 = get_line (&lg, 1, 0, i, 1);
-
-      scanlines.tt2 = get_line (&lg, 2, 0, i, -2);
-      scanlines.m2 = get_line (&lg, 2, 0, i, 0);
-      scanlines.bb2 = get_line (&lg, 2, 0, i, 2);
-
-      self->copy_scanline_packed (self, LINE (outframe, i), &scanlines,
-          frame_width);
-    } else {
-      /* interpolating */
-      scanlines.tp2 = get_line (&lg, -2, 0, i, -1);
-      scanlines.bp2 = get_line (&lg, -2, 0, i, 1);
-
-      scanlines.ttp = get_line (&lg, -1, 0, i, -2);
-      scanlines.mp = get_line (&lg, -1, 0, i, 0);
-      scanlines.bbp = get_line (&lg, -1, 0, i, 2);
-
-      scanlines.t0 = get_line (&lg, 0, 0, i, -1);
-      scanlines.b0 = get_line (&lg, 0, 0, i, 1);
-
-      scanlines.tt1 = get_line (&lg, 1, 0, i, -2);
-      scanlines.m1 = get_line (&lg, 1, 0, i, 0);
-      scanlines.bb1 = get_line (&lg, 1, 0, i, 2);
-
-      scanlines.t2 = get_line (&lg, 2, 0, i, -1);
-      scanlines.b2 = get_line (&lg, 2, 0, i, 1);
-
-      self->interpolate_scanline_packed (self, LINE (outframe, i), &scanlines,
-          frame_width);
-    }
-#undef LINE
-  }
+  task.self = self;
+  task.dest = outframe;
+  task.lg = &lg;
+  task.cur_field_flags = history[cur_field_idx].flags;
+  task.n_planes = 1;
+  task.plane[0] = 0;
+  task.frame_width[0] = frame_width;
+  task.copy_scanline[0] = self->copy_scanline_packed;
+  task.interpolate_scanline[0] = self->interpolate_scanline_packed;
+
+  gst_deinterlace_simple_method_deinterlace_slices (self, &task);
 }
 
 static void
@@ -578,71 +852,18 @@ gst_deinterlace_simple_method_copy_scanline_planar_v (GstDeinterlaceSimpleMethod
 }
 
 static void
-    gst_deinterlace_simple_method_deinterlace_frame_planar_plane
-    (GstDeinterlaceSimpleMethod * self, GstVideoFrame * dest,
-    LinesGetter * lg,
-    guint cur_field_flags, gint plane,
+    gst_deinterlace_simple_method_setup_planar_plane
+    (DeinterlaceSliceTask * task, gint plane,
     GstDeinterlaceSimpleMethodFunction copy_scanline,
     GstDeinterlaceSimpleMethodFunction interpolate_scanline)
 {
-  GstDeinterlaceScanlineData scanlines;
-  gint i;
-  gint frame_height, frame_width;
-
-  frame_height = GST_VIDEO_FRAME_COMP_HEIGHT (dest, plane);
-  frame_width = GST_VIDEO_FRAME_COMP_WIDTH (dest, plane) *
-      GST_VIDEO_FRAME_COMP_PSTRIDE (dest, plane);
-
-  g_assert (interpolate_scanline != NULL);
-  g_assert (copy_scanline != NULL);
-
-#define LINE(x,i) (((guint8*)GST_VIDEO_FRAME_PLANE_DATA((x),plane)) + i * \
-    GST_VIDEO_FRAME_PLANE_STRIDE((x),plane))
-
-  for (i = 0; i < frame_height; i++) {
-    memset (&scanlines, 0, sizeof (scanlines));
-    scanlines.bottom_field = (cur_field_flags == PICTURE_INTERLACED_BOTTOM);
-
-    if (!((i & 1) ^ scanlines.bottom_field)) {
-      /* copying */
-      scanlines.tp = get_line (lg, -1, plane, i, -1);
-      scanlines.bp = get_line (lg, -1, plane, i, 1);
-
-      scanlines.tt0 = get_line (lg, 0, plane, i, -2);
-      scanlines.m0 = get_line (lg, 0, plane, i, 0);
-      scanlines.bb0 = get_line (lg, 0, plane, i, 2);
-
-      scanlines.t1 = get_line (lg, 1, plane, i, -1);
-      scanlines.b1 = get_line (lg, 1, plane, i, 1);
-
-      scanlines.tt2 = get_line (lg, 2, plane, i, -2);
-      scanlines.m2 = get_line (lg, 2, plane, i, 0);
-      scanlines.bb2 = get_line (lg, 2, plane, i, 2);
-
-      copy_scanline (self, LINE (dest, i), &scanlines, frame_width);
-    } else {
-      /* interpolating */
-      scanlines.tp2 = get_line (lg, -2, plane, i, -1);
-      scanlines.bp2 = get_line (lg, -2, plane, i, 1);
-
-      scanlines.ttp = get_line (lg, -1, plane, i, -2);
-      scanlines.mp = get_line (lg, -1, plane, i, 0);
-      scanlines.bbp = get_line (lg, -1, plane, i, 2);
-
-      scanlines.t0 = get_line (lg, 0, plane, i, -1);
-      scanlines.b0 = get_line (lg, 0, plane, i, 1);
-
-      scanlines.tt1 = get_line (lg, 1, plane, i, -2);
-      scanlines.m1 = get_line (lg, 1, plane, i, 0);
-      scanlines.bb1 = get_line (lg, 1, plane, i, 2);
+  guint i = task->n_planes++;
 
-      scanlines.t2 = get_line (lg, 2, plane, i, -1);
-      scanlines.b2 = get_line (lg, 2, plane, i, 1);
-
-      interpolate_scanline (self, LINE (dest, i), &scanlines, frame_width);
-    }
-#undef LINE
-  }
+  task->plane[i] = plane;
+  task->frame_width[i] = GST_VIDEO_FRAME_COMP_WIDTH (task->dest, plane) *
+      GST_VIDEO_FRAME_COMP_PSTRIDE (task->dest, plane);
+  task->copy_scanline[i] = copy_scanline;
+  task->interpolate_scanline[i] = interpolate_scanline;
 }
 
 static void
@@ -654,10 +875,8 @@ gst_deinterlace_simple_method_deinterlace_frame_planar (GstDeinterlaceMethod *
 #ifndef G_DISABLE_ASSERT
   GstDeinterlaceMethodClass *dm_class = GST_DEINTERLACE_METHOD_GET_CLASS (self);
 #endif
-  guint cur_field_flags = history[cur_field_idx].flags;
+  DeinterlaceSliceTask task = { 0, };
   gint i;
-  GstDeinterlaceSimpleMethodFunction copy_scanline;
-  GstDeinterlaceSimpleMethodFunction interpolate_scanline;
   LinesGetter lg = { history, history_count, cur_field_idx };
 
   g_assert (self->interpolate_scanline_planar[0] != NULL);
@@ -668,13 +887,17 @@ gst_deinterlace_simple_method_deinterlace_frame_planar (GstDeinterlaceMethod *
   g_assert (self->copy_scanline_planar[2] != NULL);
   g_assert (dm_class->fields_required <= 5);
 
-  for (i = 0; i < 3; i++) {
-    copy_scanline = self->copy_scanline_planar[i];
-    interpolate_scanline = self->interpolate_scanline_planar[i];
+  task.self = self;
+  task.dest = outframe;
+  task.lg = &lg;
+  task.cur_field_flags = history[cur_field_idx].flags;
 
-    gst_deinterlace_simple_method_deinterlace_frame_planar_plane (self,
-        outframe, &lg, cur_field_flags, i, copy_scanline, interpolate_scanline);
+  for (i = 0; i < 3; i++) {
+    gst_deinterlace_simple_method_setup_planar_plane (&task, i,
+        self->copy_scanline_planar[i], self->interpolate_scanline_planar[i]);
   }
+
+  gst_deinterlace_simple_method_deinterlace_slices (self, &task);
 }
 
 static void
@@ -686,7 +909,7 @@ gst_deinterlace_simple_method_deinterlace_frame_nv12 (GstDeinterlaceMethod *
 #ifndef G_DISABLE_ASSERT
   GstDeinterlaceMethodClass *dm_class = GST_DEINTERLACE_METHOD_GET_CLASS (self);
 #endif
-  guint cur_field_flags = history[cur_field_idx].flags;
+  DeinterlaceSliceTask task = { 0, };
   LinesGetter lg = { history, history_count, cur_field_idx, };
 
   /* Y plane is at position 0 */
@@ -696,13 +919,18 @@ gst_deinterlace_simple_method_deinterlace_frame_nv12 (GstDeinterlaceMethod *
   g_assert (self->copy_scanline_planar[0] != NULL);
   g_assert (dm_class->fields_required <= 5);
 
+  task.self = self;
+  task.dest = outframe;
+  task.lg = &lg;
+  task.cur_field_flags = history[cur_field_idx].flags;
+
   /* Y plane first, then UV/VU plane */
-  gst_deinterlace_simple_method_deinterlace_frame_planar_plane (self,
-      outframe, &lg, cur_field_flags, 0,
+  gst_deinterlace_simple_method_setup_planar_plane (&task, 0,
       self->copy_scanline_planar[0], self->interpolate_scanline_planar[0]);
-  gst_deinterlace_simple_method_deinterlace_frame_planar_plane (self,
-      outframe, &lg, cur_field_flags, 1,
+  gst_deinterlace_simple_method_setup_planar_plane (&task, 1,
       self->copy_scanline_packed, self->interpolate_scanline_packed);
+
+  gst_deinterlace_simple_method_deinterlace_slices (self, &task);
 }
 
 static void
@@ -58,6 +58,11 @@ typedef struct
   GstVideoCaptionMeta *caption;
 } GstDeinterlaceField;
 
+/* copied from video-converter.c */
+typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
+
+typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
+
 /*
  * This structure defines the deinterlacer plugin.
  */
@@ -72,6 +77,11 @@ struct _GstDeinterlaceMethod {
   GstVideoInfo *vinfo;
 
   GstDeinterlaceMethodDeinterlaceFunction deinterlace_frame;
+
+  /* Maximum number of slice threads (0 = auto), and the runner
+   * created for the current video info */
+  guint n_threads;
+  GstParallelizedTaskRunner *runner;
 };
 
 struct _GstDeinterlaceMethodClass {
@@ -115,6 +125,9 @@ void gst_deinterlace_method_deinterlace_frame (GstDeinterlaceMethod * self, cons
     int cur_field_idx);
 gint gst_deinterlace_method_get_fields_required (GstDeinterlaceMethod * self);
 gint gst_deinterlace_method_get_latency (GstDeinterlaceMethod * self);
+void gst_deinterlace_method_set_n_threads (GstDeinterlaceMethod * self, guint n_threads);
+guint gst_deinterlace_method_get_n_slices (GstDeinterlaceMethod * self);
+void gst_deinterlace_method_run_slices (GstDeinterlaceMethod * self, GstParallelizedTaskFunc func, gpointer * task_data);
 
 #define GST_TYPE_DEINTERLACE_SIMPLE_METHOD		(gst_deinterlace_simple_method_get_type ())
 #define GST_IS_DEINTERLACE_SIMPLE_METHOD(obj)		(G_TYPE_CHECK_INSTANCE_TYPE ((obj), GST_TYPE_DEINTERLACE_SIMPLE_METHOD))
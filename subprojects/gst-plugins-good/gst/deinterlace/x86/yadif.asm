@@ -29,8 +29,8 @@ SECTION_RODATA
 
 ; 16 bytes of value 1
 pb_1: times 16 db 1
-; 8 words of value 1
-pw_1: times  8 dw 1
+; 16 words of value 1
+pw_1: times 16 dw 1
 
 SECTION .text
 
@@ -49,8 +49,42 @@ SECTION .text
 %endif
 %endmacro
 
+; Spills to the stack, which is only guaranteed to be 16 bytes aligned
+%macro STK_MOV 2
+%if mmsize == 32
+    movu      %1, %2
+%else
+    mova      %1, %2
+%endif
+%endmacro
+
 %macro CHECK 2
 ; %1 = 1+j, %2 = 1-j
+%if mmsize == 32
+    ; work on words directly, byte shifts don't cross the 128 bit lanes
+    ; m2 = FFABS(t0[x-1+j] - b0[x-1-j])
+    LOAD      m2, [tzeroq+%1]
+    LOAD      m3, [bzeroq+%2]
+    psubw     m2, m3
+    pabsw     m2, m2
+    ; m5 = (t0[x+j] + b0[x-j]) >> 1
+    LOAD      m3, [tzeroq+%1+1]
+    LOAD      m4, [bzeroq+%2+1]
+    mova      m5, m3
+    paddw     m5, m4
+    psrlw     m5, 1
+    ; m2 += FFABS(t0[x+j] - b0[x-j])
+    psubw     m3, m4
+    pabsw     m3, m3
+    paddw     m2, m3
+    ; m2 += FFABS(t0[x+1+j] - b0[x+1-j])
+    LOAD      m3, [tzeroq+%1+2]
+    LOAD      m4, [bzeroq+%2+2]
+    psubw     m3, m4
+    pabsw     m3, m3
+    ; m2 = score
+    paddw     m2, m3
+%else
     ; m2 = t0[x+1+j]
     movu      m2, [tzeroq+%1]
     ; m3 = b0[x+1-j]
@@ -95,6 +129,7 @@ SECTION .text
     paddw     m2, m3
     ; m2 = score
     paddw     m2, m4
+%endif
 %endmacro
 
 %macro CHECK1 0
@@ -137,8 +172,12 @@ SECTION .text
 %endmacro
 
 %macro LOAD 2
+%if mmsize == 32
+    pmovzxbw  %1, %2
+%else
     movh      %1, %2
     punpcklbw %1, m7
+%endif
 %endmacro
 
 %macro FILTER_HEAD 0
@@ -159,9 +198,9 @@ SECTION .text
     ; m3 = d
     psraw        m3, 1
     ; rsp + 0 = d
-    mova   [rsp+ 0], m3
-    ; rsp + 16 = bzeroq
-    mova   [rsp+16], m1
+    STK_MOV [rsp+0*mmsize], m3
+    ; rsp + mmsize = bzeroq
+    STK_MOV [rsp+1*mmsize], m1
     ; m2 = m1 - mp
     psubw        m2, m4
     ; m2 = temporal_diff0 (m4 is temporary)
@@ -197,8 +236,8 @@ SECTION .text
     psrlw        m3, 1
     ; m2 = diff (for real)
     pmaxsw       m2, m3
-    ; rsp + 32 = diff
-    mova   [rsp+32], m2
+    ; rsp + 2 * mmsize = diff
+    STK_MOV [rsp+2*mmsize], m2
 
     ; m1 = e + c
     paddw        m1, m0
@@ -211,6 +250,18 @@ SECTION .text
     ; m0 = FFABS(c-e)
     ABS1         m0, m2
 
+%if mmsize == 32
+    ; m2 = FFABS(t0[x-1] - b0[x-1])
+    LOAD         m2, [tzeroq-1]
+    LOAD         m3, [bzeroq-1]
+    psubw        m2, m3
+    pabsw        m2, m2
+    ; m3 = FFABS(t0[x+1] - b0[x+1])
+    LOAD         m3, [tzeroq+1]
+    LOAD         m4, [bzeroq+1]
+    psubw        m3, m4
+    pabsw        m3, m3
+%else
     ; m2 = t0[x-1]
     ; if it's unpacked it should contain 4 bytes
     movu         m2, [tzeroq-1]
@@ -237,6 +288,7 @@ SECTION .text
     ; to prevent pixel spilling when adding
     punpcklbw    m2, m7
     punpcklbw    m3, m7
+%endif
     paddw        m0, m2
     paddw        m0, m3
     ; m0 = spatial_score
@@ -253,12 +305,12 @@ SECTION .text
     ; now m0 = spatial_score, m1 = spatial_pred
 
     ; m6 = diff
-    mova         m6, [rsp+32]
+    STK_MOV      m6, [rsp+2*mmsize]
 %endmacro
 
 %macro FILTER_TAIL 0
     ; m2 = d
-    mova         m2, [rsp]
+    STK_MOV      m2, [rsp]
     ; m3 = d
     mova         m3, m2
     ; m2 = d - diff
@@ -274,7 +326,13 @@ SECTION .text
     packuswb     m1, m1
 
     ; dst = spatial_pred
+%if mmsize == 32
+    ; packuswb works per 128 bit lane, gather both halves first
+    vpermq       m1, m1, q3120
+    movu     [dstq], xm1
+%else
     movh     [dstq], m1
+%endif
     ; half the register size
     add        dstq, mmsize/2
     add        tzeroq, mmsize/2
@@ -311,9 +369,9 @@ SECTION .text
     ; m4 = c
     LOAD         m4, [tzeroq]
     ; m5 = d
-    mova         m5, [rsp]
+    STK_MOV      m5, [rsp]
     ; m7 = e
-    mova         m7, [rsp+16]
+    STK_MOV      m7, [rsp+1*mmsize]
     ; m2 = b - c
     psubw        m2, m4
     ; m3 = f - e
@@ -384,7 +442,7 @@ SECTION .text
 ; src) into registers, uses one additional register (tmp) plus 7 vector
 ; registers (m0-m6) and allocates 0x40 bytes of stack space.
 %macro YADIF_MODE0 0
-cglobal yadif_filter_line_mode0, 13, 14, 8, 80, dst, tzero, bzero, mone, mp, \
+cglobal yadif_filter_line_mode0, 13, 14, 8, 3*mmsize+32, dst, tzero, bzero, mone, mp, \
                                         ttwo, btwo, tptwo, bptwo, ttone, \
                                         ttp, bbone, bbp, w
 
@@ -394,7 +452,7 @@ cglobal yadif_filter_line_mode0, 13, 14, 8, 80, dst, tzero, bzero, mone, mp, \
 %endmacro
 
 %macro YADIF_MODE2 0
-cglobal yadif_filter_line_mode2, 13, 14, 8, 80, dst, tzero, bzero, mone, mp, \
+cglobal yadif_filter_line_mode2, 13, 14, 8, 3*mmsize+32, dst, tzero, bzero, mone, mp, \
                                         ttwo, btwo, tptwo, bptwo, ttone, \
                                         ttp, bbone, bbp, w
 
@@ -403,7 +461,10 @@ cglobal yadif_filter_line_mode2, 13, 14, 8, 80, dst, tzero, bzero, mone, mp, \
     RET
 %endmacro
 
-; declares two functions for ssse3, and two for sse2
+; declares two functions each for avx2, ssse3 and sse2
+INIT_YMM avx2
+YADIF_MODE0
+YADIF_MODE2
 INIT_XMM ssse3
 YADIF_MODE0
 YADIF_MODE2
@@ -152,6 +152,24 @@ static void (*filter_mode0) (void *ORC_RESTRICT dst,
     const void *ORC_RESTRICT ttone, const void *ORC_RESTRICT ttp,
     const void *ORC_RESTRICT bbone, const void *ORC_RESTRICT bbp, int w);
 
+/* Kernels processing 16 pixels per iteration, only called on the part of
+ * the line that is a multiple of 16 pixels. NULL if not available */
+static void (*filter_mode2_wide) (void *ORC_RESTRICT dst,
+    const void *ORC_RESTRICT tzero, const void *ORC_RESTRICT bzero,
+    const void *ORC_RESTRICT mone, const void *ORC_RESTRICT mp,
+    const void *ORC_RESTRICT ttwo, const void *ORC_RESTRICT btwo,
+    const void *ORC_RESTRICT tptwo, const void *ORC_RESTRICT bptwo,
+    const void *ORC_RESTRICT ttone, const void *ORC_RESTRICT ttp,
+    const void *ORC_RESTRICT bbone, const void *ORC_RESTRICT bbp, int w);
+
+static void (*filter_mode0_wide) (void *ORC_RESTRICT dst,
+    const void *ORC_RESTRICT tzero, const void *ORC_RESTRICT bzero,
+    const void *ORC_RESTRICT mone, const void *ORC_RESTRICT mp,
+    const void *ORC_RESTRICT ttwo, const void *ORC_RESTRICT btwo,
+    const void *ORC_RESTRICT tptwo, const void *ORC_RESTRICT bptwo,
+    const void *ORC_RESTRICT ttone, const void *ORC_RESTRICT ttp,
+    const void *ORC_RESTRICT bbone, const void *ORC_RESTRICT bbp, int w);
+
 static void (*filter_mode2_16bits) (void *ORC_RESTRICT dst,
     const void *ORC_RESTRICT tzero, const void *ORC_RESTRICT bzero,
     const void *ORC_RESTRICT mone, const void *ORC_RESTRICT mp,
@@ -561,6 +579,7 @@ filter_scanline_yadif_planar (GstDeinterlaceSimpleMethod * self,
   const int bpp = 1;            // Hard code 8-bit atm
   int w = size / bpp;
   int edge = MAX_ALIGN / bpp;
+  int wide = 0;
   GstDeinterlaceScanlineData s = *s_orig;
 
   int mode = (s.tt1 == NULL || s.bb1 == NULL || s.ttp == NULL
@@ -580,16 +599,40 @@ filter_scanline_yadif_planar (GstDeinterlaceSimpleMethod * self,
 
   filter_edges (dst, s.t0, s.b0, s.m1, s.mp, s.t2, s.b2, s.tp2, s.bp2, s.tt1,
       s.ttp, s.bb1, s.bbp, w, 1, 0, mode, bpp);
+
+  if (filter_mode0_wide && w - edge >= 16) {
+    wide = (w - edge) & ~15;
+
+    if (mode == 0)
+      filter_mode0_wide (dst, (void *) s.t0, (void *) s.b0, (void *) s.m1,
+          (void *) s.mp, (void *) s.t2, (void *) s.b2, (void *) s.tp2,
+          (void *) s.bp2, (void *) s.tt1, (void *) s.ttp, (void *) s.bb1,
+          (void *) s.bbp, wide);
+    else
+      filter_mode2_wide (dst, (void *) s.t0, (void *) s.b0, (void *) s.m1,
+          (void *) s.mp, (void *) s.t2, (void *) s.b2, (void *) s.tp2,
+          (void *) s.bp2, (void *) s.tt1, (void *) s.ttp, (void *) s.bb1,
+          (void *) s.bbp, wide);
+
+    if (wide == w - edge)
+      return;
+  }
+
+  /* Remaining pixels, or the whole line if no wide kernel is available */
   if (mode == 0)
-    filter_mode0 (dst, (void *) s.t0, (void *) s.b0, (void *) s.m1,
-        (void *) s.mp, (void *) s.t2, (void *) s.b2, (void *) s.tp2,
-        (void *) s.bp2, (void *) s.tt1, (void *) s.ttp, (void *) s.bb1,
-        (void *) s.bbp, w - edge);
+    filter_mode0 (dst + wide, (void *) (s.t0 + wide), (void *) (s.b0 + wide),
+        (void *) (s.m1 + wide), (void *) (s.mp + wide),
+        (void *) (s.t2 + wide), (void *) (s.b2 + wide),
+        (void *) (s.tp2 + wide), (void *) (s.bp2 + wide),
+        (void *) (s.tt1 + wide), (void *) (s.ttp + wide),
+        (void *) (s.bb1 + wide), (void *) (s.bbp + wide), w - edge - wide);
   else
-    filter_mode2 (dst, (void *) s.t0, (void *) s.b0, (void *) s.m1,
-        (void *) s.mp, (void *) s.t2, (void *) s.b2, (void *) s.tp2,
-        (void *) s.bp2, (void *) s.tt1, (void *) s.ttp, (void *) s.bb1,
-        (void *) s.bbp, w - edge);
+    filter_mode2 (dst + wide, (void *) (s.t0 + wide), (void *) (s.b0 + wide),
+        (void *) (s.m1 + wide), (void *) (s.mp + wide),
+        (void *) (s.t2 + wide), (void *) (s.b2 + wide),
+        (void *) (s.tp2 + wide), (void *) (s.bp2 + wide),
+        (void *) (s.tt1 + wide), (void *) (s.ttp + wide),
+        (void *) (s.bb1 + wide), (void *) (s.bbp + wide), w - edge - wide);
 }
 
 ALWAYS_INLINE static void
@@ -634,8 +677,20 @@ filter_scanline_yadif_planar_16bits (GstDeinterlaceSimpleMethod * self,
 static void
 gst_deinterlace_method_yadif_init (GstDeinterlaceMethodYadif * self)
 {
+  filter_mode0_wide = NULL;
+  filter_mode2_wide = NULL;
+
   /* TODO: add asm support for high bitdepth */
 #if (defined __x86_64__ || defined _M_X64) && defined HAVE_NASM
+#if defined __GNUC__ || defined __clang__
+  /* GST_DEINTERLACE_DISABLE_AVX2 allows comparing against the SSE kernels */
+  if (__builtin_cpu_supports ("avx2")
+      && !g_getenv ("GST_DEINTERLACE_DISABLE_AVX2")) {
+    GST_DEBUG ("AVX2 optimization enabled");
+    filter_mode0_wide = gst_yadif_filter_line_mode0_avx2;
+    filter_mode2_wide = gst_yadif_filter_line_mode2_avx2;
+  }
+#endif
   if (
 #  if defined HAVE_ORC
       orc_sse_get_cpu_flags () & ORC_TARGET_SSE_SSSE3
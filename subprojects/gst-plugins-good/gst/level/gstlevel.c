@@ -100,8 +100,11 @@ enum
   PROP_PEAK_TTL,
   PROP_PEAK_FALLOFF,
   PROP_AUDIO_LEVEL_META,
+  PROP_VOLUME,
 };
 
+#define DEFAULT_VOLUME 1.0
+
 #define gst_level_parent_class parent_class
 G_DEFINE_TYPE (GstLevel, gst_level, GST_TYPE_BASE_TRANSFORM);
 GST_ELEMENT_REGISTER_DEFINE (level, "level", GST_RANK_NONE, GST_TYPE_LEVEL);
@@ -184,6 +187,19 @@ gst_level_class_init (GstLevelClass * klass)
       g_param_spec_boolean ("audio-level-meta", "Audio Level Meta",
           "Set GstAudioLevelMeta on buffers", FALSE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstLevel:volume:
+   *
+   * Volume factor applied to the samples before measuring them. Scaling
+   * happens in the same pass over the data as the level calculation, which
+   * is cheaper than a separate volume element in front of level.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_VOLUME,
+      g_param_spec_double ("volume", "Volume",
+          "Volume factor applied before measuring, 1.0=100%", 0.0, 10.0,
+          DEFAULT_VOLUME, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   GST_DEBUG_CATEGORY_INIT (level_debug, "level", 0, "Level calculation");
 
@@ -203,19 +219,21 @@ gst_level_class_init (GstLevelClass * klass)
 }
 
 static void
-configure_passthrough (GstLevel * self, gboolean audio_level_meta)
+configure_passthrough (GstLevel * self, gboolean audio_level_meta,
+    gdouble volume)
 {
-  /* can't use passthrough if audio-level-meta is enabled as we need a
-   * writable buffer to add the meta.
+  /* can't use passthrough if audio-level-meta is enabled or the volume is
+   * changed as we need a writable buffer to add the meta or scale the data.
    * gst_base_transform_set_passthrough() takes the object lock internally. */
   gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (self),
-      !audio_level_meta);
+      !audio_level_meta && volume == 1.0);
 }
 
 static void
 gst_level_init (GstLevel * filter)
 {
   filter->CS = NULL;
+  filter->block_CS = NULL;
   filter->peak = NULL;
   filter->last_peak = NULL;
   filter->decay_peak = NULL;
@@ -229,11 +247,12 @@ gst_level_init (GstLevel * filter)
   filter->decay_peak_falloff = 10.0;    /* dB falloff (/sec) */
 
   filter->post_messages = TRUE;
+  filter->volume = DEFAULT_VOLUME;
 
   filter->process = NULL;
 
   gst_base_transform_set_gap_aware (GST_BASE_TRANSFORM (filter), TRUE);
-  configure_passthrough (filter, filter->audio_level_meta);
+  configure_passthrough (filter, filter->audio_level_meta, filter->volume);
 }
 
 static void
@@ -242,6 +261,7 @@ gst_level_finalize (GObject * obj)
   GstLevel *filter = GST_LEVEL (obj);
 
   g_free (filter->CS);
+  g_free (filter->block_CS);
   g_free (filter->peak);
   g_free (filter->last_peak);
   g_free (filter->decay_peak);
@@ -249,6 +269,7 @@ gst_level_finalize (GObject * obj)
   g_free (filter->decay_peak_age);
 
   filter->CS = NULL;
+  filter->block_CS = NULL;
   filter->peak = NULL;
   filter->last_peak = NULL;
   filter->decay_peak = NULL;
@@ -285,12 +306,25 @@ gst_level_set_property (GObject * object, guint prop_id,
     case PROP_PEAK_FALLOFF:
       filter->decay_peak_falloff = g_value_get_double (value);
       break;
-    case PROP_AUDIO_LEVEL_META:
+    case PROP_AUDIO_LEVEL_META:{
+      gdouble volume = filter->volume;
+
       filter->audio_level_meta = g_value_get_boolean (value);
       GST_OBJECT_UNLOCK (filter);
-      configure_passthrough (filter, g_value_get_boolean (value));
+      configure_passthrough (filter, g_value_get_boolean (value), volume);
+      GST_OBJECT_LOCK (filter);
+      break;
+    }
+    case PROP_VOLUME:{
+      gboolean audio_level_meta = filter->audio_level_meta;
+
+      filter->volume = g_value_get_double (value);
+      GST_OBJECT_UNLOCK (filter);
+      configure_passthrough (filter, audio_level_meta,
+          g_value_get_double (value));
       GST_OBJECT_LOCK (filter);
       break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -325,6 +359,9 @@ gst_level_get_property (GObject * object, guint prop_id,
     case PROP_AUDIO_LEVEL_META:
       g_value_set_boolean (value, filter->audio_level_meta);
       break;
+    case PROP_VOLUME:
+      g_value_set_double (value, filter->volume);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -334,91 +371,95 @@ gst_level_get_property (GObject * object, guint prop_id,
 }
 
 
-/* process one (interleaved) channel of incoming samples
- * calculate square sum of samples
+/* process a block of interleaved samples
+ * calculate square sum of samples for each channel
  * normalize and average over number of samples
- * returns a normalized cumulative square value, which can be averaged
+ * returns normalized cumulative square values, which can be averaged
  * to return the average power as a double between 0 and 1
- * also returns the normalized peak power (square of the highest amplitude)
+ * also returns the normalized peak powers (square of the highest amplitude)
  *
  * caller must assure num is a multiple of channels
- * samples for multiple channels are interleaved
- * input sample data enters in *in_data and is not modified
+ * if gain is not 1.0, the samples are scaled in place first and the scaled
+ * samples are measured, so volume and level need only one pass over the data
  * this filter only accepts signed audio data, so mid level is always 0
  *
+ * all channels of a group are handled in the same pass over the data, with
+ * the sums in local arrays so they don't have to be reloaded for every
+ * sample
+ *
  * for integers, this code considers the non-existent positive max value to be
  * full-scale; so max-1 will not map to 1.0
  */
 
-#define DEFINE_INT_LEVEL_CALCULATOR(TYPE, RESOLUTION)                         \
-static void inline                                                            \
+#define LEVEL_CHANNEL_GROUP 8
+
+#define DEFINE_LEVEL_CALCULATOR(TYPE, NORMALIZER)                             \
+static void                                                                   \
 gst_level_calculate_##TYPE (gpointer data, guint num, guint channels,         \
-                            gdouble *NCS, gdouble *NPS)                       \
+                            gdouble gain, gdouble *NCS, gdouble *NPS)         \
 {                                                                             \
   TYPE * in = (TYPE *)data;                                                   \
-  register guint j;                                                           \
-  gdouble squaresum = 0.0;           /* square sum of the input samples */    \
-  register gdouble square = 0.0;     /* Square */                             \
-  register gdouble peaksquare = 0.0; /* Peak Square Sample */                 \
-  gdouble normalizer;                /* divisor to get a [-1.0, 1.0] range */ \
+  gdouble squaresum[LEVEL_CHANNEL_GROUP]; /* square sums of the samples */    \
+  gdouble peaksquare[LEVEL_CHANNEL_GROUP]; /* Peak Square Samples */          \
+  gdouble square;                                                             \
+  guint c, i, j, n;                                                           \
                                                                               \
-  /* *NCS = 0.0; Normalized Cumulative Square */                              \
-  /* *NPS = 0.0; Normalized Peak Square */                                    \
+  for (c = 0; c < channels; c += n) {                                         \
+    n = MIN (channels - c, LEVEL_CHANNEL_GROUP);                              \
+    for (j = 0; j < n; j++)                                                   \
+      squaresum[j] = peaksquare[j] = 0.0;                                     \
                                                                               \
-  for (j = 0; j < num; j += channels) {                                       \
-    square = ((gdouble) in[j]) * in[j];                                       \
-    if (square > peaksquare) peaksquare = square;                             \
-    squaresum += square;                                                      \
-  }                                                                           \
+    if (gain == 1.0) {                                                        \
+      for (i = c; i < num; i += channels) {                                   \
+        for (j = 0; j < n; j++) {                                             \
+          square = ((gdouble) in[i + j]) * in[i + j];                         \
+          if (square > peaksquare[j]) peaksquare[j] = square;                 \
+          squaresum[j] += square;                                             \
+        }                                                                     \
+      }                                                                       \
+    } else {                                                                  \
+      for (i = c; i < num; i += channels) {                                   \
+        for (j = 0; j < n; j++) {                                             \
+          in[i + j] = gst_level_scale_##TYPE (in[i + j], gain);               \
+          square = ((gdouble) in[i + j]) * in[i + j];                         \
+          if (square > peaksquare[j]) peaksquare[j] = square;                 \
+          squaresum[j] += square;                                             \
+        }                                                                     \
+      }                                                                       \
+    }                                                                         \
                                                                               \
-  normalizer = (gdouble) (G_GINT64_CONSTANT(1) << (RESOLUTION * 2));          \
-  *NCS = squaresum / normalizer;                                              \
-  *NPS = peaksquare / normalizer;                                             \
+    for (j = 0; j < n; j++) {                                                 \
+      NCS[c + j] = squaresum[j] / (NORMALIZER);                               \
+      NPS[c + j] = peaksquare[j] / (NORMALIZER);                              \
+    }                                                                         \
+  }                                                                           \
 }
 
-DEFINE_INT_LEVEL_CALCULATOR (gint32, 31);
-DEFINE_INT_LEVEL_CALCULATOR (gint16, 15);
-DEFINE_INT_LEVEL_CALCULATOR (gint8, 7);
+#define DEFINE_INT_LEVEL_CALCULATOR(TYPE, RESOLUTION, MIN_VAL, MAX_VAL)       \
+static inline TYPE                                                            \
+gst_level_scale_##TYPE (TYPE val, gdouble gain)                               \
+{                                                                             \
+  gdouble scaled = val * gain;                                                \
+  return (TYPE) CLAMP (scaled, MIN_VAL, MAX_VAL);                             \
+}                                                                             \
+DEFINE_LEVEL_CALCULATOR (TYPE,                                                \
+    (gdouble) (G_GINT64_CONSTANT(1) << (RESOLUTION * 2)))
+
+DEFINE_INT_LEVEL_CALCULATOR (gint32, 31, G_MININT32, G_MAXINT32);
+DEFINE_INT_LEVEL_CALCULATOR (gint16, 15, G_MININT16, G_MAXINT16);
+DEFINE_INT_LEVEL_CALCULATOR (gint8, 7, G_MININT8, G_MAXINT8);
 
-/* FIXME: use orc to calculate squaresums? */
 #define DEFINE_FLOAT_LEVEL_CALCULATOR(TYPE)                                   \
-static void inline                                                            \
-gst_level_calculate_##TYPE (gpointer data, guint num, guint channels,         \
-                            gdouble *NCS, gdouble *NPS)                       \
+static inline TYPE                                                            \
+gst_level_scale_##TYPE (TYPE val, gdouble gain)                               \
 {                                                                             \
-  TYPE * in = (TYPE *)data;                                                   \
-  register guint j;                                                           \
-  gdouble squaresum = 0.0;           /* square sum of the input samples */    \
-  register gdouble square = 0.0;     /* Square */                             \
-  register gdouble peaksquare = 0.0; /* Peak Square Sample */                 \
-                                                                              \
-  /* *NCS = 0.0; Normalized Cumulative Square */                              \
-  /* *NPS = 0.0; Normalized Peak Square */                                    \
-                                                                              \
-  /* orc_level_squaresum_f64(&squaresum,in,num); */                           \
-  for (j = 0; j < num; j += channels) {                                       \
-    square = ((gdouble) in[j]) * in[j];                                       \
-    if (square > peaksquare) peaksquare = square;                             \
-    squaresum += square;                                                      \
-  }                                                                           \
-                                                                              \
-  *NCS = squaresum;                                                           \
-  *NPS = peaksquare;                                                          \
-}
+  return (TYPE) (val * gain);                                                 \
+}                                                                             \
+DEFINE_LEVEL_CALCULATOR (TYPE, 1.0)
 
 DEFINE_FLOAT_LEVEL_CALCULATOR (gfloat);
 DEFINE_FLOAT_LEVEL_CALCULATOR (gdouble);
 
-/* we would need stride to deinterleave also
-static void inline
-gst_level_calculate_gdouble (gpointer data, guint num, guint channels,
-                            gdouble *NCS, gdouble *NPS)
-{
-  orc_level_squaresum_f64(NCS,(gdouble *)data,num);
-  *NPS = 0.0;
-}
-*/
-
 /* called with object lock */
 static void
 gst_level_recalc_interval_frames (GstLevel * level)
@@ -483,12 +524,14 @@ gst_level_set_caps (GstBaseTransform * trans, GstCaps * in, GstCaps * out)
 
   /* allocate channel variable arrays */
   g_free (filter->CS);
+  g_free (filter->block_CS);
   g_free (filter->peak);
   g_free (filter->last_peak);
   g_free (filter->decay_peak);
   g_free (filter->decay_peak_base);
   g_free (filter->decay_peak_age);
   filter->CS = g_new (gdouble, channels);
+  filter->block_CS = g_new (gdouble, channels);
   filter->peak = g_new (gdouble, channels);
   filter->last_peak = g_new (gdouble, channels);
   filter->decay_peak = g_new (gdouble, channels);
@@ -613,7 +656,7 @@ gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
   GstMapInfo map;
   guint8 *in_data;
   gsize in_size;
-  gdouble CS;
+  gdouble CS, gain;
   guint i;
   guint num_frames;
   guint num_int_samples = 0;    /* number of interleaved samples
@@ -630,7 +673,18 @@ gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
   bps = GST_AUDIO_INFO_BPS (&filter->info);
   rate = GST_AUDIO_INFO_RATE (&filter->info);
 
-  gst_buffer_map (in, &map, GST_MAP_READ);
+  GST_OBJECT_LOCK (filter);
+  gain = filter->volume;
+  GST_OBJECT_UNLOCK (filter);
+
+  /* the volume was just changed and this buffer still went through in
+   * passthrough mode, don't write into it */
+  if (gain != 1.0 && gst_base_transform_is_passthrough (trans))
+    gain = 1.0;
+
+  if (!gst_buffer_map (in, &map, gain != 1.0 ? GST_MAP_READWRITE :
+          GST_MAP_READ))
+    return GST_FLOW_ERROR;
   in_data = map.data;
   in_size = map.size;
 
@@ -657,10 +711,14 @@ gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
     block_size = MIN (block_size, num_frames);
     block_int_size = block_size * channels;
 
+    if (!GST_BUFFER_FLAG_IS_SET (in, GST_BUFFER_FLAG_GAP)) {
+      filter->process (in_data, block_int_size, channels, gain,
+          filter->block_CS, filter->peak);
+    }
+
     for (i = 0; i < channels; ++i) {
       if (!GST_BUFFER_FLAG_IS_SET (in, GST_BUFFER_FLAG_GAP)) {
-        filter->process (in_data + (bps * i), block_int_size, channels, &CS,
-            &filter->peak[i]);
+        CS = filter->block_CS[i];
         CS_tot += CS;
         GST_LOG_OBJECT (filter,
             "[%d]: cumulative squares %lf, over %d samples/%d channels",
@@ -62,6 +62,7 @@ struct _GstLevel {
   gdouble decay_peak_ttl;       /* time to live for peak in nanoseconds */
   gdouble decay_peak_falloff;   /* falloff in dB/sec */
   gboolean audio_level_meta; /* whether or not generate GstAudioLevelMeta */
+  gdouble volume;               /* volume factor applied before measuring */
 
   GstAudioInfo info;
   gint num_frames;              /* frame count (1 sample per channel)
@@ -71,13 +72,14 @@ struct _GstLevel {
 
   /* per-channel arrays for intermediate values */
   gdouble *CS;                  /* normalized Cumulative Square */
+  gdouble *block_CS;            /* normalized Cumulative Square of a block */
   gdouble *peak;                /* normalized Peak value over buffer */
   gdouble *last_peak;           /* last normalized Peak value over interval */
   gdouble *decay_peak;          /* running decaying normalized Peak */
   gdouble *decay_peak_base;     /* value of last peak we are decaying from */
   GstClockTime *decay_peak_age; /* age of last peak */
 
-  void (*process)(gpointer, guint, guint, gdouble*, gdouble*);
+  void (*process)(gpointer, guint, guint, gdouble, gdouble*, gdouble*);
 };
 
 struct _GstLevelClass {
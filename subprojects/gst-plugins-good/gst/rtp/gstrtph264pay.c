@@ -263,6 +263,7 @@ gst_rtp_h264_pay_finalize (GObject * object)
 
   g_object_unref (rtph264pay->adapter);
   gst_rtp_h264_pay_reset_bundle (rtph264pay);
+  g_clear_pointer (&rtph264pay->pending, gst_buffer_list_unref);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -873,6 +874,46 @@ gst_rtp_h264_pay_payload_nal_bundle (GstRTPBasePayload * basepayload,
     GstBuffer * paybuf, GstClockTime dts, GstClockTime pts, gboolean end_of_au,
     gboolean delta_unit, gboolean discont, guint8 nal_header);
 
+static GstFlowReturn
+gst_rtp_h264_pay_push_pending (GstRtpH264Pay * rtph264pay)
+{
+  GstBufferList *list = rtph264pay->pending;
+
+  if (list == NULL)
+    return GST_FLOW_OK;
+
+  rtph264pay->pending = NULL;
+
+  GST_LOG_OBJECT (rtph264pay, "pushing %u packets",
+      gst_buffer_list_length (list));
+
+  return gst_rtp_base_payload_push_list (GST_RTP_BASE_PAYLOAD (rtph264pay),
+      list);
+}
+
+/* Returns the list the packets with @pts are collected in, so that an access
+ * unit goes downstream as one buffer list instead of one push per NAL unit.
+ * The base class uses the timestamp of the first packet for the whole list,
+ * so the pending packets are pushed first if they have another timestamp. */
+static GstBufferList *
+gst_rtp_h264_pay_get_pending (GstRtpH264Pay * rtph264pay, GstClockTime pts,
+    GstFlowReturn * ret)
+{
+  *ret = GST_FLOW_OK;
+
+  if (rtph264pay->pending) {
+    GstBuffer *first = gst_buffer_list_get (rtph264pay->pending, 0);
+
+    if (GST_BUFFER_PTS (first) != pts)
+      *ret = gst_rtp_h264_pay_push_pending (rtph264pay);
+  }
+
+  if (rtph264pay->pending == NULL)
+    rtph264pay->pending = gst_buffer_list_new ();
+
+  return rtph264pay->pending;
+}
+
 static GstFlowReturn
 gst_rtp_h264_pay_send_sps_pps (GstRTPBasePayload * basepayload,
     GstClockTime dts, GstClockTime pts, gboolean delta_unit, gboolean discont)
@@ -1052,8 +1093,9 @@ gst_rtp_h264_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
   guint mtu, size, max_fragment_size, max_fragments, ii, pos;
   GstBuffer *outbuf;
   guint8 *payload;
-  GstBufferList *list = NULL;
+  GstBufferList *list;
   GstRTPBuffer rtp = { NULL };
+  GstFlowReturn ret;
 
   rtph264pay = GST_RTP_H264_PAY (basepayload);
   mtu = GST_RTP_BASE_PAYLOAD_MTU (rtph264pay);
@@ -1073,7 +1115,12 @@ gst_rtp_h264_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
   /* We keep 2 bytes for FU indicator and FU Header */
   max_fragment_size = gst_rtp_buffer_calc_payload_len (mtu - 2, 0, 0);
   max_fragments = (size + max_fragment_size - 2) / max_fragment_size;
-  list = gst_buffer_list_new_sized (max_fragments);
+
+  list = gst_rtp_h264_pay_get_pending (rtph264pay, pts, &ret);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (paybuf);
+    return ret;
+  }
 
   /* Start at the NALU payload */
   for (pos = 1, ii = 0; pos < size; pos += max_fragment_size, ii++) {
@@ -1137,10 +1184,10 @@ gst_rtp_h264_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
   }
 
   GST_DEBUG_OBJECT (rtph264pay,
-      "sending FU-A fragments: n=%u datasize=%u mtu=%u", ii, size, mtu);
+      "queued FU-A fragments: n=%u datasize=%u mtu=%u", ii, size, mtu);
 
   gst_buffer_unref (paybuf);
-  return gst_rtp_base_payload_push_list (basepayload, list);
+  return GST_FLOW_OK;
 }
 
 static GstFlowReturn
@@ -1150,7 +1197,9 @@ gst_rtp_h264_pay_payload_nal_single (GstRTPBasePayload * basepayload,
 {
   GstRtpH264Pay *rtph264pay;
   GstBuffer *outbuf;
+  GstBufferList *list;
   GstRTPBuffer rtp = { NULL };
+  GstFlowReturn ret;
 
   rtph264pay = GST_RTP_H264_PAY (basepayload);
 
@@ -1181,8 +1230,11 @@ gst_rtp_h264_pay_payload_nal_single (GstRTPBasePayload * basepayload,
   gst_rtp_copy_video_meta (rtph264pay, outbuf, paybuf);
   outbuf = gst_buffer_append (outbuf, paybuf);
 
-  /* push the buffer to the next element */
-  return gst_rtp_base_payload_push (basepayload, outbuf);
+  /* add the buffer to the list pushed at the end of the input buffer */
+  list = gst_rtp_h264_pay_get_pending (rtph264pay, pts, &ret);
+  gst_buffer_list_add (list, outbuf);
+
+  return ret;
 }
 
 static void
@@ -1697,6 +1749,11 @@ gst_rtp_h264_pay_handle_buffer (GstRTPBasePayload * basepayload,
     ret = gst_rtp_h264_pay_send_bundle (rtph264pay, FALSE);
   }
 
+  /* push everything payloaded from this buffer at once */
+  if (ret == GST_FLOW_OK)
+    ret = gst_rtp_h264_pay_push_pending (rtph264pay);
+  else
+    g_clear_pointer (&rtph264pay->pending, gst_buffer_list_unref);
 
 done:
   if (!avc) {
@@ -1726,6 +1783,7 @@ gst_rtp_h264_pay_sink_event (GstRTPBasePayload * payload, GstEvent * event)
     case GST_EVENT_FLUSH_STOP:
       gst_adapter_clear (rtph264pay->adapter);
       gst_rtp_h264_pay_reset_bundle (rtph264pay);
+      g_clear_pointer (&rtph264pay->pending, gst_buffer_list_unref);
       break;
     case GST_EVENT_CUSTOM_DOWNSTREAM:
       s = gst_event_get_structure (event);
@@ -1744,12 +1802,16 @@ gst_rtp_h264_pay_sink_event (GstRTPBasePayload * payload, GstEvent * event)
        */
       gst_rtp_h264_pay_handle_buffer (payload, NULL);
       ret = gst_rtp_h264_pay_send_bundle (rtph264pay, TRUE);
+      if (ret == GST_FLOW_OK)
+        ret = gst_rtp_h264_pay_push_pending (rtph264pay);
       break;
     }
     case GST_EVENT_STREAM_START:
       GST_DEBUG_OBJECT (rtph264pay, "New stream detected => Clear SPS and PPS");
       gst_rtp_h264_pay_clear_sps_pps (rtph264pay);
       ret = gst_rtp_h264_pay_send_bundle (rtph264pay, TRUE);
+      if (ret == GST_FLOW_OK)
+        ret = gst_rtp_h264_pay_push_pending (rtph264pay);
       break;
     default:
       break;
@@ -1774,6 +1836,7 @@ gst_rtp_h264_pay_change_state (GstElement * element, GstStateChange transition)
       rtph264pay->send_spspps = FALSE;
       gst_adapter_clear (rtph264pay->adapter);
       gst_rtp_h264_pay_reset_bundle (rtph264pay);
+      g_clear_pointer (&rtph264pay->pending, gst_buffer_list_unref);
       break;
     default:
       break;
@@ -95,6 +95,9 @@ struct _GstRtpH264Pay
   guint bundle_size;
   gboolean bundle_contains_vcl;
   GstRTPH264AggregateMode aggregate_mode;
+
+  /* packets of the current input buffer, pushed downstream as one list */
+  GstBufferList *pending;
 };
 
 struct _GstRtpH264PayClass
@@ -287,6 +287,7 @@ gst_rtp_h265_pay_finalize (GObject * object)
   g_object_unref (rtph265pay->adapter);
 
   gst_rtp_h265_pay_reset_bundle (rtph265pay);
+  g_clear_pointer (&rtph265pay->pending, gst_buffer_list_unref);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -958,6 +959,46 @@ static GstFlowReturn gst_rtp_h265_pay_payload_nal_bundle (GstRTPBasePayload *
     gboolean marker, gboolean delta_unit, guint8 nal_type,
     const guint8 * nal_header, int size);
 
+static GstFlowReturn
+gst_rtp_h265_pay_push_pending (GstRtpH265Pay * rtph265pay)
+{
+  GstBufferList *list = rtph265pay->pending;
+
+  if (list == NULL)
+    return GST_FLOW_OK;
+
+  rtph265pay->pending = NULL;
+
+  GST_LOG_OBJECT (rtph265pay, "pushing %u packets",
+      gst_buffer_list_length (list));
+
+  return gst_rtp_base_payload_push_list (GST_RTP_BASE_PAYLOAD (rtph265pay),
+      list);
+}
+
+/* Returns the list the packets with @pts are collected in, so that an access
+ * unit goes downstream as one buffer list instead of one push per NAL unit.
+ * The base class uses the timestamp of the first packet for the whole list,
+ * so the pending packets are pushed first if they have another timestamp. */
+static GstBufferList *
+gst_rtp_h265_pay_get_pending (GstRtpH265Pay * rtph265pay, GstClockTime pts,
+    GstFlowReturn * ret)
+{
+  *ret = GST_FLOW_OK;
+
+  if (rtph265pay->pending) {
+    GstBuffer *first = gst_buffer_list_get (rtph265pay->pending, 0);
+
+    if (GST_BUFFER_PTS (first) != pts)
+      *ret = gst_rtp_h265_pay_push_pending (rtph265pay);
+  }
+
+  if (rtph265pay->pending == NULL)
+    rtph265pay->pending = gst_buffer_list_new ();
+
+  return rtph265pay->pending;
+}
+
 static GstFlowReturn
 gst_rtp_h265_pay_send_vps_sps_pps (GstRTPBasePayload * basepayload,
     GstRtpH265Pay * rtph265pay, GstClockTime dts, GstClockTime pts,
@@ -1157,9 +1198,11 @@ gst_rtp_h265_pay_payload_nal_single (GstRTPBasePayload * basepayload,
     GstBuffer * paybuf, GstClockTime dts, GstClockTime pts, gboolean marker,
     gboolean delta_unit)
 {
+  GstRtpH265Pay *rtph265pay = (GstRtpH265Pay *) basepayload;
   GstBufferList *outlist;
   GstBuffer *outbuf;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstFlowReturn ret;
 
   /* use buffer lists
    * create buffer without payload containing only the RTP header
@@ -1183,15 +1226,13 @@ gst_rtp_h265_pay_payload_nal_single (GstRTPBasePayload * basepayload,
   gst_rtp_copy_video_meta (basepayload, outbuf, paybuf);
   outbuf = gst_buffer_append (outbuf, paybuf);
 
-  outlist = gst_buffer_list_new ();
+  gst_rtp_buffer_unmap (&rtp);
 
-  /* add the buffer to the buffer list */
+  /* add the buffer to the list pushed at the end of the input buffer */
+  outlist = gst_rtp_h265_pay_get_pending (rtph265pay, pts, &ret);
   gst_buffer_list_add (outlist, outbuf);
 
-  gst_rtp_buffer_unmap (&rtp);
-
-  /* push the list to the next element in the pipe */
-  return gst_rtp_base_payload_push_list (basepayload, outlist);
+  return ret;
 }
 
 static GstFlowReturn
@@ -1225,7 +1266,11 @@ gst_rtp_h265_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
   /* We keep 3 bytes for PayloadHdr and FU Header */
   max_fragment_size = gst_rtp_buffer_calc_payload_len (mtu - 3, 0, 0);
 
-  outlist = gst_buffer_list_new ();
+  outlist = gst_rtp_h265_pay_get_pending (rtph265pay, pts, &ret);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (paybuf);
+    return ret;
+  }
 
   for (pos = 2, ii = 0; pos < size; pos += max_fragment_size, ii++) {
     guint remaining, fragment_size;
@@ -1282,10 +1327,9 @@ gst_rtp_h265_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
     gst_buffer_list_add (outlist, outbuf);
   }
 
-  ret = gst_rtp_base_payload_push_list (basepayload, outlist);
   gst_buffer_unref (paybuf);
 
-  return ret;
+  return GST_FLOW_OK;
 }
 
 static GstFlowReturn
@@ -1773,6 +1817,12 @@ gst_rtp_h265_pay_handle_buffer (GstRTPBasePayload * basepayload,
     ret = gst_rtp_h265_pay_send_bundle (rtph265pay, FALSE);
   }
 
+  /* push everything payloaded from this buffer at once */
+  if (ret == GST_FLOW_OK)
+    ret = gst_rtp_h265_pay_push_pending (rtph265pay);
+  else
+    g_clear_pointer (&rtph265pay->pending, gst_buffer_list_unref);
+
 done:
   if (!hevc) {
     gst_adapter_unmap (rtph265pay->adapter);
@@ -1801,6 +1851,7 @@ gst_rtp_h265_pay_sink_event (GstRTPBasePayload * payload, GstEvent * event)
     case GST_EVENT_FLUSH_STOP:
       gst_adapter_clear (rtph265pay->adapter);
       gst_rtp_h265_pay_reset_bundle (rtph265pay);
+      g_clear_pointer (&rtph265pay->pending, gst_buffer_list_unref);
       break;
     case GST_EVENT_CUSTOM_DOWNSTREAM:
       s = gst_event_get_structure (event);
@@ -1819,6 +1870,8 @@ gst_rtp_h265_pay_sink_event (GstRTPBasePayload * payload, GstEvent * event)
        */
       gst_rtp_h265_pay_handle_buffer (payload, NULL);
       ret = gst_rtp_h265_pay_send_bundle (rtph265pay, TRUE);
+      if (ret == GST_FLOW_OK)
+        ret = gst_rtp_h265_pay_push_pending (rtph265pay);
 
       break;
     }
@@ -1850,6 +1903,7 @@ gst_rtp_h265_pay_change_state (GstElement * element, GstStateChange transition)
       rtph265pay->send_vps_sps_pps = FALSE;
       gst_adapter_clear (rtph265pay->adapter);
       gst_rtp_h265_pay_reset_bundle (rtph265pay);
+      g_clear_pointer (&rtph265pay->pending, gst_buffer_list_unref);
       break;
     default:
       break;
@@ -82,6 +82,9 @@ struct _GstRtpH265Pay
   gboolean bundle_contains_vcl_or_suffix;
   GstRTPH265AggregateMode aggregate_mode;
 
+  /* packets of the current input buffer, pushed downstream as one list */
+  GstBufferList *pending;
+
   guint8 profile_id;
   guint8 level_id;
   guint8 tier_flag;
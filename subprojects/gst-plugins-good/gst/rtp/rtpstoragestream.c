@@ -52,6 +52,21 @@ rtp_storage_item_compare (gconstpointer a, gconstpointer b, gpointer userdata)
   return 1;
 }
 
+/* Removes the oldest item. A newer duplicate of the same seq may own the
+ * index entry, which is kept then */
+static RtpStorageItem *
+rtp_storage_stream_pop_oldest (RtpStorageStream * stream)
+{
+  GList *link = stream->queue.tail;
+  RtpStorageItem *item = link->data;
+
+  if (g_hash_table_lookup (stream->links, GUINT_TO_POINTER (item->seq)) ==
+      link)
+    g_hash_table_remove (stream->links, GUINT_TO_POINTER (item->seq));
+
+  return g_queue_pop_tail (&stream->queue);
+}
+
 static void
 rtp_storage_stream_resize (RtpStorageStream * stream, GstClockTime size_time)
 {
@@ -75,7 +90,7 @@ rtp_storage_stream_resize (RtpStorageStream * stream, GstClockTime size_time)
   }
 
   for (i = 0; i < too_old_buffers_num; ++i) {
-    RtpStorageItem *item = g_queue_pop_tail (&stream->queue);
+    RtpStorageItem *item = rtp_storage_stream_pop_oldest (stream);
 
     GST_TRACE ("Removing %u/%u buffers, pt=%d seq=%d for ssrc=%08x",
         i, too_old_buffers_num, item->pt, item->seq, stream->ssrc);
@@ -126,7 +141,7 @@ rtp_storage_stream_resize_and_add_item (RtpStorageStream * stream,
    */
   if (rtp_storage_stream_get_seqnum_diff (stream) >= 32765 ||
       stream->queue.length > 10100) {
-    RtpStorageItem *item = g_queue_pop_tail (&stream->queue);
+    RtpStorageItem *item = rtp_storage_stream_pop_oldest (stream);
 
     GST_WARNING ("Queue too big, removing pt=%d seq=%d for ssrc=%08x",
         item->pt, item->seq, stream->ssrc);
@@ -153,6 +168,7 @@ rtp_storage_stream_new (guint32 ssrc)
   RtpStorageStream *ret = g_new0 (RtpStorageStream, 1);
   ret->max_arrival_time = GST_CLOCK_TIME_NONE;
   ret->ssrc = ssrc;
+  ret->links = g_hash_table_new (NULL, NULL);
   g_mutex_init (&ret->stream_lock);
   return ret;
 }
@@ -163,6 +179,7 @@ rtp_storage_stream_free (RtpStorageStream * stream)
   STREAM_LOCK (stream);
   while (stream->queue.length)
     rtp_storage_item_free (g_queue_pop_tail (&stream->queue));
+  g_hash_table_destroy (stream->links);
   STREAM_UNLOCK (stream);
   g_mutex_clear (&stream->stream_lock);
   g_free (stream);
@@ -177,10 +194,16 @@ rtp_storage_stream_add_item (RtpStorageStream * stream, GstBuffer * buffer,
       (GCompareFunc) rtp_storage_item_compare);
 
   g_queue_insert_before (&stream->queue, sibling, item);
+  g_hash_table_insert (stream->links, GUINT_TO_POINTER (seq),
+      sibling ? sibling->prev : stream->queue.tail);
 }
 
-GstBufferList *
-rtp_storage_stream_get_packets_for_recovery (RtpStorageStream * stream,
+/* Walks from @from towards newer packets, which must be the oldest packet or
+ * a media packet following a FEC packet, looking for the media stream chunk
+ * with FEC packets at the end, which could have the lost packet.
+ */
+static GstBufferList *
+rtp_storage_stream_collect_recovery (RtpStorageStream * stream, GList * from,
     guint8 pt_fec, guint16 lost_seq)
 {
   guint ret_length = 0;
@@ -189,20 +212,7 @@ rtp_storage_stream_get_packets_for_recovery (RtpStorageStream * stream,
   gboolean saw_fec = TRUE;      /* To initialize the start pointer in the loop below */
   GList *it;
 
-  /* Looking for media stream chunk with FEC packets at the end, which could
-   * can have the lost packet. For example:
-   *
-   *   |#10 FEC|  |#9 FEC|  |#8| ... |#6|  |#5 FEC|  |#4 FEC|  |#3 FEC|  |#2|  |#1|  |#0|
-   *
-   * Say @lost_seq = 7. Want to return bufferlist with packets [#6 : #10]. Other
-   * packets are not relevant for recovery of packet 7.
-   *
-   * Or the lost packet can be in the storage. In that case single packet is returned.
-   * It can happen if:
-   * - it could have arrived right after it was considered lost (more of a corner case)
-   * - it was recovered together with the other lost packet (most likely)
-   */
-  for (it = stream->queue.tail; it; it = it->prev) {
+  for (it = from; it; it = it->prev) {
     RtpStorageItem *item = it->data;
     gboolean found_end = FALSE;
 
@@ -258,18 +268,68 @@ rtp_storage_stream_get_packets_for_recovery (RtpStorageStream * stream,
   return NULL;
 }
 
+/* How far before the lost packet a stored packet is looked up to start the
+ * search from, instead of walking the whole storage */
+#define MAX_ANCHOR_DISTANCE 64
+
+GstBufferList *
+rtp_storage_stream_get_packets_for_recovery (RtpStorageStream * stream,
+    guint8 pt_fec, guint16 lost_seq)
+{
+  GList *it;
+  guint i;
+
+  /* Looking for media stream chunk with FEC packets at the end, which could
+   * can have the lost packet. For example:
+   *
+   *   |#10 FEC|  |#9 FEC|  |#8| ... |#6|  |#5 FEC|  |#4 FEC|  |#3 FEC|  |#2|  |#1|  |#0|
+   *
+   * Say @lost_seq = 7. Want to return bufferlist with packets [#6 : #10]. Other
+   * packets are not relevant for recovery of packet 7.
+   *
+   * Or the lost packet can be in the storage. In that case single packet is returned.
+   * It can happen if:
+   * - it could have arrived right after it was considered lost (more of a corner case)
+   * - it was recovered together with the other lost packet (most likely)
+   */
+  it = g_hash_table_lookup (stream->links, GUINT_TO_POINTER (lost_seq));
+  if (it)
+    return rtp_storage_stream_collect_recovery (stream, it, pt_fec, lost_seq);
+
+  /* Find a packet shortly before the lost one and go back to the start of
+   * its media chunk, nothing older is relevant */
+  for (i = 1; i <= MAX_ANCHOR_DISTANCE; i++) {
+    it = g_hash_table_lookup (stream->links,
+        GUINT_TO_POINTER ((guint16) (lost_seq - i)));
+    if (it)
+      break;
+  }
+
+  for (; it; it = it->next) {
+    RtpStorageItem *item = it->data;
+
+    if (item->pt != pt_fec && (it->next == NULL ||
+            ((RtpStorageItem *) it->next->data)->pt == pt_fec))
+      break;
+  }
+
+  return rtp_storage_stream_collect_recovery (stream,
+      it ? it : stream->queue.tail, pt_fec, lost_seq);
+}
+
 GstBuffer *
 rtp_storage_stream_get_redundant_packet (RtpStorageStream * stream,
     guint16 lost_seq)
 {
   GList *it;
-  for (it = stream->queue.head; it; it = it->next) {
+
+  it = g_hash_table_lookup (stream->links, GUINT_TO_POINTER (lost_seq));
+  if (it) {
     RtpStorageItem *item = it->data;
-    if (item->seq == lost_seq) {
-      GST_LOG ("Found buffer pt=%u seq=%u for ssrc=%08x %" GST_PTR_FORMAT,
-          item->pt, item->seq, stream->ssrc, item->buffer);
-      return gst_buffer_ref (item->buffer);
-    }
+
+    GST_LOG ("Found buffer pt=%u seq=%u for ssrc=%08x %" GST_PTR_FORMAT,
+        item->pt, item->seq, stream->ssrc, item->buffer);
+    return gst_buffer_ref (item->buffer);
   }
   GST_DEBUG ("Could not find packet with seq=%u for ssrc=%08x",
       lost_seq, stream->ssrc);
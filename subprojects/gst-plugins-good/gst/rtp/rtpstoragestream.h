@@ -33,6 +33,8 @@ typedef struct {
 
 typedef struct {
   GQueue queue;
+  /* seq -> GList link in queue */
+  GHashTable *links;
   GMutex stream_lock;
   guint32 ssrc;
   GstClockTime max_arrival_time;
@@ -280,6 +280,12 @@ struct _GstRtpBinPrivate
 
   /* list of extra elements */
   GList *elements;
+
+  /* GstRtpBinSession by id */
+  GHashTable *sessions_by_id;
+  /* GstRtpBinClient by CNAME, and the client of the streams without one */
+  GHashTable *clients_by_cname;
+  GstRtpBinClient *no_cname_client;
 };
 
 /* signals and args */
@@ -502,6 +508,9 @@ struct _GstRtpBinStream
   /* Smoothing of ts-offset adjustments */
   gint64 avg_ts_offset;
   gboolean is_initialized;
+
+  /* the GstRtpBinClient(s) this stream is associated with */
+  GSList *clients;
 };
 
 #define GST_RTP_SESSION_LOCK(sess)   g_mutex_lock (&(sess)->lock)
@@ -538,6 +547,8 @@ struct _GstRtpBinSession
 
   /* list of GstRtpBinStream */
   GSList *streams;
+  /* GstRtpBinStream by SSRC */
+  GHashTable *streams_by_ssrc;
 
   /* list of elements */
   GSList *elements;
@@ -586,15 +597,8 @@ struct _GstRtpBinClient
 static GstRtpBinSession *
 find_session_by_id (GstRtpBin * rtpbin, gint id)
 {
-  GSList *walk;
-
-  for (walk = rtpbin->sessions; walk; walk = g_slist_next (walk)) {
-    GstRtpBinSession *sess = (GstRtpBinSession *) walk->data;
-
-    if (sess->id == id)
-      return sess;
-  }
-  return NULL;
+  return g_hash_table_lookup (rtpbin->priv->sessions_by_id,
+      GINT_TO_POINTER (id));
 }
 
 static gboolean
@@ -603,19 +607,38 @@ pad_is_recv_fec (GstRtpBinSession * session, GstPad * pad)
   return g_slist_find (session->recv_fec_sink_ghosts, pad) != NULL;
 }
 
+/* check if the request pad belongs to the session */
+static gboolean
+session_has_pad (GstRtpBinSession * sess, GstPad * pad)
+{
+  return (sess->recv_rtp_sink_ghost == pad) ||
+      (sess->recv_rtcp_sink_ghost == pad) ||
+      (sess->send_rtp_sink_ghost == pad) ||
+      (sess->send_rtcp_src_ghost == pad) || pad_is_recv_fec (sess, pad);
+}
+
 /* find a session with the given request pad. Must be called with RTP_BIN_LOCK */
 static GstRtpBinSession *
 find_session_by_pad (GstRtpBin * rtpbin, GstPad * pad)
 {
+  GstRtpBinSession *sess;
+  const gchar *name, *num;
   GSList *walk;
 
+  /* the request pads are named after the templates, with the session id as
+   * first number */
+  name = GST_PAD_NAME (pad);
+  num = name + strcspn (name, "0123456789");
+  if (*num != '\0') {
+    sess = find_session_by_id (rtpbin, (gint) g_ascii_strtoll (num, NULL, 10));
+    if (sess && session_has_pad (sess, pad))
+      return sess;
+  }
+
   for (walk = rtpbin->sessions; walk; walk = g_slist_next (walk)) {
-    GstRtpBinSession *sess = (GstRtpBinSession *) walk->data;
+    sess = (GstRtpBinSession *) walk->data;
 
-    if ((sess->recv_rtp_sink_ghost == pad) ||
-        (sess->recv_rtcp_sink_ghost == pad) ||
-        (sess->send_rtp_sink_ghost == pad) ||
-        (sess->send_rtcp_src_ghost == pad) || pad_is_recv_fec (sess, pad))
+    if (session_has_pad (sess, pad))
       return sess;
   }
   return NULL;
@@ -716,15 +739,8 @@ on_sender_ssrc_active (GstElement * session, guint32 ssrc,
 static GstRtpBinStream *
 find_stream_by_ssrc (GstRtpBinSession * session, guint32 ssrc)
 {
-  GSList *walk;
-
-  for (walk = session->streams; walk; walk = g_slist_next (walk)) {
-    GstRtpBinStream *stream = (GstRtpBinStream *) walk->data;
-
-    if (stream->ssrc == ssrc)
-      return stream;
-  }
-  return NULL;
+  return g_hash_table_lookup (session->streams_by_ssrc,
+      GUINT_TO_POINTER (ssrc));
 }
 
 static void
@@ -739,8 +755,10 @@ ssrc_demux_pad_removed (GstElement * element, guint ssrc, GstPad * pad,
   GST_RTP_BIN_LOCK (rtpbin);
 
   GST_RTP_SESSION_LOCK (session);
-  if ((stream = find_stream_by_ssrc (session, ssrc)))
+  if ((stream = find_stream_by_ssrc (session, ssrc))) {
     session->streams = g_slist_remove (session->streams, stream);
+    g_hash_table_remove (session->streams_by_ssrc, GUINT_TO_POINTER (ssrc));
+  }
   GST_RTP_SESSION_UNLOCK (session);
 
   if (stream)
@@ -783,7 +801,10 @@ create_session (GstRtpBin * rtpbin, gint id)
 
   sess->ptmap = g_hash_table_new_full (NULL, NULL, NULL,
       (GDestroyNotify) gst_caps_unref);
+  sess->streams_by_ssrc = g_hash_table_new (NULL, NULL);
   rtpbin->sessions = g_slist_prepend (rtpbin->sessions, sess);
+  g_hash_table_insert (rtpbin->priv->sessions_by_id, GINT_TO_POINTER (id),
+      sess);
 
   /* configure SDES items */
   GST_OBJECT_LOCK (rtpbin);
@@ -933,6 +954,8 @@ free_session (GstRtpBinSession * sess, GstRtpBin * bin)
 {
   GST_DEBUG_OBJECT (bin, "freeing session %p", sess);
 
+  g_hash_table_remove (bin->priv->sessions_by_id, GINT_TO_POINTER (sess->id));
+
   gst_element_set_locked_state (sess->demux, TRUE);
   gst_element_set_locked_state (sess->session, TRUE);
   gst_element_set_locked_state (sess->storage, TRUE);
@@ -958,6 +981,7 @@ free_session (GstRtpBinSession * sess, GstRtpBin * bin)
 
   g_slist_foreach (sess->streams, (GFunc) free_stream, bin);
   g_slist_free (sess->streams);
+  g_hash_table_destroy (sess->streams_by_ssrc);
 
   g_mutex_clear (&sess->lock);
   g_hash_table_destroy (sess->ptmap);
@@ -1273,11 +1297,15 @@ gst_rtp_bin_propagate_property_to_session (GstRtpBin * bin,
 static GstRtpBinClient *
 get_client (GstRtpBin * bin, guint8 len, const guint8 * data)
 {
+  GstRtpBinPrivate *priv = bin->priv;
   GstRtpBinClient *result = NULL;
-  GSList *walk;
+  gchar *cname;
 
-  for (walk = bin->clients; walk; walk = g_slist_next (walk)) {
-    GstRtpBinClient *client = (GstRtpBinClient *) walk->data;
+  if (len == 0) {
+    result = priv->no_cname_client;
+  } else {
+    cname = g_strndup ((gchar *) data, len);
+    result = g_hash_table_lookup (priv->clients_by_cname, cname);
 
     /* In case of RTSP this can be called without a CNAME first, in which case
      * we assume that all streams belong to the same client.
@@ -1287,34 +1315,36 @@ get_client (GstRtpBin * bin, guint8 len, const guint8 * data)
      *
      * All streams are directly moved over to the new client.
      */
-    if (client->cname_len == 0 && len != 0) {
-      result = client;
+    if (result == NULL && priv->no_cname_client) {
+      result = priv->no_cname_client;
+      priv->no_cname_client = NULL;
       g_free (result->cname);
-      result->cname = g_strndup ((gchar *) data, len);
+      result->cname = cname;
       result->cname_len = len;
-      break;
-    }
-
-    if (len != client->cname_len)
-      continue;
-
-    if (len == 0 || !strncmp ((gchar *) data, client->cname, client->cname_len)) {
-      GST_DEBUG_OBJECT (bin, "found existing client %p with CNAME %s", client,
-          GST_STR_NULL (client->cname));
-      result = client;
-      break;
+      g_hash_table_insert (priv->clients_by_cname, result->cname, result);
+      return result;
     }
+    g_free (cname);
   }
 
-  /* nothing found, create one */
-  if (result == NULL) {
-    result = g_new0 (GstRtpBinClient, 1);
-    result->cname = g_strndup ((gchar *) data, len);
-    result->cname_len = len;
-    bin->clients = g_slist_prepend (bin->clients, result);
-    GST_DEBUG_OBJECT (bin, "created new client %p with CNAME %s", result,
+  if (result) {
+    GST_DEBUG_OBJECT (bin, "found existing client %p with CNAME %s", result,
         GST_STR_NULL (result->cname));
+    return result;
   }
+
+  /* nothing found, create one */
+  result = g_new0 (GstRtpBinClient, 1);
+  result->cname = g_strndup ((gchar *) data, len);
+  result->cname_len = len;
+  bin->clients = g_slist_prepend (bin->clients, result);
+  if (len == 0)
+    priv->no_cname_client = result;
+  else
+    g_hash_table_insert (priv->clients_by_cname, result->cname, result);
+  GST_DEBUG_OBJECT (bin, "created new client %p with CNAME %s", result,
+      GST_STR_NULL (result->cname));
+
   return result;
 }
 
@@ -1322,6 +1352,10 @@ static void
 free_client (GstRtpBinClient * client, GstRtpBin * bin)
 {
   GST_DEBUG_OBJECT (bin, "freeing client %p", client);
+  if (bin->priv->no_cname_client == client)
+    bin->priv->no_cname_client = NULL;
+  else
+    g_hash_table_remove (bin->priv->clients_by_cname, client->cname);
   g_slist_free (client->streams);
   g_free (client->cname);
   g_free (client);
@@ -1613,22 +1647,17 @@ gst_rtp_bin_associate (GstRtpBin * bin, GstRtpBinStream * stream,
   /* first find or create the CNAME */
   GstRtpBinClient *client = get_client (bin, len, data);
 
-  /* find stream in the client */
   GSList *walk;
-  for (walk = client->streams; walk; walk = g_slist_next (walk)) {
-    GstRtpBinStream *ostream = (GstRtpBinStream *) walk->data;
 
-    if (ostream == stream)
-      break;
-  }
-
-  /* not found, add it to the list */
-  if (walk == NULL) {
+  /* check the clients of the stream, which are usually only one, instead of
+   * the streams of the client. If not found, add it to the list */
+  if (!g_slist_find (stream->clients, client)) {
     GST_DEBUG_OBJECT (bin,
         "new association of SSRC %08x with client %p with CNAME %s",
         stream->ssrc, client, GST_STR_NULL (client->cname));
     client->streams = g_slist_prepend (client->streams, stream);
     client->nstreams++;
+    stream->clients = g_slist_prepend (stream->clients, client);
   } else {
     GST_DEBUG_OBJECT (bin,
         "found association of SSRC %08x with client %p with CNAME %s",
@@ -2135,7 +2164,7 @@ create_stream (GstRtpBinSession * session, guint32 ssrc)
 
   rtpbin = session->bin;
 
-  if (g_slist_length (session->streams) >= rtpbin->max_streams)
+  if (g_hash_table_size (session->streams_by_ssrc) >= rtpbin->max_streams)
     goto max_streams;
 
   if (!(buffer =
@@ -2168,6 +2197,8 @@ create_stream (GstRtpBinSession * session, guint32 ssrc)
   stream->percent = 100;
 
   session->streams = g_slist_prepend (session->streams, stream);
+  g_hash_table_insert (session->streams_by_ssrc, GUINT_TO_POINTER (ssrc),
+      stream);
 
   jb_class = G_OBJECT_GET_CLASS (G_OBJECT (buffer));
 
@@ -2273,7 +2304,7 @@ static void
 free_stream (GstRtpBinStream * stream, GstRtpBin * bin)
 {
   GstRtpBinSession *sess = stream->session;
-  GSList *clients, *next_client;
+  GSList *clients;
 
   GST_DEBUG_OBJECT (bin, "freeing stream %p", stream);
 
@@ -2306,29 +2337,18 @@ free_stream (GstRtpBinStream * stream, GstRtpBin * bin)
   if (stream->demux)
     gst_bin_remove (GST_BIN_CAST (bin), stream->demux);
 
-  for (clients = bin->clients; clients; clients = next_client) {
+  for (clients = stream->clients; clients; clients = g_slist_next (clients)) {
     GstRtpBinClient *client = (GstRtpBinClient *) clients->data;
-    GSList *streams, *next_stream;
-
-    next_client = g_slist_next (clients);
 
-    for (streams = client->streams; streams; streams = next_stream) {
-      GstRtpBinStream *ostream = (GstRtpBinStream *) streams->data;
-
-      next_stream = g_slist_next (streams);
-
-      if (ostream == stream) {
-        client->streams = g_slist_delete_link (client->streams, streams);
-        /* If this was the last stream belonging to this client,
-         * clean up the client. */
-        if (--client->nstreams == 0) {
-          bin->clients = g_slist_delete_link (bin->clients, clients);
-          free_client (client, bin);
-          break;
-        }
-      }
+    client->streams = g_slist_remove (client->streams, stream);
+    /* If this was the last stream belonging to this client,
+     * clean up the client. */
+    if (--client->nstreams == 0) {
+      bin->clients = g_slist_remove (bin->clients, client);
+      free_client (client, bin);
     }
   }
+  g_slist_free (stream->clients);
   g_free (stream);
 }
 
@@ -3302,6 +3322,8 @@ gst_rtp_bin_init (GstRtpBin * rtpbin)
   rtpbin->priv = gst_rtp_bin_get_instance_private (rtpbin);
   g_mutex_init (&rtpbin->priv->bin_lock);
   g_mutex_init (&rtpbin->priv->dyn_lock);
+  rtpbin->priv->sessions_by_id = g_hash_table_new (NULL, NULL);
+  rtpbin->priv->clients_by_cname = g_hash_table_new (g_str_hash, g_str_equal);
 
   rtpbin->latency_ms = DEFAULT_LATENCY_MS;
   rtpbin->latency_ns = DEFAULT_LATENCY_MS * GST_MSECOND;
@@ -3378,6 +3400,9 @@ gst_rtp_bin_finalize (GObject * object)
   if (rtpbin->fec_encoders)
     gst_structure_free (rtpbin->fec_encoders);
 
+  g_hash_table_destroy (rtpbin->priv->sessions_by_id);
+  g_hash_table_destroy (rtpbin->priv->clients_by_cname);
+
   g_mutex_clear (&rtpbin->priv->bin_lock);
   g_mutex_clear (&rtpbin->priv->dyn_lock);
 
@@ -161,6 +161,7 @@ enum
 #define DEFAULT_RFC7273_USE_SYSTEM_CLOCK FALSE
 #define DEFAULT_RFC7273_REFERENCE_TIMESTAMP_META_ONLY FALSE
 #define DEFAULT_MIN_SYNC_INTERVAL 15000
+#define DEFAULT_SHARED_TIMERS     FALSE
 
 #define DEFAULT_AUTO_RTX_DELAY (20 * GST_MSECOND)
 #define DEFAULT_AUTO_RTX_TIMEOUT (40 * GST_MSECOND)
@@ -199,6 +200,7 @@ enum
   PROP_RFC7273_USE_SYSTEM_CLOCK,
   PROP_RFC7273_REFERENCE_TIMESTAMP_META_ONLY,
   PROP_MIN_SYNC_INTERVAL,
+  PROP_SHARED_TIMERS,
 };
 
 #define JBUF_LOCK(priv)   G_STMT_START {			\
@@ -316,6 +318,11 @@ struct _GstRtpJitterBufferPrivate
 
   gboolean timer_running;
   GThread *timer_thread;
+  /* with shared-timers, the timers are handled by jobs on the shared timer
+   * pool instead of timer_thread */
+  gboolean use_shared_timers;
+  gboolean timer_job_active;
+  gboolean timer_job_rerun;
 
   /* properties */
   guint latency_ms;
@@ -345,6 +352,7 @@ struct _GstRtpJitterBufferPrivate
   guint sync_interval;
   gboolean rfc7273_use_system_clock;
   gboolean rfc7273_reference_timestamp_meta_only;
+  gboolean shared_timers;
   guint min_sync_interval;
 
   /* Reference for GstReferenceTimestampMeta */
@@ -607,6 +615,7 @@ static void do_handle_sync_rtp_info (GstRtpJitterBuffer * jitterbuffer,
 static void unschedule_current_timer (GstRtpJitterBuffer * jitterbuffer);
 
 static void wait_next_timeout (GstRtpJitterBuffer * jitterbuffer);
+static void shared_timer_kick (GstRtpJitterBuffer * jitterbuffer);
 
 static GstStructure *gst_rtp_jitter_buffer_create_stats (GstRtpJitterBuffer *
     jitterbuffer);
@@ -1090,6 +1099,24 @@ gst_rtp_jitter_buffer_class_init (GstRtpJitterBufferClass * klass)
           0, G_MAXUINT, DEFAULT_MIN_SYNC_INTERVAL,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRtpJitterBuffer:shared-timers:
+   *
+   * Instead of running a timer thread per element, wait for the timers with
+   * asynchronous clock waits and handle them on a thread pool that is shared
+   * by all jitterbuffers of the process. This scales better when running
+   * many jitterbuffers, e.g. in an SFU or a recorder with many streams.
+   *
+   * Only takes effect when changing from READY to PAUSED.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_SHARED_TIMERS,
+      g_param_spec_boolean ("shared-timers", "Shared timers",
+          "Handle timers on a process-wide thread pool instead of a "
+          "thread per element", DEFAULT_SHARED_TIMERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstRtpJitterBuffer::request-pt-map:
    * @buffer: the object which received the signal
@@ -1225,6 +1252,7 @@ gst_rtp_jitter_buffer_init (GstRtpJitterBuffer * jitterbuffer)
   priv->rfc7273_reference_timestamp_meta_only =
       DEFAULT_RFC7273_REFERENCE_TIMESTAMP_META_ONLY;
   priv->min_sync_interval = DEFAULT_MIN_SYNC_INTERVAL;
+  priv->shared_timers = DEFAULT_SHARED_TIMERS;
 
   priv->ts_offset_remainder = 0;
   priv->last_dts = -1;
@@ -1982,8 +2010,10 @@ gst_rtp_jitter_buffer_change_state (GstElement * element,
       priv->blocked = TRUE;
       priv->timer_running = TRUE;
       priv->srcresult = GST_FLOW_OK;
-      priv->timer_thread =
-          g_thread_new ("timer", (GThreadFunc) wait_next_timeout, jitterbuffer);
+      priv->use_shared_timers = priv->shared_timers;
+      if (!priv->use_shared_timers)
+        priv->timer_thread = g_thread_new ("timer",
+            (GThreadFunc) wait_next_timeout, jitterbuffer);
       JBUF_UNLOCK (priv);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
@@ -1992,6 +2022,8 @@ gst_rtp_jitter_buffer_change_state (GstElement * element,
       priv->blocked = FALSE;
       JBUF_SIGNAL_EVENT (priv);
       JBUF_SIGNAL_TIMER (priv);
+      if (priv->use_shared_timers)
+        shared_timer_kick (jitterbuffer);
       JBUF_UNLOCK (priv);
       break;
     default:
@@ -2025,9 +2057,14 @@ gst_rtp_jitter_buffer_change_state (GstElement * element,
       JBUF_SIGNAL_TIMER (priv);
       JBUF_SIGNAL_QUERY (priv, FALSE);
       JBUF_SIGNAL_QUEUE (priv);
+      /* wait for a queued or running timer job to notice we are stopping */
+      while (priv->timer_job_active)
+        JBUF_WAIT_TIMER (priv);
       JBUF_UNLOCK (priv);
-      g_thread_join (priv->timer_thread);
-      priv->timer_thread = NULL;
+      if (priv->timer_thread) {
+        g_thread_join (priv->timer_thread);
+        priv->timer_thread = NULL;
+      }
       gst_clear_caps (&priv->reference_timestamp_caps);
       g_list_free_full (priv->cname_ssrc_mappings,
           (GDestroyNotify) cname_ssrc_mapping_free);
@@ -2484,8 +2521,15 @@ unschedule_current_timer (GstRtpJitterBuffer * jitterbuffer)
   if (priv->clock_id) {
     GST_DEBUG_OBJECT (jitterbuffer, "unschedule current timer");
     gst_clock_id_unschedule (priv->clock_id);
+    /* with shared timers, nobody is blocked on the clock id and the next
+     * timer job reschedules it */
+    if (priv->use_shared_timers)
+      gst_clock_id_unref (priv->clock_id);
     priv->clock_id = NULL;
   }
+
+  if (priv->use_shared_timers)
+    shared_timer_kick (jitterbuffer);
 }
 
 static void
@@ -2510,6 +2554,8 @@ update_current_timer (GstRtpJitterBuffer * jitterbuffer)
 
   /* wakeup the timer thread in case the timer queue was empty */
   JBUF_SIGNAL_TIMER (priv);
+  if (priv->use_shared_timers && priv->clock_id == NULL)
+    shared_timer_kick (jitterbuffer);
 
   /* no need to wait if the current wait is earlier or later */
   if (timer->timeout != -1 && timer->timeout >= priv->timer_timeout)
@@ -4647,6 +4693,177 @@ stopping:
   return;
 }
 
+/* With shared-timers, the timer queue is not serviced by a thread per
+ * element. Instead the earliest timer is waited for with an async clock
+ * wait, so all jitterbuffers of a pipeline share the clock's async thread,
+ * and the expired timers are handled by a job on a thread pool that is
+ * shared by all jitterbuffers of the process. */
+static void shared_timer_job (GstRtpJitterBuffer * jitterbuffer,
+    gpointer user_data);
+
+static GThreadPool *
+get_shared_timer_pool (void)
+{
+  static gsize pool = 0;
+
+  if (g_once_init_enter (&pool)) {
+    GThreadPool *p;
+
+    p = g_thread_pool_new ((GFunc) shared_timer_job, NULL,
+        g_get_num_processors (), FALSE, NULL);
+    g_once_init_leave (&pool, (gsize) p);
+  }
+
+  return (GThreadPool *) pool;
+}
+
+/* called with JBUF lock
+ *
+ * Makes sure the timers are handled from a timer job soon. There is at most
+ * one job per jitterbuffer, which runs again when kicked while running. */
+static void
+shared_timer_kick (GstRtpJitterBuffer * jitterbuffer)
+{
+  GstRtpJitterBufferPrivate *priv = jitterbuffer->priv;
+
+  if (!priv->timer_running)
+    return;
+
+  if (priv->timer_job_active) {
+    priv->timer_job_rerun = TRUE;
+    return;
+  }
+
+  priv->timer_job_active = TRUE;
+  g_thread_pool_push (get_shared_timer_pool (), gst_object_ref (jitterbuffer),
+      NULL);
+}
+
+static gboolean
+shared_timer_cb (GstClock * clock, GstClockTime time, GstClockID id,
+    gpointer user_data)
+{
+  GstRtpJitterBuffer *jitterbuffer = user_data;
+  GstRtpJitterBufferPrivate *priv = jitterbuffer->priv;
+
+  JBUF_LOCK (priv);
+  /* ignore waits that were unscheduled or replaced in the meantime */
+  if (priv->clock_id == id) {
+    GST_DEBUG_OBJECT (jitterbuffer, "sync done, #%d", priv->timer_seqnum);
+    gst_clock_id_unref (priv->clock_id);
+    priv->clock_id = NULL;
+    shared_timer_kick (jitterbuffer);
+  }
+  JBUF_UNLOCK (priv);
+
+  return TRUE;
+}
+
+/* called with JBUF lock
+ *
+ * Handles the expired timers and schedules an async wait for the earliest
+ * remaining one, like wait_next_timeout() does before blocking. */
+static void
+handle_shared_timers (GstRtpJitterBuffer * jitterbuffer)
+{
+  GstRtpJitterBufferPrivate *priv = jitterbuffer->priv;
+  GstClockTime now = 0;
+
+  /* don't produce data in paused, we are kicked again in PLAYING */
+  while (priv->timer_running && !priv->blocked) {
+    RtpTimer *timer = NULL;
+    GQueue events = G_QUEUE_INIT;
+    GstClock *clock;
+    GstClockTime sync_time;
+
+    /* the earliest timer is rescheduled below */
+    if (priv->clock_id) {
+      gst_clock_id_unschedule (priv->clock_id);
+      gst_clock_id_unref (priv->clock_id);
+      priv->clock_id = NULL;
+    }
+
+    GST_OBJECT_LOCK (jitterbuffer);
+    if (priv->eos) {
+      now = GST_CLOCK_TIME_NONE;
+    } else if (GST_ELEMENT_CLOCK (jitterbuffer)) {
+      now =
+          gst_clock_get_time (GST_ELEMENT_CLOCK (jitterbuffer)) -
+          GST_ELEMENT_CAST (jitterbuffer)->base_time;
+    }
+    GST_OBJECT_UNLOCK (jitterbuffer);
+
+    GST_DEBUG_OBJECT (jitterbuffer, "now %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (now));
+
+    if (priv->do_retransmission)
+      rtp_timer_queue_remove_until (priv->rtx_stats_timers, now);
+
+    while ((timer = rtp_timer_queue_pop_until (priv->timers, now)))
+      do_timeout (jitterbuffer, timer, now, &events);
+
+    timer = rtp_timer_queue_peek_earliest (priv->timers);
+    if (!timer) {
+      push_rtx_events (jitterbuffer, &events);
+
+      /* the pusher thread waits for the timers to be drained on EOS */
+      if (priv->eos)
+        JBUF_SIGNAL_TIMER (priv);
+
+      /* no timers, we are kicked again when one is added */
+      return;
+    }
+
+    g_assert (GST_CLOCK_TIME_IS_VALID (timer->timeout));
+
+    GST_OBJECT_LOCK (jitterbuffer);
+    clock = GST_ELEMENT_CLOCK (jitterbuffer);
+    if (!clock) {
+      GST_OBJECT_UNLOCK (jitterbuffer);
+      GST_DEBUG_OBJECT (jitterbuffer, "No clock, timeout right away");
+      now = timer->timeout;
+      push_rtx_events (jitterbuffer, &events);
+      continue;
+    }
+
+    sync_time = timer->timeout + GST_ELEMENT_CAST (jitterbuffer)->base_time;
+    sync_time += priv->peer_latency;
+
+    GST_DEBUG_OBJECT (jitterbuffer, "timer #%i sync to timestamp %"
+        GST_TIME_FORMAT " with sync time %" GST_TIME_FORMAT, timer->seqnum,
+        GST_TIME_ARGS (get_pts_timeout (timer)), GST_TIME_ARGS (sync_time));
+
+    priv->clock_id = gst_clock_new_single_shot_id (clock, sync_time);
+    priv->timer_timeout = timer->timeout;
+    priv->timer_seqnum = timer->seqnum;
+    GST_OBJECT_UNLOCK (jitterbuffer);
+
+    gst_clock_id_wait_async (priv->clock_id, shared_timer_cb,
+        gst_object_ref (jitterbuffer), (GDestroyNotify) gst_object_unref);
+
+    push_rtx_events (jitterbuffer, &events);
+    return;
+  }
+}
+
+static void
+shared_timer_job (GstRtpJitterBuffer * jitterbuffer, gpointer user_data)
+{
+  GstRtpJitterBufferPrivate *priv = jitterbuffer->priv;
+
+  JBUF_LOCK (priv);
+  do {
+    priv->timer_job_rerun = FALSE;
+    handle_shared_timers (jitterbuffer);
+  } while (priv->timer_job_rerun && priv->timer_running);
+  priv->timer_job_active = FALSE;
+  /* wake up a state change waiting for us to finish */
+  JBUF_SIGNAL_TIMER (priv);
+  JBUF_UNLOCK (priv);
+
+  gst_object_unref (jitterbuffer);
+}
+
 /*
  * This function implements the main pushing loop on the source pad.
  *
@@ -5503,6 +5720,11 @@ gst_rtp_jitter_buffer_set_property (GObject * object,
       priv->min_sync_interval = g_value_get_uint (value);
       JBUF_UNLOCK (priv);
       break;
+    case PROP_SHARED_TIMERS:
+      JBUF_LOCK (priv);
+      priv->shared_timers = g_value_get_boolean (value);
+      JBUF_UNLOCK (priv);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -5684,6 +5906,11 @@ gst_rtp_jitter_buffer_get_property (GObject * object,
       g_value_set_uint (value, priv->min_sync_interval);
       JBUF_UNLOCK (priv);
       break;
+    case PROP_SHARED_TIMERS:
+      JBUF_LOCK (priv);
+      g_value_set_boolean (value, priv->shared_timers);
+      JBUF_UNLOCK (priv);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1444,20 +1444,22 @@ gst_rtp_session_process_rtp (RTPSession * sess, RTPSource * src,
 
   rtpsession = GST_RTP_SESSION (user_data);
 
+  /* the list is pushed, or dropped without recv_rtp_src, once all packets
+   * are processed */
+  if (rtpsession->priv->processed_list) {
+    GST_LOG_OBJECT (rtpsession, "queueing received RTP packet");
+    gst_buffer_list_add (rtpsession->priv->processed_list, buffer);
+    return GST_FLOW_OK;
+  }
+
   GST_RTP_SESSION_LOCK (rtpsession);
   if ((rtp_src = rtpsession->recv_rtp_src))
     gst_object_ref (rtp_src);
   GST_RTP_SESSION_UNLOCK (rtpsession);
 
   if (rtp_src) {
-    if (rtpsession->priv->processed_list) {
-      GST_LOG_OBJECT (rtpsession, "queueing received RTP packet");
-      gst_buffer_list_add (rtpsession->priv->processed_list, buffer);
-      result = GST_FLOW_OK;
-    } else {
-      GST_LOG_OBJECT (rtpsession, "pushing received RTP packet");
-      result = gst_pad_push (rtp_src, buffer);
-    }
+    GST_LOG_OBJECT (rtpsession, "pushing received RTP packet");
+    result = gst_pad_push (rtp_src, buffer);
     gst_object_unref (rtp_src);
   } else {
     GST_DEBUG_OBJECT (rtpsession, "dropping received RTP packet");
@@ -2087,50 +2089,75 @@ push_error:
   }
 }
 
-static gboolean
-process_received_buffer_in_list (GstBuffer ** buffer, guint idx, gpointer data)
-{
-  gint ret;
-
-  ret = gst_rtp_session_chain_recv_rtp (NULL, data, *buffer);
-  if (ret != GST_FLOW_OK)
-    GST_ERROR ("Processing individual buffer in a list failed");
-
-  /*
-   * The buffer has been processed, remove it from the original list, if it was
-   * a valid RTP buffer it has been added to the "processed" list in
-   * gst_rtp_session_process_rtp().
-   */
-  *buffer = NULL;
-  return TRUE;
-}
-
 static GstFlowReturn
 gst_rtp_session_chain_recv_rtp_list (GstPad * pad, GstObject * parent,
     GstBufferList * list)
 {
   GstRtpSession *rtpsession = GST_RTP_SESSION (parent);
+  GstRtpSessionPrivate *priv = rtpsession->priv;
   GstBufferList *processed_list;
+  GstClockTime current_time, now_running_time = GST_CLOCK_TIME_NONE;
+  GstClockTime *running_times;
+  guint64 *ntpnstimes, now_ntpnstime = GST_CLOCK_TIME_NONE;
+  gboolean have_now = FALSE;
+  GstFlowReturn ret;
+  guint i, len;
+
+  GST_LOG_OBJECT (rtpsession, "received RTP list");
+
+  GST_RTP_SESSION_LOCK (rtpsession);
+  signal_waiting_rtcp_thread_unlocked (rtpsession);
+  GST_RTP_SESSION_UNLOCK (rtpsession);
+
+  /* get the times of all packets like gst_rtp_session_chain_recv_rtp() does,
+   * the current times are the same for all packets without timestamp */
+  len = gst_buffer_list_length (list);
+  running_times = g_new (GstClockTime, len);
+  ntpnstimes = g_new (guint64, len);
+  for (i = 0; i < len; i++) {
+    GstClockTime timestamp = GST_BUFFER_PTS (gst_buffer_list_get (list, i));
+
+    if (GST_CLOCK_TIME_IS_VALID (timestamp)) {
+      running_times[i] =
+          gst_segment_to_running_time (&rtpsession->recv_rtp_seg,
+          GST_FORMAT_TIME, timestamp);
+      ntpnstimes[i] = GST_CLOCK_TIME_NONE;
+    } else {
+      if (!have_now) {
+        get_current_times (rtpsession, &now_running_time, &now_ntpnstime);
+        have_now = TRUE;
+      }
+      running_times[i] = now_running_time;
+      ntpnstimes[i] = now_ntpnstime;
+    }
+  }
+  current_time = gst_clock_get_time (priv->sysclock);
 
-  processed_list = gst_buffer_list_new ();
+  processed_list = gst_buffer_list_new_sized (len);
 
   /* Set some private data to detect that a buffer list is being pushed. */
-  rtpsession->priv->processed_list = processed_list;
+  priv->processed_list = processed_list;
 
   /*
-   * Individually process the buffers from the incoming buffer list as the
-   * incoming RTP packets in the list can be mixed in all sorts of ways:
+   * The session processes all buffers from the incoming buffer list with one
+   * lock, they can be mixed in all sorts of ways:
    *    - different frames,
    *    - different sources,
    *    - different types (RTP or RTCP)
+   * The valid RTP buffers are added to the "processed" list in
+   * gst_rtp_session_process_rtp().
    */
-  gst_buffer_list_foreach (list,
-      (GstBufferListFunc) process_received_buffer_in_list, parent);
+  ret = rtp_session_process_rtp_list (priv->session, list, current_time,
+      running_times, ntpnstimes);
+  if (ret != GST_FLOW_OK)
+    GST_DEBUG_OBJECT (rtpsession, "process returned %s",
+        gst_flow_get_name (ret));
 
-  gst_buffer_list_unref (list);
+  g_free (running_times);
+  g_free (ntpnstimes);
 
   /* Clean up private data in case the next push does not use a buffer list. */
-  rtpsession->priv->processed_list = NULL;
+  priv->processed_list = NULL;
 
   if (gst_buffer_list_length (processed_list) == 0 || !rtpsession->recv_rtp_src) {
     gst_buffer_list_unref (processed_list);
@@ -137,6 +137,8 @@ struct _GstRTPST_2022_1_FecDec
 
   /* All the following field are protected by the OBJECT_LOCK */
   GSequence *packets;
+  /* seq -> Item in packets */
+  GHashTable *packets_by_seq;
   GHashTable *column_fec_packets;
   GSequence *fec_packets[2];
   /* N columns */
@@ -213,6 +215,11 @@ trim_items (GstRTPST_2022_1_FecDec * dec)
         dec->size_time)
       break;
 
+    /* a newer duplicate may own the index entry */
+    if (g_hash_table_lookup (dec->packets_by_seq,
+            GUINT_TO_POINTER (item->seq)) == item)
+      g_hash_table_remove (dec->packets_by_seq, GUINT_TO_POINTER (item->seq));
+
     iter = tmp_iter;
   }
 
@@ -271,18 +278,7 @@ trim_fec_items (GstRTPST_2022_1_FecDec * dec, guint D)
 static Item *
 lookup_media_packet (GstRTPST_2022_1_FecDec * dec, guint16 seqnum)
 {
-  GSequenceIter *iter;
-  Item *ret = NULL;
-  Item dummy = { seqnum, NULL };
-
-  iter =
-      g_sequence_lookup (dec->packets, &dummy, (GCompareDataFunc) cmp_items,
-      NULL);
-
-  if (iter)
-    ret = g_sequence_get (iter);
-
-  return ret;
+  return g_hash_table_lookup (dec->packets_by_seq, GUINT_TO_POINTER (seqnum));
 }
 
 static gboolean
@@ -582,6 +578,7 @@ store_media_item (GstRTPST_2022_1_FecDec * dec, GstRTPBuffer * rtp, Item * item)
 
   g_sequence_insert_sorted (dec->packets, item, (GCompareDataFunc) cmp_items,
       NULL);
+  g_hash_table_insert (dec->packets_by_seq, GUINT_TO_POINTER (item->seq), item);
 
   if ((fec_item = get_row_fec (dec, seq))) {
     ret = check_fec_item (dec, fec_item);
@@ -772,6 +769,11 @@ gst_rtpst_2022_1_fecdec_reset (GstRTPST_2022_1_FecDec * dec, gboolean allocate)
 
   GST_OBJECT_LOCK (dec);
 
+  if (dec->packets_by_seq) {
+    g_hash_table_unref (dec->packets_by_seq);
+    dec->packets_by_seq = NULL;
+  }
+
   if (dec->packets) {
     g_sequence_free (dec->packets);
     dec->packets = NULL;
@@ -784,6 +786,7 @@ gst_rtpst_2022_1_fecdec_reset (GstRTPST_2022_1_FecDec * dec, gboolean allocate)
 
   if (allocate) {
     dec->packets = g_sequence_new ((GDestroyNotify) free_item);
+    dec->packets_by_seq = g_hash_table_new (g_direct_hash, g_direct_equal);
     dec->column_fec_packets = g_hash_table_new (g_direct_hash, g_direct_equal);
   }
 
@@ -240,9 +240,42 @@ _xor_mem (guint8 * restrict dst, const guint8 * restrict src, gsize length)
     dst[i] ^= src[i];
 }
 
+/* XORs @src into both @dst1 and @dst2, reading it only once */
 static void
-fec_packet_update (FecPacket * fec, GstRTPBuffer * rtp)
+_xor_mem2 (guint8 * restrict dst1, guint8 * restrict dst2,
+    const guint8 * restrict src, gsize length)
 {
+  guint i;
+
+  for (i = 0; i < (length / sizeof (guint64)); ++i) {
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+    guint64 s = GST_READ_UINT64_LE (src);
+
+    GST_WRITE_UINT64_LE (dst1, GST_READ_UINT64_LE (dst1) ^ s);
+    GST_WRITE_UINT64_LE (dst2, GST_READ_UINT64_LE (dst2) ^ s);
+#else
+    guint64 s = GST_READ_UINT64_BE (src);
+
+    GST_WRITE_UINT64_BE (dst1, GST_READ_UINT64_BE (dst1) ^ s);
+    GST_WRITE_UINT64_BE (dst2, GST_READ_UINT64_BE (dst2) ^ s);
+#endif
+    dst1 += sizeof (guint64);
+    dst2 += sizeof (guint64);
+    src += sizeof (guint64);
+  }
+  for (i = 0; i < (length % sizeof (guint64)); ++i) {
+    dst1[i] ^= src[i];
+    dst2[i] ^= src[i];
+  }
+}
+
+/* Updates everything but the payload, returns %TRUE if the payload of @rtp
+ * still has to be XORed into the FEC packet */
+static gboolean
+fec_packet_update_header (FecPacket * fec, GstRTPBuffer * rtp)
+{
+  gboolean needs_xor = FALSE;
+
   if (fec->n_packets == 0) {
     fec->seq_base = gst_rtp_buffer_get_seq (rtp);
     fec->payload_len = gst_rtp_buffer_get_payload_len (rtp);
@@ -272,10 +305,31 @@ fec_packet_update (FecPacket * fec, GstRTPBuffer * rtp)
     fec->xored_marker ^= gst_rtp_buffer_get_marker (rtp);
     fec->xored_padding ^= gst_rtp_buffer_get_padding (rtp);
     fec->xored_extension ^= gst_rtp_buffer_get_extension (rtp);
-    _xor_mem (fec->xored_payload, gst_rtp_buffer_get_payload (rtp), plen);
+    needs_xor = TRUE;
   }
 
   fec->n_packets += 1;
+
+  return needs_xor;
+}
+
+/* Adds @rtp to the row and column FEC packets it is protected by */
+static void
+fec_packets_update (FecPacket * row, FecPacket * column, GstRTPBuffer * rtp)
+{
+  const guint8 *payload = gst_rtp_buffer_get_payload (rtp);
+  guint plen = gst_rtp_buffer_get_payload_len (rtp);
+  gboolean row_xor, column_xor;
+
+  row_xor = row && fec_packet_update_header (row, rtp);
+  column_xor = column && fec_packet_update_header (column, rtp);
+
+  if (row_xor && column_xor)
+    _xor_mem2 (row->xored_payload, column->xored_payload, payload, plen);
+  else if (row_xor)
+    _xor_mem (row->xored_payload, payload, plen);
+  else if (column_xor)
+    _xor_mem (column->xored_payload, payload, plen);
 }
 
 static void
@@ -440,9 +494,20 @@ gst_rtpst_2022_1_fecenc_sink_chain (GstPad * pad, GstObject * parent,
   enc->last_media_seqnum_set = TRUE;
 
   GST_OBJECT_LOCK (enc);
+  {
+    FecPacket *row = NULL, *column = NULL;
+
+    if (enc->enable_row && enc->l) {
+      g_assert (enc->row->n_packets < enc->l);
+      row = enc->row;
+    }
+    if (enc->enable_column && enc->l && enc->d)
+      column = g_ptr_array_index (enc->columns, enc->current_column);
+
+    fec_packets_update (row, column, &rtp);
+  }
+
   if (enc->enable_row && enc->l) {
-    g_assert (enc->row->n_packets < enc->l);
-    fec_packet_update (enc->row, &rtp);
     if (enc->row->n_packets == enc->l) {
       queue_fec_packet (enc, enc->row, TRUE);
       g_free (enc->row->xored_payload);
@@ -453,7 +518,6 @@ gst_rtpst_2022_1_fecenc_sink_chain (GstPad * pad, GstObject * parent,
   if (enc->enable_column && enc->l && enc->d) {
     FecPacket *column = g_ptr_array_index (enc->columns, enc->current_column);
 
-    fec_packet_update (column, &rtp);
     if (column->n_packets == enc->d) {
       queue_fec_packet (enc, column, FALSE);
       g_free (column->xored_payload);
@@ -114,6 +114,7 @@ rtp_jitter_buffer_finalize (GObject * object)
     gst_object_unref (jbuf->pipeline_clock);
 
   rtp_jitter_buffer_flush (jbuf, NULL, NULL);
+  g_free (jbuf->index);
 
   g_mutex_clear (&jbuf->clock_lock);
 
@@ -758,6 +759,191 @@ queue_do_insert (RTPJitterBuffer * jbuf, GList * list, GList * item)
   queue->length++;
 }
 
+/* The index is a ring of pointers to the queued items, where an item with a
+ * seqnum is stored at the slot given by the lower bits of its seqnum. It is
+ * grown whenever two queued items would share a slot, so it always covers
+ * the seqnum range in the queue and makes lookups by seqnum O(1). */
+#define INDEX_MIN_SIZE 64
+#define INDEX_MAX_SIZE 65536
+
+static RTPJitterBufferItem *
+index_lookup (RTPJitterBuffer * jbuf, guint16 seqnum)
+{
+  RTPJitterBufferItem *item;
+
+  if (G_UNLIKELY (jbuf->index_size == 0))
+    return NULL;
+
+  item = jbuf->index[seqnum & (jbuf->index_size - 1)];
+  if (item && item->seqnum == seqnum)
+    return item;
+
+  return NULL;
+}
+
+/* rebuild the index from the queue with at least @size slots */
+static void
+index_resize (RTPJitterBuffer * jbuf, guint size)
+{
+  GList *list;
+
+again:
+  g_free (jbuf->index);
+  jbuf->index = g_new0 (RTPJitterBufferItem *, size);
+  jbuf->index_size = size;
+
+  for (list = jbuf->packets.head; list; list = list->next) {
+    RTPJitterBufferItem *item = (RTPJitterBufferItem *) list;
+    guint slot;
+
+    if (item->seqnum == -1)
+      continue;
+
+    slot = item->seqnum & (size - 1);
+    if (jbuf->index[slot]) {
+      /* can't happen with a slot for every seqnum, there are no duplicates */
+      g_assert (size < INDEX_MAX_SIZE);
+      size *= 2;
+      goto again;
+    }
+    jbuf->index[slot] = item;
+  }
+
+  GST_DEBUG ("index size now %u", size);
+}
+
+/* must be called after @item was queued */
+static void
+index_add (RTPJitterBuffer * jbuf, RTPJitterBufferItem * item)
+{
+  guint slot;
+
+  if (item->seqnum == -1)
+    return;
+
+  if (G_UNLIKELY (jbuf->index_size == 0)) {
+    index_resize (jbuf, INDEX_MIN_SIZE);
+    return;
+  }
+
+  slot = item->seqnum & (jbuf->index_size - 1);
+  if (G_UNLIKELY (jbuf->index[slot] != NULL)) {
+    /* the queue now spans more seqnums than the index has slots */
+    index_resize (jbuf, jbuf->index_size * 2);
+    return;
+  }
+  jbuf->index[slot] = item;
+}
+
+static void
+index_remove (RTPJitterBuffer * jbuf, RTPJitterBufferItem * item)
+{
+  guint slot;
+
+  if (item->seqnum == -1 || jbuf->index_size == 0)
+    return;
+
+  slot = item->seqnum & (jbuf->index_size - 1);
+  if (jbuf->index[slot] == item)
+    jbuf->index[slot] = NULL;
+}
+
+/* walk the queue from the tail to find the position for @seqnum */
+static GList *
+find_insert_position_walk (RTPJitterBuffer * jbuf, guint16 seqnum)
+{
+  GList *list, *event = NULL;
+
+  /* loop the list to skip strictly larger seqnum buffers */
+  for (list = jbuf->packets.tail; list; list = g_list_previous (list)) {
+    guint16 qseq;
+    gint gap;
+    RTPJitterBufferItem *qitem = (RTPJitterBufferItem *) list;
+
+    if (qitem->seqnum == -1) {
+      /* keep a pointer to the first consecutive event if not already
+       * set. we will insert the packet after the event if we can't find
+       * a packet with lower sequence number before the event. */
+      if (event == NULL)
+        event = list;
+      continue;
+    }
+
+    qseq = qitem->seqnum;
+
+    /* compare the new seqnum to the one in the buffer */
+    gap = gst_rtp_buffer_compare_seqnum (seqnum, qseq);
+
+    /* seqnum > qseq, we can stop looking */
+    if (G_LIKELY (gap < 0))
+      break;
+
+    /* if we've found a packet with greater sequence number, cleanup the
+     * event pointer as the packet will be inserted before the event */
+    event = NULL;
+  }
+
+  /* if event is set it means that packets before the event had smaller
+   * sequence number, so we will insert our packet after the event */
+  if (event)
+    list = event;
+
+  return list;
+}
+
+/* Returns the link after which a packet with @seqnum, that is not queued
+ * yet, is to be inserted or %NULL for the head of the queue. That is after
+ * the packet with the closest lower seqnum and the events following it. */
+static GList *
+find_insert_position (RTPJitterBuffer * jbuf, guint16 seqnum)
+{
+  RTPJitterBufferItem *first = NULL, *last = NULL, *prev = NULL;
+  GList *list, *next;
+  gint dist, i;
+
+  for (list = jbuf->packets.tail; list; list = list->prev) {
+    if (((RTPJitterBufferItem *) list)->seqnum != -1) {
+      last = (RTPJitterBufferItem *) list;
+      break;
+    }
+  }
+
+  /* newer than all queued packets, the common case */
+  if (last == NULL || gst_rtp_buffer_compare_seqnum (last->seqnum, seqnum) > 0)
+    return jbuf->packets.tail;
+
+  for (list = jbuf->packets.head; list; list = list->next) {
+    if (((RTPJitterBufferItem *) list)->seqnum != -1) {
+      first = (RTPJitterBufferItem *) list;
+      break;
+    }
+  }
+
+  dist = gst_rtp_buffer_compare_seqnum (first->seqnum, seqnum);
+  if (dist > (gint) jbuf->packets.length) {
+    /* more seqnums are missing than there are queued items, walking the
+     * queue is cheaper than probing the index */
+    return find_insert_position_walk (jbuf, seqnum);
+  }
+
+  /* probe the index for the closest lower seqnum, at worst this finds the
+   * first packet */
+  for (i = 1; i <= dist; i++) {
+    if ((prev = index_lookup (jbuf, (guint16) (seqnum - i))))
+      break;
+  }
+
+  /* older than all queued packets when nothing was found */
+  list = (GList *) prev;
+  next = list ? list->next : jbuf->packets.head;
+  while (next && ((RTPJitterBufferItem *) next)->seqnum == -1) {
+    list = next;
+    next = next->next;
+  }
+
+  return list;
+}
+
 GstClockTime
 rtp_jitter_buffer_calculate_pts (RTPJitterBuffer * jbuf, GstClockTime dts,
     gboolean estimated_dts, guint32 rtptime, GstClockTime base_time,
@@ -1152,7 +1338,7 @@ static gboolean
 rtp_jitter_buffer_insert (RTPJitterBuffer * jbuf, RTPJitterBufferItem * item,
     gboolean * head, gint * percent)
 {
-  GList *list, *event = NULL;
+  GList *list;
   guint16 seqnum;
 
   if (G_LIKELY (head))
@@ -1171,46 +1357,15 @@ rtp_jitter_buffer_insert (RTPJitterBuffer * jbuf, RTPJitterBufferItem * item,
 
   seqnum = item->seqnum;
 
-  /* loop the list to skip strictly larger seqnum buffers */
-  for (; list; list = g_list_previous (list)) {
-    guint16 qseq;
-    gint gap;
-    RTPJitterBufferItem *qitem = (RTPJitterBufferItem *) list;
-
-    if (qitem->seqnum == -1) {
-      /* keep a pointer to the first consecutive event if not already
-       * set. we will insert the packet after the event if we can't find
-       * a packet with lower sequence number before the event. */
-      if (event == NULL)
-        event = list;
-      continue;
-    }
-
-    qseq = qitem->seqnum;
-
-    /* compare the new seqnum to the one in the buffer */
-    gap = gst_rtp_buffer_compare_seqnum (seqnum, qseq);
-
-    /* we hit a packet with the same seqnum, notify a duplicate */
-    if (G_UNLIKELY (gap == 0))
-      goto duplicate;
-
-    /* seqnum > qseq, we can stop looking */
-    if (G_LIKELY (gap < 0))
-      break;
-
-    /* if we've found a packet with greater sequence number, cleanup the
-     * event pointer as the packet will be inserted before the event */
-    event = NULL;
-  }
+  /* we have a packet with the same seqnum, notify a duplicate */
+  if (G_UNLIKELY (index_lookup (jbuf, seqnum)))
+    goto duplicate;
 
-  /* if event is set it means that packets before the event had smaller
-   * sequence number, so we will insert our packet after the event */
-  if (event)
-    list = event;
+  list = find_insert_position (jbuf, seqnum);
 
 append:
   queue_do_insert (jbuf, list, (GList *) item);
+  index_add (jbuf, item);
 
   /* buffering mode, update buffer stats */
   if (jbuf->mode == RTP_JITTER_BUFFER_MODE_BUFFER)
@@ -1410,6 +1565,7 @@ rtp_jitter_buffer_pop (RTPJitterBuffer * jbuf, gint * percent)
     else
       queue->tail = NULL;
     queue->length--;
+    index_remove (jbuf, (RTPJitterBufferItem *) item);
   }
 
   /* buffering mode, update buffer stats */
@@ -1466,6 +1622,9 @@ rtp_jitter_buffer_flush (RTPJitterBuffer * jbuf, GFunc free_func,
 
   while ((item = g_queue_pop_head_link (&jbuf->packets)))
     free_func ((RTPJitterBufferItem *) item, user_data);
+
+  if (jbuf->index)
+    memset (jbuf->index, 0, sizeof (RTPJitterBufferItem *) * jbuf->index_size);
 }
 
 /**
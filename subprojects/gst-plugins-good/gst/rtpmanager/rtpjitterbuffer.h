@@ -74,6 +74,9 @@ struct _RTPJitterBuffer {
   GObject        object;
 
   GQueue         packets;
+  /* the queued items with a seqnum, by the lower bits of their seqnum */
+  RTPJitterBufferItem **index;
+  guint          index_size;
 
   RTPJitterBufferMode mode;
 
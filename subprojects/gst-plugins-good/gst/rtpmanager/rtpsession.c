@@ -1215,6 +1215,7 @@ rtp_session_reset (RTPSession * sess)
 
   RTP_SESSION_LOCK (sess);
   /* remove all sources */
+  sess->last_source = NULL;
   g_hash_table_remove_all (sess->ssrcs[sess->mask_idx]);
   sess->total_sources = 0;
   sess->stats.sender_sources = 0;
@@ -1567,6 +1568,13 @@ rtp_session_set_sdes_struct (RTPSession * sess, const GstStructure * sdes)
   RTP_SESSION_UNLOCK (sess);
 }
 
+/* a received packet that is pushed after processing a list */
+typedef struct
+{
+  RTPSource *source;
+  GstBuffer *buffer;
+} RTPPendingPacket;
+
 static GstFlowReturn
 source_push_rtp (RTPSource * source, gpointer data, RTPSession * session)
 {
@@ -1586,6 +1594,17 @@ source_push_rtp (RTPSource * source, gpointer data, RTPSession * session)
     }
   } else {
     GST_LOG ("source %08x pushed receiver RTP packet", source->ssrc);
+
+    if (session->pending_rtp) {
+      RTPPendingPacket pending;
+
+      /* processing a list, pushed when the session lock is released */
+      pending.source = g_object_ref (source);
+      pending.buffer = GST_BUFFER_CAST (data);
+      g_array_append_val (session->pending_rtp, pending);
+      return GST_FLOW_OK;
+    }
+
     RTP_SESSION_UNLOCK (session);
 
     if (session->callbacks.process_rtp)
@@ -1895,8 +1914,18 @@ add_source (RTPSession * sess, RTPSource * src)
 static RTPSource *
 find_source (RTPSession * sess, guint32 ssrc)
 {
-  return g_hash_table_lookup (sess->ssrcs[sess->mask_idx],
+  RTPSource *source;
+
+  /* packets usually come in runs of the same SSRC */
+  if (sess->last_source && sess->last_source->ssrc == ssrc)
+    return sess->last_source;
+
+  source = g_hash_table_lookup (sess->ssrcs[sess->mask_idx],
       GINT_TO_POINTER (ssrc));
+  if (source)
+    sess->last_source = source;
+
+  return source;
 }
 
 /* must be called with the session lock, the returned source needs to be
@@ -2328,20 +2357,9 @@ source_update_sender (RTPSession * sess, RTPSource * source,
   return TRUE;
 }
 
-/**
- * rtp_session_process_rtp:
- * @sess: and #RTPSession
- * @buffer: an RTP buffer
- * @current_time: the current system time
- * @running_time: the running_time of @buffer
- *
- * Process an RTP buffer in the session manager. This function takes ownership
- * of @buffer.
- *
- * Returns: a #GstFlowReturn.
- */
-GstFlowReturn
-rtp_session_process_rtp (RTPSession * sess, GstBuffer * buffer,
+/* must be called with the session lock, takes ownership of @buffer */
+static GstFlowReturn
+process_rtp_locked (RTPSession * sess, GstBuffer * buffer,
     GstClockTime current_time, GstClockTime running_time, guint64 ntpnstime)
 {
   GstFlowReturn result;
@@ -2352,18 +2370,15 @@ rtp_session_process_rtp (RTPSession * sess, GstBuffer * buffer,
   RTPPacketInfo pinfo = { 0, };
   guint64 oldrate;
 
-  g_return_val_if_fail (RTP_IS_SESSION (sess), GST_FLOW_ERROR);
-  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_FLOW_ERROR);
-
-  RTP_SESSION_LOCK (sess);
-
   /* update pinfo stats */
   if (!update_packet_info (sess, &pinfo, FALSE, TRUE, FALSE, buffer,
           current_time, running_time, ntpnstime)) {
     GST_DEBUG ("invalid RTP packet received");
     RTP_SESSION_UNLOCK (sess);
-    return rtp_session_process_rtcp (sess, buffer, current_time, running_time,
-        ntpnstime);
+    result = rtp_session_process_rtcp (sess, buffer, current_time,
+        running_time, ntpnstime);
+    RTP_SESSION_LOCK (sess);
+    return result;
   }
 
   ssrc = pinfo.ssrc;
@@ -2420,8 +2435,6 @@ rtp_session_process_rtp (RTPSession * sess, GstBuffer * buffer,
   }
   g_object_unref (source);
 
-  RTP_SESSION_UNLOCK (sess);
-
   clean_packet_info (&pinfo);
 
   return result;
@@ -2429,13 +2442,136 @@ rtp_session_process_rtp (RTPSession * sess, GstBuffer * buffer,
   /* ERRORS */
 collision:
   {
-    RTP_SESSION_UNLOCK (sess);
     clean_packet_info (&pinfo);
     GST_DEBUG ("ignoring packet because its collisioning");
     return GST_FLOW_OK;
   }
 }
 
+/**
+ * rtp_session_process_rtp:
+ * @sess: and #RTPSession
+ * @buffer: an RTP buffer
+ * @current_time: the current system time
+ * @running_time: the running_time of @buffer
+ *
+ * Process an RTP buffer in the session manager. This function takes ownership
+ * of @buffer.
+ *
+ * Returns: a #GstFlowReturn.
+ */
+GstFlowReturn
+rtp_session_process_rtp (RTPSession * sess, GstBuffer * buffer,
+    GstClockTime current_time, GstClockTime running_time, guint64 ntpnstime)
+{
+  GstFlowReturn result;
+
+  g_return_val_if_fail (RTP_IS_SESSION (sess), GST_FLOW_ERROR);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_FLOW_ERROR);
+
+  RTP_SESSION_LOCK (sess);
+  result = process_rtp_locked (sess, buffer, current_time, running_time,
+      ntpnstime);
+  RTP_SESSION_UNLOCK (sess);
+
+  return result;
+}
+
+typedef struct
+{
+  RTPSession *sess;
+  GstClockTime current_time;
+  const GstClockTime *running_times;
+  const guint64 *ntpnstimes;
+  guint idx;
+  GstFlowReturn result;
+} ProcessRTPListData;
+
+static gboolean
+process_rtp_in_list (GstBuffer ** buffer, guint idx, ProcessRTPListData * data)
+{
+  GstFlowReturn res;
+
+  /* @idx is the index in the list after removing the previous buffers */
+  res = process_rtp_locked (data->sess, *buffer, data->current_time,
+      data->running_times[data->idx], data->ntpnstimes[data->idx]);
+  if (data->result == GST_FLOW_OK)
+    data->result = res;
+  data->idx++;
+  *buffer = NULL;
+
+  return TRUE;
+}
+
+/**
+ * rtp_session_process_rtp_list:
+ * @sess: and #RTPSession
+ * @list: a list of RTP buffers
+ * @current_time: the current system time
+ * @running_times: the running_time of each buffer in @list
+ * @ntpnstimes: the NTP time of each buffer in @list
+ *
+ * Process all RTP buffers in @list in the session manager like
+ * rtp_session_process_rtp() does, but taking the session lock only once. The
+ * packets that are ready are passed to the process_rtp callback after all of
+ * them were processed. This function takes ownership of @list.
+ *
+ * Returns: the first #GstFlowReturn that is not %GST_FLOW_OK, if any.
+ */
+GstFlowReturn
+rtp_session_process_rtp_list (RTPSession * sess, GstBufferList * list,
+    GstClockTime current_time, const GstClockTime * running_times,
+    const guint64 * ntpnstimes)
+{
+  ProcessRTPListData data;
+  GstFlowReturn res;
+  GArray *pending;
+  guint i;
+
+  g_return_val_if_fail (RTP_IS_SESSION (sess), GST_FLOW_ERROR);
+  g_return_val_if_fail (GST_IS_BUFFER_LIST (list), GST_FLOW_ERROR);
+
+  /* we pass on the buffers, so the list must be ours */
+  list = gst_buffer_list_make_writable (list);
+
+  data.sess = sess;
+  data.current_time = current_time;
+  data.running_times = running_times;
+  data.ntpnstimes = ntpnstimes;
+  data.idx = 0;
+  data.result = GST_FLOW_OK;
+
+  pending = g_array_sized_new (FALSE, FALSE, sizeof (RTPPendingPacket),
+      gst_buffer_list_length (list));
+
+  RTP_SESSION_LOCK (sess);
+  sess->pending_rtp = pending;
+  gst_buffer_list_foreach (list, (GstBufferListFunc) process_rtp_in_list,
+      &data);
+  sess->pending_rtp = NULL;
+  RTP_SESSION_UNLOCK (sess);
+
+  gst_buffer_list_unref (list);
+
+  for (i = 0; i < pending->len; i++) {
+    RTPPendingPacket *p = &g_array_index (pending, RTPPendingPacket, i);
+
+    if (sess->callbacks.process_rtp)
+      res = sess->callbacks.process_rtp (sess, p->source, p->buffer,
+          sess->process_rtp_user_data);
+    else {
+      gst_buffer_unref (p->buffer);
+      res = GST_FLOW_OK;
+    }
+    if (data.result == GST_FLOW_OK)
+      data.result = res;
+    g_object_unref (p->source);
+  }
+  g_array_free (pending, TRUE);
+
+  return data.result;
+}
+
 static void
 rtp_session_process_rb (RTPSession * sess, RTPSource * source,
     GstRTCPPacket * packet, RTPPacketInfo * pinfo)
@@ -4739,6 +4875,7 @@ rtp_session_on_timeout (RTPSession * sess, GstClockTime current_time,
   g_hash_table_destroy (table_copy);
 
   /* Now remove the marked sources */
+  sess->last_source = NULL;
   g_hash_table_foreach_remove (sess->ssrcs[sess->mask_idx],
       (GHRFunc) remove_closing_sources, &data);
 
@@ -271,6 +271,12 @@ struct _RTPSession {
   guint32       mask;
   GHashTable   *ssrcs[32];
   guint         total_sources;
+  /* last source found in ssrcs, cleared when sources are removed */
+  RTPSource    *last_source;
+
+  /* while processing a list, received packets are queued here and pushed
+   * when the session lock is released */
+  GArray       *pending_rtp;
 
   guint16       generation;
   GstClockTime  next_rtcp_check_time; /* tn */
@@ -412,6 +418,10 @@ GstFlowReturn   rtp_session_process_rtp            (RTPSession *sess, GstBuffer
                                                     GstClockTime current_time,
 						    GstClockTime running_time,
                                                     guint64 ntpnstime);
+GstFlowReturn   rtp_session_process_rtp_list       (RTPSession *sess, GstBufferList *list,
+                                                    GstClockTime current_time,
+                                                    const GstClockTime *running_times,
+                                                    const guint64 *ntpnstimes);
 GstFlowReturn   rtp_session_process_rtcp           (RTPSession *sess, GstBuffer *buffer,
                                                     GstClockTime current_time,
                                                     GstClockTime running_time,
@@ -23,6 +23,7 @@
 
 #include <stdio.h>
 #include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
 #include <gst/video/video.h>
 
 static gboolean
@@ -1016,7 +1017,139 @@ GST_START_TEST (test_fields_auto_expected_caps)
 
 GST_END_TEST;
 
+#define SLICES_N_FRAMES 6
 
+static GList *
+deinterlace_slices_run (const gchar * method, const gchar * format,
+    guint n_threads)
+{
+  GstHarness *h;
+  GstVideoInfo info;
+  GstCaps *caps;
+  GRand *rand;
+  GList *outbufs = NULL;
+  GstBuffer *buf;
+  gint i;
+
+  h = gst_harness_new ("deinterlace");
+  gst_util_set_object_arg (G_OBJECT (h->element), "method", method);
+  g_object_set (h->element, "n-threads", n_threads, NULL);
+
+  caps = gst_caps_new_simple ("video/x-raw", "format", G_TYPE_STRING, format,
+      "width", G_TYPE_INT, 720, "height", G_TYPE_INT, 576,
+      "framerate", GST_TYPE_FRACTION, 25, 1,
+      "interlace-mode", G_TYPE_STRING, "interleaved", NULL);
+  fail_unless (gst_video_info_from_caps (&info, caps));
+  gst_harness_set_src_caps (h, caps);
+
+  /* Same pseudo-random content for every run */
+  rand = g_rand_new_with_seed (42);
+  for (i = 0; i < SLICES_N_FRAMES; i++) {
+    GstMapInfo map;
+    gsize j;
+
+    buf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&info));
+    fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+    for (j = 0; j < map.size; j++)
+      map.data[j] = g_rand_int_range (rand, 0, 256);
+    gst_buffer_unmap (buf, &map);
+
+    GST_BUFFER_PTS (buf) = i * GST_SECOND / 25;
+    GST_BUFFER_DURATION (buf) = GST_SECOND / 25;
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  }
+  g_rand_free (rand);
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+
+  while ((buf = gst_harness_try_pull (h)))
+    outbufs = g_list_append (outbufs, buf);
+
+  gst_harness_teardown (h);
+
+  return outbufs;
+}
+
+static void
+deinterlace_compare_outputs (GList * outbufs1, GList * outbufs2,
+    const gchar * what)
+{
+  GList *l1, *l2;
+
+  fail_unless (outbufs1 != NULL);
+  fail_unless_equals_int (g_list_length (outbufs1),
+      g_list_length (outbufs2));
+
+  for (l1 = outbufs1, l2 = outbufs2; l1 && l2; l1 = l1->next, l2 = l2->next) {
+    GstMapInfo map1, map2;
+
+    fail_unless (gst_buffer_map (l1->data, &map1, GST_MAP_READ));
+    fail_unless (gst_buffer_map (l2->data, &map2, GST_MAP_READ));
+    fail_unless_equals_int (map1.size, map2.size);
+    fail_unless (memcmp (map1.data, map2.data, map1.size) == 0,
+        "Output differs %s", what);
+    gst_buffer_unmap (l1->data, &map1);
+    gst_buffer_unmap (l2->data, &map2);
+  }
+
+  g_list_free_full (outbufs1, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (outbufs2, (GDestroyNotify) gst_buffer_unref);
+}
+
+static void
+deinterlace_check_slices (const gchar * method, const gchar * format)
+{
+  GList *single, *sliced;
+  gchar *what;
+
+  single = deinterlace_slices_run (method, format, 1);
+  sliced = deinterlace_slices_run (method, format, 4);
+
+  what = g_strdup_printf ("when using slices with %s on %s", method, format);
+  deinterlace_compare_outputs (single, sliced, what);
+  g_free (what);
+}
+
+GST_START_TEST (test_slices_identical_output)
+{
+  deinterlace_check_slices ("yadif", "I420");
+  deinterlace_check_slices ("yadif", "NV12");
+  deinterlace_check_slices ("yadif", "YUY2");
+  deinterlace_check_slices ("linear", "I420");
+  deinterlace_check_slices ("vfir", "YUY2");
+}
+
+GST_END_TEST;
+
+#if defined (__x86_64__) && (defined (__GNUC__) || defined (__clang__))
+static void
+deinterlace_check_yadif_avx2 (const gchar * format)
+{
+  GList *sse, *avx2;
+  gchar *what;
+
+  /* the AVX2 kernel handles the part of each line that is a multiple of 16
+   * pixels, with 720 pixels wide lines that leaves a tail for the SSE one */
+  g_setenv ("GST_DEINTERLACE_DISABLE_AVX2", "1", TRUE);
+  sse = deinterlace_slices_run ("yadif", format, 1);
+  g_unsetenv ("GST_DEINTERLACE_DISABLE_AVX2");
+  avx2 = deinterlace_slices_run ("yadif", format, 1);
+
+  what = g_strdup_printf ("between the SSE and AVX2 yadif kernels on %s",
+      format);
+  deinterlace_compare_outputs (sse, avx2, what);
+  g_free (what);
+}
+
+GST_START_TEST (test_yadif_avx2_identical_output)
+{
+  deinterlace_check_yadif_avx2 ("I420");
+  deinterlace_check_yadif_avx2 ("Y42B");
+  deinterlace_check_yadif_avx2 ("Y444");
+}
+
+GST_END_TEST;
+#endif
 
 static Suite *
 deinterlace_suite (void)
@@ -1045,6 +1178,12 @@ deinterlace_suite (void)
   tcase_add_test (tc_chain, test_mode_auto_expected_caps);
   tcase_add_test (tc_chain, test_mode_auto_strict_expected_caps);
   tcase_add_test (tc_chain, test_fields_auto_expected_caps);
+  tcase_add_test (tc_chain, test_slices_identical_output);
+#if defined (__x86_64__) && (defined (__GNUC__) || defined (__clang__))
+  /* nothing to compare against without AVX2 */
+  if (__builtin_cpu_supports ("avx2"))
+    tcase_add_test (tc_chain, test_yadif_avx2_identical_output);
+#endif
 
   return s;
 }
@@ -644,6 +644,56 @@ GST_START_TEST (test_rtph265pay_marker_for_fragmented_au)
 
 GST_END_TEST;
 
+static GstPadProbeReturn
+count_lists_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  guint *counts = user_data;
+
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST)
+    counts[0]++;
+  else
+    counts[1]++;
+
+  return GST_PAD_PROBE_OK;
+}
+
+GST_START_TEST (test_rtph265pay_au_as_one_list)
+{
+  GstHarness *h = gst_harness_new ("rtph265pay");
+  GstFlowReturn ret;
+  GstBuffer *slice1, *slice2, *buffer;
+  GstPad *srcpad;
+  guint counts[2] = { 0, 0 };
+
+  g_object_set (h->element, "mtu", 40, NULL);
+
+  /* the sink pad of the harness chains the buffers of a list one by one, so
+   * count on the source pad of the payloader */
+  srcpad = gst_element_get_static_pad (h->element, "src");
+  gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BUFFER |
+      GST_PAD_PROBE_TYPE_BUFFER_LIST, count_lists_probe, counts, NULL);
+  gst_object_unref (srcpad);
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-h265,alignment=au,stream-format=byte-stream");
+
+  slice1 = wrap_static_buffer (h265_idr_slice_1, sizeof (h265_idr_slice_1));
+  slice2 = wrap_static_buffer (h265_idr_slice_2, sizeof (h265_idr_slice_2));
+  buffer = gst_buffer_append (slice1, slice2);
+
+  ret = gst_harness_push (h, buffer);
+  fail_unless_equals_int (ret, GST_FLOW_OK);
+
+  /* the fragments of both slices are pushed as one buffer list */
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 4);
+  fail_unless_equals_int (counts[0], 1);
+  fail_unless_equals_int (counts[1], 0);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtph265pay_aggregate_two_slices_per_buffer)
 {
   GstHarness *h = gst_harness_new_parse ("rtph265pay timestamp-offset=123"
@@ -1379,6 +1429,7 @@ rtph265_suite (void)
   tcase_add_test (tc_chain, test_rtph265pay_marker_for_flag);
   tcase_add_test (tc_chain, test_rtph265pay_marker_for_au);
   tcase_add_test (tc_chain, test_rtph265pay_marker_for_fragmented_au);
+  tcase_add_test (tc_chain, test_rtph265pay_au_as_one_list);
   tcase_add_test (tc_chain, test_rtph265pay_aggregate_two_slices_per_buffer);
   tcase_add_test (tc_chain, test_rtph265pay_aggregate_with_aud);
   tcase_add_test (tc_chain, test_rtph265pay_aggregate_with_ts_change);
@@ -828,6 +828,53 @@ GST_START_TEST (test_lost_event)
 
 GST_END_TEST;
 
+GST_START_TEST (test_shared_timers_lost_event)
+{
+  GstHarness *h[4];
+  gint latency_ms = 100;
+  guint next_seqnum = 0;
+  guint i;
+
+  /* the timers of all jitterbuffers are handled on the shared timer pool */
+  for (i = 0; i < G_N_ELEMENTS (h); i++) {
+    GstElement *jitterbuffer = gst_element_factory_make ("rtpjitterbuffer",
+        NULL);
+
+    g_object_set (jitterbuffer, "do-lost", TRUE, "shared-timers", TRUE, NULL);
+    h[i] = gst_harness_new_with_element (jitterbuffer, "sink", "src");
+    gst_object_unref (jitterbuffer);
+    next_seqnum = construct_deterministic_initial_state (h[i], latency_ms);
+  }
+
+  /* create a gap in every stream */
+  for (i = 0; i < G_N_ELEMENTS (h); i++) {
+    push_test_buffer (h[i], next_seqnum + 1);
+    fail_unless_equals_int (0, gst_harness_buffers_in_queue (h[i]));
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (h); i++) {
+    GstBuffer *buf;
+
+    gst_harness_crank_single_clock_wait (h[i]);
+    verify_lost_event (h[i], next_seqnum,
+        next_seqnum * TEST_BUF_DURATION, TEST_BUF_DURATION);
+
+    buf = gst_harness_pull (h[i]);
+    fail_unless_equals_int (next_seqnum + 1, get_rtp_seq_num (buf));
+    gst_buffer_unref (buf);
+
+    fail_unless (verify_jb_stats (h[i]->element,
+            gst_structure_new ("application/x-rtp-jitterbuffer-stats",
+                "num-pushed", G_TYPE_UINT64, (guint64) next_seqnum + 1,
+                "num-lost", G_TYPE_UINT64, (guint64) 1, NULL)));
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (h); i++)
+    gst_harness_teardown (h[i]);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_only_one_lost_event_on_large_gaps)
 {
   GstHarness *h = gst_harness_new ("rtpjitterbuffer");
@@ -3644,6 +3691,7 @@ rtpjitterbuffer_suite (void)
   tcase_add_test (tc_chain, test_clear_pt_map);
 
   tcase_add_test (tc_chain, test_lost_event);
+  tcase_add_test (tc_chain, test_shared_timers_lost_event);
   tcase_add_test (tc_chain, test_only_one_lost_event_on_large_gaps);
   tcase_add_test (tc_chain, test_two_lost_one_arrives_in_time);
   tcase_add_test (tc_chain, test_out_of_order_loss_not_reported);
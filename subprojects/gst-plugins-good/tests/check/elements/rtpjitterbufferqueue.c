@@ -0,0 +1,229 @@
+/* GStreamer
+ *
+ * unit test for the packet queue of RTPJitterBuffer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <stdlib.h>
+
+#include <gst/check/gstcheck.h>
+#include <gst/rtp/gstrtpbuffer.h>
+#include "gst/rtpmanager/rtpjitterbuffer.h"
+
+static gboolean
+append_packet (RTPJitterBuffer * jbuf, guint16 seqnum, gboolean * duplicate)
+{
+  return rtp_jitter_buffer_append_buffer (jbuf, gst_buffer_new (), -1, -1,
+      seqnum, 0, duplicate, NULL);
+}
+
+static guint
+pop_seqnum (RTPJitterBuffer * jbuf)
+{
+  RTPJitterBufferItem *item;
+  guint seqnum;
+
+  item = rtp_jitter_buffer_pop (jbuf, NULL);
+  fail_unless (item != NULL);
+  seqnum = item->seqnum;
+  rtp_jitter_buffer_free_item (item);
+
+  return seqnum;
+}
+
+GST_START_TEST (test_insert_order)
+{
+  RTPJitterBuffer *jbuf = rtp_jitter_buffer_new ();
+  gboolean duplicate;
+
+  fail_unless (append_packet (jbuf, 10, &duplicate));
+  fail_if (duplicate);
+  fail_if (append_packet (jbuf, 13, &duplicate));
+  fail_if (append_packet (jbuf, 12, &duplicate));
+  fail_if (duplicate);
+  fail_if (append_packet (jbuf, 12, &duplicate));
+  fail_unless (duplicate);
+  /* older than everything, new head */
+  fail_unless (append_packet (jbuf, 9, &duplicate));
+  fail_if (duplicate);
+  fail_unless_equals_int (rtp_jitter_buffer_num_packets (jbuf), 4);
+
+  fail_unless_equals_int (pop_seqnum (jbuf), 9);
+  fail_unless_equals_int (pop_seqnum (jbuf), 10);
+  fail_unless_equals_int (pop_seqnum (jbuf), 12);
+  fail_unless_equals_int (pop_seqnum (jbuf), 13);
+  fail_unless (rtp_jitter_buffer_pop (jbuf, NULL) == NULL);
+
+  /* a popped seqnum is not a duplicate anymore */
+  fail_unless (append_packet (jbuf, 12, &duplicate));
+  fail_if (duplicate);
+
+  g_object_unref (jbuf);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_insert_around_events)
+{
+  RTPJitterBuffer *jbuf = rtp_jitter_buffer_new ();
+  gboolean duplicate;
+
+  append_packet (jbuf, 1, &duplicate);
+  append_packet (jbuf, 3, &duplicate);
+  rtp_jitter_buffer_append_event (jbuf, gst_event_new_eos ());
+  /* goes before the event, which came after a newer packet */
+  append_packet (jbuf, 2, &duplicate);
+  /* and after it when newer than all packets */
+  append_packet (jbuf, 4, &duplicate);
+  /* packets are inserted after the events following their predecessor */
+  rtp_jitter_buffer_append_event (jbuf, gst_event_new_eos ());
+  append_packet (jbuf, 6, &duplicate);
+  append_packet (jbuf, 5, &duplicate);
+
+  fail_unless_equals_int (pop_seqnum (jbuf), 1);
+  fail_unless_equals_int (pop_seqnum (jbuf), 2);
+  fail_unless_equals_int (pop_seqnum (jbuf), 3);
+  fail_unless_equals_int (pop_seqnum (jbuf), -1);
+  fail_unless_equals_int (pop_seqnum (jbuf), 4);
+  fail_unless_equals_int (pop_seqnum (jbuf), -1);
+  fail_unless_equals_int (pop_seqnum (jbuf), 5);
+  fail_unless_equals_int (pop_seqnum (jbuf), 6);
+
+  g_object_unref (jbuf);
+}
+
+GST_END_TEST;
+
+typedef struct
+{
+  guint n_packets;
+  guint reorder;                /* maximum reordering distance */
+  guint loss;                   /* percentage of lost packets */
+  guint duplicates;             /* percentage of duplicated packets */
+} Profile;
+
+static const Profile profiles[] = {
+  {20000, 0, 0, 0},
+  {20000, 8, 2, 2},
+  {20000, 300, 10, 5},
+  /* a 4 second window at about 2000 packets per second */
+  {40000, 8000, 1, 0},
+};
+
+typedef struct
+{
+  guint index;
+  guint key;
+} Arrival;
+
+static gint
+compare_arrival (gconstpointer a, gconstpointer b)
+{
+  const Arrival *aa = a, *ab = b;
+
+  if (aa->key != ab->key)
+    return aa->key < ab->key ? -1 : 1;
+  return aa->index < ab->index ? -1 : (aa->index > ab->index);
+}
+
+GST_START_TEST (test_reorder_profiles)
+{
+  const Profile *p = &profiles[__i__];
+  RTPJitterBuffer *jbuf = rtp_jitter_buffer_new ();
+  GRand *rand = g_rand_new_with_seed (__i__);
+  /* cover the seqnum wraparound */
+  guint16 base = 65000;
+  Arrival *arrivals;
+  guint i, max_index = 0, expected = 0, popped = 0;
+  gint last = -1;
+  gboolean duplicate;
+
+  /* every packet arrives after all packets that are more than reorder
+   * older than it */
+  arrivals = g_new (Arrival, p->n_packets);
+  for (i = 0; i < p->n_packets; i++) {
+    arrivals[i].index = i;
+    arrivals[i].key = i + (p->reorder ? g_rand_int_range (rand, 0,
+            p->reorder + 1) : 0);
+  }
+  qsort (arrivals, p->n_packets, sizeof (Arrival), compare_arrival);
+
+  for (i = 0; i < p->n_packets; i++) {
+    guint index = arrivals[i].index;
+    RTPJitterBufferItem *item;
+
+    if (g_rand_int_range (rand, 0, 100) < p->loss)
+      continue;
+
+    append_packet (jbuf, base + index, &duplicate);
+    fail_if (duplicate);
+    expected++;
+
+    if (g_rand_int_range (rand, 0, 100) < p->duplicates) {
+      append_packet (jbuf, base + index, &duplicate);
+      fail_unless (duplicate);
+    }
+
+    /* pop what can't be preceded by a packet that is still to come */
+    max_index = MAX (max_index, index);
+    while ((item = rtp_jitter_buffer_peek (jbuf))) {
+      gint head = last + gst_rtp_buffer_compare_seqnum (base + last,
+          item->seqnum);
+
+      if (head + p->reorder >= (gint) max_index)
+        break;
+
+      fail_unless (head > last);
+      last = head;
+      pop_seqnum (jbuf);
+      popped++;
+    }
+  }
+
+  while (rtp_jitter_buffer_peek (jbuf)) {
+    gint head = last + gst_rtp_buffer_compare_seqnum (base + last,
+        pop_seqnum (jbuf));
+
+    fail_unless (head > last);
+    last = head;
+    popped++;
+  }
+  fail_unless_equals_int (popped, expected);
+
+  g_free (arrivals);
+  g_rand_free (rand);
+  g_object_unref (jbuf);
+}
+
+GST_END_TEST;
+
+static Suite *
+rtpjitterbufferqueue_suite (void)
+{
+  Suite *s = suite_create ("rtpjitterbufferqueue");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_insert_order);
+  tcase_add_test (tc_chain, test_insert_around_events);
+  tcase_add_loop_test (tc_chain, test_reorder_profiles, 0,
+      G_N_ELEMENTS (profiles));
+
+  return s;
+}
+
+GST_CHECK_MAIN (rtpjitterbufferqueue);
@@ -419,6 +419,67 @@ GST_START_TEST (test_multiple_ssrc_rr)
 
 GST_END_TEST;
 
+GST_START_TEST (test_receive_rtp_list)
+{
+  SessionHarness *h = session_harness_new ();
+  GstBufferList *list = gst_buffer_list_new ();
+  guint ssrcs[] = {
+    0x01BADBAD,
+    0xDEADBEEF,
+  };
+  guint next_seqnum[G_N_ELEMENTS (ssrcs)] = { 0, };
+  gint i, j;
+
+  /* packets of both sources interleaved in one list */
+  for (i = 0; i < 10; i++) {
+    for (j = 0; j < G_N_ELEMENTS (ssrcs); j++)
+      gst_buffer_list_add (list, generate_test_buffer (i, ssrcs[j]));
+  }
+  fail_unless_equals_int (GST_FLOW_OK,
+      gst_pad_push_list (h->recv_rtp_h->srcpad, list));
+
+  /* all packets come out in order per source, including the ones that were
+   * held back during probation */
+  fail_unless_equals_int (20, gst_harness_buffers_in_queue (h->recv_rtp_h));
+  for (i = 0; i < 20; i++) {
+    GstBuffer *buf = gst_harness_pull (h->recv_rtp_h);
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+    guint32 ssrc;
+    guint16 seqnum;
+
+    fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+    ssrc = gst_rtp_buffer_get_ssrc (&rtp);
+    seqnum = gst_rtp_buffer_get_seq (&rtp);
+    gst_rtp_buffer_unmap (&rtp);
+    gst_buffer_unref (buf);
+
+    j = ssrc == ssrcs[0] ? 0 : 1;
+    fail_unless_equals_int (ssrcs[j], ssrc);
+    fail_unless_equals_int (next_seqnum[j], seqnum);
+    next_seqnum[j]++;
+  }
+
+  for (j = 0; j < G_N_ELEMENTS (ssrcs); j++) {
+    GObject *source;
+    GstStructure *stats;
+    guint64 packets_received;
+
+    g_signal_emit_by_name (h->internal_session, "get-source-by-ssrc", ssrcs[j],
+        &source);
+    fail_unless (source != NULL);
+    g_object_get (source, "stats", &stats, NULL);
+    fail_unless (gst_structure_get_uint64 (stats, "packets-received",
+            &packets_received));
+    fail_unless_equals_uint64 (10, packets_received);
+    gst_structure_free (stats);
+    g_object_unref (source);
+  }
+
+  session_harness_free (h);
+}
+
+GST_END_TEST;
+
 /* This verifies that rtpsession will correctly place RBs round-robin
  * across multiple RRs when there are too many senders that their RBs
  * do not fit in one RR */
@@ -4601,6 +4662,7 @@ rtpsession_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_multiple_ssrc_rr);
+  tcase_add_test (tc_chain, test_receive_rtp_list);
   tcase_add_test (tc_chain, test_multiple_senders_roundrobin_rbs);
   tcase_add_test (tc_chain, test_no_rbs_for_internal_senders);
   tcase_add_test (tc_chain, test_internal_sources_timeout);
@@ -0,0 +1,244 @@
+/* GStreamer
+ *
+ * rtpbin-bench.c: measure adding and removing many sessions on rtpbin
+ * while packets are flowing
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Requests the RTP and RTCP sink pads of many sessions on a playing rtpbin,
+ * pushes packets of a few SSRCs into every session so that each of them gets
+ * its jitterbuffers, and releases all pads again:
+ *
+ *   rtpbin-bench --sessions 1000 --ssrcs 2 --packets 50
+ */
+
+#include <string.h>
+#include <gst/gst.h>
+#include <gst/rtp/gstrtpbuffer.h>
+#include <gst/rtp/gstrtcpbuffer.h>
+
+static gint n_sessions = 1000;
+static gint n_ssrcs = 2;
+static gint n_packets = 50;
+
+static GOptionEntry entries[] = {
+  {"sessions", 'n', 0, G_OPTION_ARG_INT, &n_sessions,
+      "Number of sessions to create", NULL},
+  {"ssrcs", 's', 0, G_OPTION_ARG_INT, &n_ssrcs,
+      "Number of SSRCs per session", NULL},
+  {"packets", 'p', 0, G_OPTION_ARG_INT, &n_packets,
+      "Number of packets per SSRC", NULL},
+  {NULL}
+};
+
+typedef struct
+{
+  GstPad *rtp_src;
+  GstPad *rtcp_src;
+  GstPad *rtp_sink;
+  GstPad *rtcp_sink;
+} Session;
+
+static GstFlowReturn
+drop_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  gst_buffer_unref (buffer);
+  return GST_FLOW_OK;
+}
+
+static void
+on_pad_added (GstElement * rtpbin, GstPad * pad, gpointer user_data)
+{
+  GstPad *sinkpad;
+
+  if (GST_PAD_DIRECTION (pad) != GST_PAD_SRC)
+    return;
+
+  /* drop everything coming out of the jitterbuffers */
+  sinkpad = gst_pad_new ("sink", GST_PAD_SINK);
+  gst_pad_set_chain_function (sinkpad, drop_chain);
+  gst_pad_set_active (sinkpad, TRUE);
+  gst_pad_link (pad, sinkpad);
+  gst_object_unref (sinkpad);
+}
+
+static GstPad *
+link_src_pad (GstElement * rtpbin, const gchar * name, GstPad ** sink,
+    GstCaps * caps)
+{
+  GstPad *src;
+  GstSegment segment;
+
+  *sink = gst_element_request_pad_simple (rtpbin, name);
+  g_assert (*sink != NULL);
+
+  src = gst_pad_new ("src", GST_PAD_SRC);
+  gst_pad_set_active (src, TRUE);
+  gst_pad_link (src, *sink);
+
+  gst_pad_push_event (src, gst_event_new_stream_start (name));
+  gst_pad_push_event (src, gst_event_new_caps (caps));
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  gst_pad_push_event (src, gst_event_new_segment (&segment));
+
+  return src;
+}
+
+static GstBuffer *
+make_rtp_packet (guint32 ssrc, guint16 seqnum)
+{
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstBuffer *buf;
+
+  buf = gst_rtp_buffer_new_allocate (160, 0, 0);
+  gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp);
+  gst_rtp_buffer_set_payload_type (&rtp, 0);
+  gst_rtp_buffer_set_ssrc (&rtp, ssrc);
+  gst_rtp_buffer_set_seq (&rtp, seqnum);
+  gst_rtp_buffer_set_timestamp (&rtp, seqnum * 160);
+  gst_rtp_buffer_unmap (&rtp);
+
+  return buf;
+}
+
+/* a sender report with the CNAME, which associates the SSRC with a client */
+static GstBuffer *
+make_rtcp_packet (guint32 ssrc, guint session)
+{
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket packet;
+  GstBuffer *buf;
+  gchar *cname;
+
+  buf = gst_rtcp_buffer_new (1400);
+  gst_rtcp_buffer_map (buf, GST_MAP_READWRITE, &rtcp);
+  gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_SR, &packet);
+  gst_rtcp_packet_sr_set_sender_info (&packet, ssrc, 0, 0, 0, 0);
+  gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_SDES, &packet);
+  gst_rtcp_packet_sdes_add_item (&packet, ssrc);
+  cname = g_strdup_printf ("client%u@bench", session);
+  gst_rtcp_packet_sdes_add_entry (&packet, GST_RTCP_SDES_CNAME,
+      strlen (cname), (const guint8 *) cname);
+  g_free (cname);
+  gst_rtcp_buffer_unmap (&rtcp);
+
+  return buf;
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *ctx;
+  GError *err = NULL;
+  GstElement *pipeline, *rtpbin;
+  GstCaps *rtp_caps, *rtcp_caps;
+  Session *sessions;
+  GstClockTime start, created, pushed, released;
+  gint i, j, k;
+
+  ctx = g_option_context_new ("- rtpbin session benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", err->message);
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (n_sessions <= 0 || n_ssrcs <= 0 || n_packets <= 0) {
+    g_print ("Invalid arguments\n");
+    return 1;
+  }
+
+  pipeline = gst_pipeline_new (NULL);
+  rtpbin = gst_element_factory_make ("rtpbin", NULL);
+  if (!rtpbin) {
+    g_print ("rtpbin not available\n");
+    return 1;
+  }
+  g_object_set (rtpbin, "latency", 0, NULL);
+  gst_bin_add (GST_BIN (pipeline), rtpbin);
+  g_signal_connect (rtpbin, "pad-added", G_CALLBACK (on_pad_added), NULL);
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  rtp_caps = gst_caps_from_string ("application/x-rtp, media=audio, "
+      "clock-rate=8000, encoding-name=PCMU, payload=0");
+  rtcp_caps = gst_caps_new_empty_simple ("application/x-rtcp");
+  sessions = g_new0 (Session, n_sessions);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < n_sessions; i++) {
+    gchar *name;
+
+    name = g_strdup_printf ("recv_rtp_sink_%u", i);
+    sessions[i].rtp_src = link_src_pad (rtpbin, name, &sessions[i].rtp_sink,
+        rtp_caps);
+    g_free (name);
+    name = g_strdup_printf ("recv_rtcp_sink_%u", i);
+    sessions[i].rtcp_src = link_src_pad (rtpbin, name, &sessions[i].rtcp_sink,
+        rtcp_caps);
+    g_free (name);
+  }
+  created = gst_util_get_timestamp ();
+
+  for (k = 0; k < n_packets; k++) {
+    for (i = 0; i < n_sessions; i++) {
+      for (j = 0; j < n_ssrcs; j++) {
+        guint32 ssrc = i * n_ssrcs + j + 1;
+
+        gst_pad_push (sessions[i].rtp_src, make_rtp_packet (ssrc, k));
+        if (k == n_packets / 2)
+          gst_pad_push (sessions[i].rtcp_src, make_rtcp_packet (ssrc, i));
+      }
+    }
+  }
+  pushed = gst_util_get_timestamp ();
+
+  /* release in creation order, the oldest sessions are at the end of the
+   * internal lists */
+  for (i = 0; i < n_sessions; i++) {
+    gst_object_unref (sessions[i].rtp_src);
+    gst_object_unref (sessions[i].rtcp_src);
+    gst_element_release_request_pad (rtpbin, sessions[i].rtp_sink);
+    gst_element_release_request_pad (rtpbin, sessions[i].rtcp_sink);
+    gst_object_unref (sessions[i].rtp_sink);
+    gst_object_unref (sessions[i].rtcp_sink);
+  }
+  released = gst_util_get_timestamp ();
+
+  g_print ("%d sessions with %d SSRCs each\n", n_sessions, n_ssrcs);
+  g_print ("create:  %" GST_TIME_FORMAT " (%.1f us per session)\n",
+      GST_TIME_ARGS (created - start),
+      (gdouble) (created - start) / n_sessions / 1000);
+  g_print ("push:    %" GST_TIME_FORMAT " (%.1f us per packet)\n",
+      GST_TIME_ARGS (pushed - created),
+      (gdouble) (pushed - created) / ((gdouble) n_sessions * n_ssrcs *
+          n_packets) / 1000);
+  g_print ("release: %" GST_TIME_FORMAT " (%.1f us per session)\n",
+      GST_TIME_ARGS (released - pushed),
+      (gdouble) (released - pushed) / n_sessions / 1000);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+  gst_caps_unref (rtp_caps);
+  gst_caps_unref (rtcp_caps);
+  g_free (sessions);
+
+  return 0;
+}
@@ -0,0 +1,160 @@
+/* GStreamer
+ *
+ * rtpfec-bench.c: measure SMPTE 2022-1 FEC protection and recovery of a
+ * raw 1080p stream with simulated packet loss
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Payloads raw video, protects it with row and column FEC, drops packets
+ * with netsim (from gst-plugins-bad) and recovers them again:
+ *
+ *   rtpfec-bench --frames 100 --columns 20 --rows 10 --loss 1
+ *
+ * Use --loss 0 to only measure the protection overhead.
+ */
+
+#include <gst/gst.h>
+
+static gint n_frames = 100;
+static gint columns = 20;
+static gint rows = 10;
+static gdouble loss = 1.0;
+
+static GOptionEntry entries[] = {
+  {"frames", 'n', 0, G_OPTION_ARG_INT, &n_frames,
+      "Number of video frames to send", NULL},
+  {"columns", 'c', 0, G_OPTION_ARG_INT, &columns,
+      "Number of columns of the FEC matrix", NULL},
+  {"rows", 'r', 0, G_OPTION_ARG_INT, &rows,
+      "Number of rows of the FEC matrix", NULL},
+  {"loss", 'l', 0, G_OPTION_ARG_DOUBLE, &loss,
+      "Percentage of lost packets", NULL},
+  {NULL}
+};
+
+static GstPadProbeReturn
+count_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  guint *count = user_data;
+
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST)
+    *count += gst_buffer_list_length (GST_PAD_PROBE_INFO_BUFFER_LIST (info));
+  else
+    *count += 1;
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+add_count_probe (GstElement * pipeline, const gchar * name, const gchar * pad,
+    guint * count)
+{
+  GstElement *element;
+  GstPad *srcpad;
+
+  element = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  srcpad = gst_element_get_static_pad (element, pad);
+  gst_pad_add_probe (srcpad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST, count_probe,
+      count, NULL);
+  gst_object_unref (srcpad);
+  gst_object_unref (element);
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *ctx;
+  GError *err = NULL;
+  GstElement *pipeline;
+  GstBus *bus;
+  GstMessage *msg;
+  gchar *desc;
+  GstClockTime start, end;
+  guint sent = 0, received = 0, output = 0;
+  gint ret = 0;
+
+  ctx = g_option_context_new ("- SMPTE 2022-1 FEC benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", err->message);
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (n_frames <= 0 || columns <= 0 || rows < 0 || loss < 0 || loss > 100) {
+    g_print ("Invalid arguments\n");
+    return 1;
+  }
+
+  /* the FEC streams go through their own netsim, like on separate ports */
+  desc = g_strdup_printf ("videotestsrc num-buffers=%d pattern=ball ! "
+      "video/x-raw, format=UYVY, width=1920, height=1080, framerate=30/1 ! "
+      "rtpvrawpay name=pay ! "
+      "rtpst2022-1-fecenc name=enc columns=%d rows=%d "
+      "enable-column-fec=%s enable-row-fec=true ! "
+      "netsim name=media drop-probability=%f ! "
+      "rtpst2022-1-fecdec name=dec size-time=1000000000 ! "
+      "fakesink name=sink sync=false "
+      "enc.fec_0 ! netsim drop-probability=%f ! dec.fec_0 "
+      "enc.fec_1 ! netsim drop-probability=%f ! dec.fec_1",
+      n_frames, columns, rows, rows > 0 ? "true" : "false", loss / 100,
+      loss / 100, loss / 100);
+  pipeline = gst_parse_launch (desc, &err);
+  g_free (desc);
+  if (!pipeline) {
+    g_print ("Failed to create pipeline: %s\n", err->message);
+    g_clear_error (&err);
+    return 1;
+  }
+
+  add_count_probe (pipeline, "pay", "src", &sent);
+  add_count_probe (pipeline, "media", "src", &received);
+  add_count_probe (pipeline, "dec", "src", &output);
+
+  start = gst_util_get_timestamp ();
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  end = gst_util_get_timestamp ();
+
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    gst_message_parse_error (msg, &err, NULL);
+    g_print ("Error: %s\n", err->message);
+    g_clear_error (&err);
+    ret = 1;
+  } else {
+    g_print ("%u packets sent, %u lost, %u recovered\n", sent,
+        sent - received, output - received);
+    g_print ("%" GST_TIME_FORMAT " total, %.1f us per frame, "
+        "%.1f ns per packet\n", GST_TIME_ARGS (end - start),
+        (gdouble) (end - start) / n_frames / 1000,
+        (gdouble) (end - start) / sent);
+  }
+
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
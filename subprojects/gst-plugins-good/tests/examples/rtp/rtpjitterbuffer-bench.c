@@ -0,0 +1,159 @@
+/* GStreamer
+ *
+ * rtpjitterbuffer-bench.c: measure the packet queue of the jitterbuffer
+ * with configurable reordering and loss
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Simulates a stream going through the jitterbuffer: packets are inserted
+ * in arrival order and popped once they are older than the latency window.
+ *
+ *   rtpjitterbuffer-bench --packets 1000000 --rate 2000 --latency 4000 \
+ *       --reorder 50 --loss 1
+ */
+
+#include <stdlib.h>
+#include <gst/gst.h>
+#include <gst/rtp/gstrtpbuffer.h>
+
+#include "../../../gst/rtpmanager/rtpjitterbuffer.h"
+
+static gint n_packets = 1000000;
+static gint rate = 2000;
+static gint latency = 4000;
+static gint reorder = 0;
+static gdouble loss = 0.0;
+static gdouble duplicates = 0.0;
+static gint seed = 0;
+
+static GOptionEntry entries[] = {
+  {"packets", 'n', 0, G_OPTION_ARG_INT, &n_packets,
+      "Number of packets to send", NULL},
+  {"rate", 'r', 0, G_OPTION_ARG_INT, &rate, "Packets per second", NULL},
+  {"latency", 'l', 0, G_OPTION_ARG_INT, &latency,
+      "Jitterbuffer latency in milliseconds", NULL},
+  {"reorder", 'o', 0, G_OPTION_ARG_INT, &reorder,
+      "Maximum number of packets a packet can arrive late", NULL},
+  {"loss", 0, 0, G_OPTION_ARG_DOUBLE, &loss,
+      "Percentage of lost packets", NULL},
+  {"duplicates", 0, 0, G_OPTION_ARG_DOUBLE, &duplicates,
+      "Percentage of duplicated packets", NULL},
+  {"seed", 's', 0, G_OPTION_ARG_INT, &seed, "Random seed", NULL},
+  {NULL}
+};
+
+typedef struct
+{
+  guint index;
+  guint key;
+} Arrival;
+
+static gint
+compare_arrival (gconstpointer a, gconstpointer b)
+{
+  const Arrival *aa = a, *ab = b;
+
+  if (aa->key != ab->key)
+    return aa->key < ab->key ? -1 : 1;
+  return aa->index < ab->index ? -1 : (aa->index > ab->index);
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *ctx;
+  GError *err = NULL;
+  RTPJitterBuffer *jbuf;
+  RTPJitterBufferItem *item;
+  Arrival *arrivals;
+  GRand *rand;
+  GstClockTime interval, window, start, end;
+  guint i, inserted = 0, dups = 0, max_queued = 0;
+
+  ctx = g_option_context_new ("- RTP jitterbuffer queue benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", err->message);
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (n_packets <= 0 || rate <= 0 || latency < 0 || reorder < 0) {
+    g_print ("Invalid arguments\n");
+    return 1;
+  }
+
+  interval = GST_SECOND / rate;
+  window = latency * GST_MSECOND;
+  rand = g_rand_new_with_seed (seed);
+
+  /* a packet arrives at most reorder packets later than in order */
+  arrivals = g_new (Arrival, n_packets);
+  for (i = 0; i < (guint) n_packets; i++) {
+    arrivals[i].index = i;
+    arrivals[i].key = i + (reorder ? g_rand_int_range (rand, 0,
+            reorder + 1) : 0);
+  }
+  qsort (arrivals, n_packets, sizeof (Arrival), compare_arrival);
+
+  jbuf = rtp_jitter_buffer_new ();
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < (guint) n_packets; i++) {
+    GstClockTime now = i * interval;
+    guint16 seqnum = arrivals[i].index;
+    gboolean duplicate;
+    guint n;
+
+    if (g_rand_double_range (rand, 0, 100) < loss)
+      continue;
+
+    rtp_jitter_buffer_append_buffer (jbuf, gst_buffer_new (), now, -1,
+        seqnum, 0, &duplicate, NULL);
+    inserted++;
+
+    if (g_rand_double_range (rand, 0, 100) < duplicates) {
+      rtp_jitter_buffer_append_buffer (jbuf, gst_buffer_new (), now, -1,
+          seqnum, 0, &duplicate, NULL);
+      dups += duplicate;
+    }
+
+    n = rtp_jitter_buffer_num_packets (jbuf);
+    max_queued = MAX (max_queued, n);
+
+    /* release what is older than the latency */
+    while ((item = rtp_jitter_buffer_peek (jbuf)) && item->dts + window < now)
+      rtp_jitter_buffer_free_item (rtp_jitter_buffer_pop (jbuf, NULL));
+  }
+  while ((item = rtp_jitter_buffer_pop (jbuf, NULL)))
+    rtp_jitter_buffer_free_item (item);
+  end = gst_util_get_timestamp ();
+
+  g_print ("%u packets inserted, %u duplicates, up to %u queued\n", inserted,
+      dups, max_queued);
+  g_print ("%" GST_TIME_FORMAT " total, %.1f ns per packet\n",
+      GST_TIME_ARGS (end - start), (gdouble) (end - start) / inserted);
+
+  g_object_unref (jbuf);
+  g_rand_free (rand);
+  g_free (arrivals);
+
+  return 0;
+}
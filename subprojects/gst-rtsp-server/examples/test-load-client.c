@@ -0,0 +1,347 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Opens many RTSP sessions with RTP interleaved over TCP and counts the
+ * received data, without depayloading or decoding anything:
+ *
+ *   test-load-client --clients 2000 rtsp://127.0.0.1:8554/test
+ *
+ * Use a shared media on the server, for example test-launch with
+ * gst_rtsp_media_factory_set_shared().
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gst/gst.h>
+#include <gst/rtsp/rtsp.h>
+#include <gst/sdp/sdp.h>
+
+#define DEFAULT_CLIENTS 100
+#define KEEPALIVE_INTERVAL 30
+
+static gint n_clients = DEFAULT_CLIENTS;
+static gint duration = 0;
+
+static GOptionEntry entries[] = {
+  {"clients", 'c', 0, G_OPTION_ARG_INT, &n_clients,
+      "Number of clients to connect (default: 100)", "CLIENTS"},
+  {"duration", 'd', 0, G_OPTION_ARG_INT, &duration,
+      "Stop after this many seconds (default: run until interrupted)",
+      "SECONDS"},
+  {NULL}
+};
+
+typedef struct
+{
+  GstRTSPConnection *conn;
+  GstRTSPWatch *watch;
+  gchar *session;
+  guint cseq;
+} Client;
+
+static guint64 total_packets;
+static guint64 total_bytes;
+static guint n_connected;
+
+static GstRTSPResult
+message_received (GstRTSPWatch * watch, GstRTSPMessage * message,
+    gpointer user_data)
+{
+  if (gst_rtsp_message_get_type (message) == GST_RTSP_MESSAGE_DATA) {
+    guint8 *data;
+    guint size;
+
+    gst_rtsp_message_get_body (message, &data, &size);
+    total_packets++;
+    total_bytes += size;
+  }
+
+  return GST_RTSP_OK;
+}
+
+static GstRTSPResult
+closed (GstRTSPWatch * watch, gpointer user_data)
+{
+  n_connected--;
+
+  return GST_RTSP_OK;
+}
+
+static GstRTSPResult
+error_full (GstRTSPWatch * watch, GstRTSPResult result,
+    GstRTSPMessage * message, guint id, gpointer user_data)
+{
+  gchar *str = gst_rtsp_strresult (result);
+
+  g_printerr ("client %p: %s\n", user_data, str);
+  g_free (str);
+
+  return GST_RTSP_OK;
+}
+
+static GstRTSPWatchFuncs watch_funcs = {
+  message_received,
+  NULL,
+  closed,
+  NULL,
+  NULL,
+  NULL,
+  error_full,
+  NULL
+};
+
+static gboolean
+request (Client * client, GstRTSPMethod method, const gchar * url,
+    const gchar * transport, GstRTSPMessage * response)
+{
+  GstRTSPMessage req = { 0 };
+  GstRTSPStatusCode code;
+  GstRTSPResult res;
+
+  gst_rtsp_message_init_request (&req, method, url);
+  gst_rtsp_message_take_header (&req, GST_RTSP_HDR_CSEQ,
+      g_strdup_printf ("%u", client->cseq++));
+  if (transport)
+    gst_rtsp_message_add_header (&req, GST_RTSP_HDR_TRANSPORT, transport);
+  if (method == GST_RTSP_DESCRIBE)
+    gst_rtsp_message_add_header (&req, GST_RTSP_HDR_ACCEPT, "application/sdp");
+  if (client->session)
+    gst_rtsp_message_add_header (&req, GST_RTSP_HDR_SESSION, client->session);
+
+  res = gst_rtsp_connection_send_usec (client->conn, &req, 5 * G_USEC_PER_SEC);
+  gst_rtsp_message_unset (&req);
+  if (res != GST_RTSP_OK)
+    return FALSE;
+
+  res = gst_rtsp_connection_receive_usec (client->conn, response,
+      5 * G_USEC_PER_SEC);
+  if (res != GST_RTSP_OK)
+    return FALSE;
+
+  if (gst_rtsp_message_parse_response (response, &code, NULL,
+          NULL) != GST_RTSP_OK || code != GST_RTSP_STS_OK) {
+    gst_rtsp_message_unset (response);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+static gboolean
+setup_streams (Client * client, const gchar * url, GstSDPMessage * sdp)
+{
+  guint i;
+
+  for (i = 0; i < gst_sdp_message_medias_len (sdp); i++) {
+    const GstSDPMedia *media = gst_sdp_message_get_media (sdp, i);
+    const gchar *control = gst_sdp_media_get_attribute_val (media, "control");
+    GstRTSPMessage response = { 0 };
+    gchar *setup_url, *transport;
+    gboolean ret;
+
+    if (control == NULL)
+      setup_url = g_strdup (url);
+    else if (g_str_has_prefix (control, "rtsp://"))
+      setup_url = g_strdup (control);
+    else
+      setup_url = g_strdup_printf ("%s/%s", url, control);
+
+    transport = g_strdup_printf ("RTP/AVP/TCP;unicast;interleaved=%u-%u",
+        2 * i, 2 * i + 1);
+    ret = request (client, GST_RTSP_SETUP, setup_url, transport, &response);
+    g_free (transport);
+    g_free (setup_url);
+    if (!ret)
+      return FALSE;
+
+    if (client->session == NULL) {
+      gchar *session;
+
+      if (gst_rtsp_message_get_header (&response, GST_RTSP_HDR_SESSION,
+              &session, 0) != GST_RTSP_OK) {
+        gst_rtsp_message_unset (&response);
+        return FALSE;
+      }
+      /* strip the timeout */
+      client->session = g_strndup (session, strcspn (session, ";"));
+    }
+    gst_rtsp_message_unset (&response);
+  }
+
+  return TRUE;
+}
+
+static gboolean
+connect_client (Client * client, GstRTSPUrl * url, const gchar * url_str)
+{
+  GstRTSPMessage response = { 0 };
+  GstSDPMessage *sdp;
+  guint8 *data;
+  guint size;
+  gboolean ret;
+
+  if (gst_rtsp_connection_create (url, &client->conn) != GST_RTSP_OK)
+    return FALSE;
+  if (gst_rtsp_connection_connect_usec (client->conn,
+          5 * G_USEC_PER_SEC) != GST_RTSP_OK)
+    return FALSE;
+
+  if (!request (client, GST_RTSP_DESCRIBE, url_str, NULL, &response))
+    return FALSE;
+
+  gst_sdp_message_new (&sdp);
+  gst_rtsp_message_get_body (&response, &data, &size);
+  gst_sdp_message_parse_buffer (data, size, sdp);
+  gst_rtsp_message_unset (&response);
+
+  ret = setup_streams (client, url_str, sdp);
+  gst_sdp_message_free (sdp);
+  if (!ret)
+    return FALSE;
+
+  if (!request (client, GST_RTSP_PLAY, url_str, NULL, &response))
+    return FALSE;
+  gst_rtsp_message_unset (&response);
+
+  /* from now on everything is received asynchronously */
+  client->watch = gst_rtsp_watch_new (client->conn, &watch_funcs, client,
+      NULL);
+  gst_rtsp_watch_attach (client->watch, NULL);
+  n_connected++;
+
+  return TRUE;
+}
+
+static gboolean
+keepalive (gpointer user_data)
+{
+  GPtrArray *clients = user_data;
+  guint i;
+
+  for (i = 0; i < clients->len; i++) {
+    Client *client = g_ptr_array_index (clients, i);
+    GstRTSPMessage req = { 0 };
+
+    if (client->watch == NULL)
+      continue;
+
+    gst_rtsp_message_init_request (&req, GST_RTSP_GET_PARAMETER, "*");
+    gst_rtsp_message_take_header (&req, GST_RTSP_HDR_CSEQ,
+        g_strdup_printf ("%u", client->cseq++));
+    gst_rtsp_message_add_header (&req, GST_RTSP_HDR_SESSION, client->session);
+    gst_rtsp_watch_send_message (client->watch, &req, NULL);
+    gst_rtsp_message_unset (&req);
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+print_stats (gpointer user_data)
+{
+  static guint64 last_packets, last_bytes;
+
+  g_print ("%u clients connected, %" G_GUINT64_FORMAT " packets/s, %.1f "
+      "Mbit/s\n", n_connected, total_packets - last_packets,
+      (total_bytes - last_bytes) * 8 / 1000000.0);
+  last_packets = total_packets;
+  last_bytes = total_bytes;
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+quit (gpointer user_data)
+{
+  g_main_loop_quit (user_data);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+free_client (Client * client)
+{
+  if (client->watch) {
+    g_source_destroy ((GSource *) client->watch);
+    gst_rtsp_watch_unref (client->watch);
+  }
+  if (client->conn)
+    gst_rtsp_connection_free (client->conn);
+  g_free (client->session);
+  g_free (client);
+}
+
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *optctx;
+  GError *error = NULL;
+  GMainLoop *loop;
+  GstRTSPUrl *url;
+  GPtrArray *clients;
+  gint i;
+
+  optctx = g_option_context_new ("<rtsp url> - RTSP over TCP load client");
+  g_option_context_add_main_entries (optctx, entries, NULL);
+  g_option_context_add_group (optctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (optctx, &argc, &argv, &error)) {
+    g_printerr ("Error parsing options: %s\n", error->message);
+    g_option_context_free (optctx);
+    g_clear_error (&error);
+    return -1;
+  }
+  g_option_context_free (optctx);
+
+  if (argc < 2 || n_clients <= 0) {
+    g_printerr ("Usage: %s [--clients N] <rtsp url>\n", argv[0]);
+    return -1;
+  }
+
+  if (gst_rtsp_url_parse (argv[1], &url) != GST_RTSP_OK) {
+    g_printerr ("Invalid URL %s\n", argv[1]);
+    return -1;
+  }
+
+  loop = g_main_loop_new (NULL, FALSE);
+  clients = g_ptr_array_new_with_free_func ((GDestroyNotify) free_client);
+
+  for (i = 0; i < n_clients; i++) {
+    Client *client = g_new0 (Client, 1);
+
+    client->cseq = 1;
+    g_ptr_array_add (clients, client);
+    if (!connect_client (client, url, argv[1])) {
+      g_printerr ("Failed to connect client %d\n", i);
+      break;
+    }
+  }
+
+  g_timeout_add_seconds (1, print_stats, NULL);
+  g_timeout_add_seconds (KEEPALIVE_INTERVAL, keepalive, clients);
+  if (duration > 0)
+    g_timeout_add_seconds (duration, quit, loop);
+
+  g_main_loop_run (loop);
+
+  g_ptr_array_unref (clients);
+  gst_rtsp_url_free (url);
+  g_main_loop_unref (loop);
+
+  return 0;
+}
@@ -103,6 +103,8 @@ struct _GstRTSPClientPrivate
 
   gboolean drop_backlog;
   gint post_session_timeout;
+  GstClockTime max_backlog_duration;
+  GstRTSPBacklogPolicy backlog_policy;
 
   guint content_length_limit;
 
@@ -132,6 +134,8 @@ static GHashTable *tunnels;     /* protected by tunnels_lock */
 #define DEFAULT_MOUNT_POINTS            NULL
 #define DEFAULT_DROP_BACKLOG            TRUE
 #define DEFAULT_POST_SESSION_TIMEOUT    -1
+#define DEFAULT_MAX_BACKLOG_DURATION    (10 * GST_SECOND)
+#define DEFAULT_BACKLOG_POLICY          GST_RTSP_BACKLOG_POLICY_DISCONNECT
 
 #define RTSP_CTRL_CB_INTERVAL           1
 #define RTSP_CTRL_TIMEOUT_VALUE         60
@@ -143,6 +147,8 @@ enum
   PROP_MOUNT_POINTS,
   PROP_DROP_BACKLOG,
   PROP_POST_SESSION_TIMEOUT,
+  PROP_MAX_BACKLOG_DURATION,
+  PROP_BACKLOG_POLICY,
   PROP_LAST
 };
 
@@ -278,6 +284,35 @@ gst_rtsp_client_class_init (GstRTSPClientClass * klass)
           G_MAXINT, DEFAULT_POST_SESSION_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRTSPClient:max-backlog-duration:
+   *
+   * The maximum duration of the RTP data that is queued for each TCP
+   * transport of the client when it does not read fast enough. What happens
+   * when more is queued is decided by #GstRTSPClient:backlog-policy.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_BACKLOG_DURATION,
+      g_param_spec_uint64 ("max-backlog-duration", "Max Backlog Duration",
+          "Maximum duration of data queued for a TCP transport", 0,
+          G_MAXUINT64 - 1, DEFAULT_MAX_BACKLOG_DURATION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstRTSPClient:backlog-policy:
+   *
+   * What to do when the data queued for a TCP transport of the client exceeds
+   * #GstRTSPClient:max-backlog-duration.
+   *
+   * Since: 1.28
+   */
+  g_object_class_install_property (gobject_class, PROP_BACKLOG_POLICY,
+      g_param_spec_enum ("backlog-policy", "Backlog Policy",
+          "What to do when the data queued for a TCP transport is too large",
+          GST_TYPE_RTSP_BACKLOG_POLICY, DEFAULT_BACKLOG_POLICY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_rtsp_client_signals[SIGNAL_CLOSED] =
       g_signal_new ("closed", G_TYPE_FROM_CLASS (klass), G_SIGNAL_RUN_LAST,
       G_STRUCT_OFFSET (GstRTSPClientClass, closed), NULL, NULL, NULL,
@@ -611,6 +646,8 @@ gst_rtsp_client_init (GstRTSPClient * client)
   priv->data_seqs = g_array_new (FALSE, FALSE, sizeof (DataSeq));
   priv->drop_backlog = DEFAULT_DROP_BACKLOG;
   priv->post_session_timeout = DEFAULT_POST_SESSION_TIMEOUT;
+  priv->max_backlog_duration = DEFAULT_MAX_BACKLOG_DURATION;
+  priv->backlog_policy = DEFAULT_BACKLOG_POLICY;
   priv->transports =
       g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
       g_object_unref);
@@ -827,6 +864,12 @@ gst_rtsp_client_get_property (GObject * object, guint propid,
     case PROP_POST_SESSION_TIMEOUT:
       g_value_set_int (value, priv->post_session_timeout);
       break;
+    case PROP_MAX_BACKLOG_DURATION:
+      g_value_set_uint64 (value, priv->max_backlog_duration);
+      break;
+    case PROP_BACKLOG_POLICY:
+      g_value_set_enum (value, priv->backlog_policy);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, propid, pspec);
   }
@@ -856,6 +899,16 @@ gst_rtsp_client_set_property (GObject * object, guint propid,
       priv->post_session_timeout = g_value_get_int (value);
       g_mutex_unlock (&priv->lock);
       break;
+    case PROP_MAX_BACKLOG_DURATION:
+      g_mutex_lock (&priv->lock);
+      priv->max_backlog_duration = g_value_get_uint64 (value);
+      g_mutex_unlock (&priv->lock);
+      break;
+    case PROP_BACKLOG_POLICY:
+      g_mutex_lock (&priv->lock);
+      priv->backlog_policy = g_value_get_enum (value);
+      g_mutex_unlock (&priv->lock);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, propid, pspec);
   }
@@ -3025,6 +3078,10 @@ handle_setup_request (GstRTSPClient * client, GstRTSPContext * ctx)
     gst_rtsp_stream_transport_set_back_pressure_callback (trans,
         (GstRTSPBackPressureFunc) do_check_back_pressure, client, NULL);
 
+    gst_rtsp_stream_transport_set_max_backlog (trans,
+        priv->max_backlog_duration);
+    gst_rtsp_stream_transport_set_backlog_policy (trans, priv->backlog_policy);
+
     g_hash_table_insert (priv->transports,
         GINT_TO_POINTER (ct->interleaved.min), trans);
     g_object_ref (trans);
@@ -40,6 +40,11 @@ gboolean                 gst_rtsp_stream_transport_backlog_pop   (GstRTSPStreamT
                                                                   GstBufferList **buffer_list,
                                                                   gboolean *is_rtp);
 
+gboolean                 gst_rtsp_stream_transport_backlog_pop_batch (GstRTSPStreamTransport *trans,
+                                                                  GstBuffer **buffer,
+                                                                  GstBufferList **buffer_list,
+                                                                  gboolean *is_rtp);
+
 gboolean                 gst_rtsp_stream_transport_backlog_peek_is_rtp (GstRTSPStreamTransport * trans);
 
 gboolean                 gst_rtsp_stream_transport_backlog_is_empty (GstRTSPStreamTransport *trans);
@@ -38,6 +38,11 @@
  * A #GstRTSPClient will call gst_rtsp_stream_transport_message_sent() when it
  * has sent a data message for the transport.
  *
+ * Data for TCP transports is queued in a backlog while the client can't keep
+ * up. With gst_rtsp_stream_transport_set_max_backlog() and
+ * gst_rtsp_stream_transport_set_backlog_policy() it can be configured how
+ * much data is queued and what happens when there is more.
+ *
  * Last reviewed on 2013-07-16 (1.0.0)
  */
 #ifdef HAVE_CONFIG_H
@@ -90,10 +95,15 @@ struct _GstRTSPStreamTransportPrivate
   GstClockTime first_rtp_timestamp;
   GstVecDeque *items;
   GRecMutex backlog_lock;
+  GstClockTime max_backlog_duration;
+  GstRTSPBacklogPolicy backlog_policy;
 };
 
-#define MAX_BACKLOG_DURATION (10 * GST_SECOND)
+#define DEFAULT_MAX_BACKLOG_DURATION (10 * GST_SECOND)
+#define DEFAULT_BACKLOG_POLICY GST_RTSP_BACKLOG_POLICY_DISCONNECT
 #define MAX_BACKLOG_SIZE 100
+/* maximum number of buffers sent from the backlog in one go */
+#define MAX_BACKLOG_BATCH 64
 
 typedef struct
 {
@@ -114,6 +124,27 @@ GST_DEBUG_CATEGORY_STATIC (rtsp_stream_transport_debug);
 
 static void gst_rtsp_stream_transport_finalize (GObject * obj);
 
+#define C_ENUM(v) ((gint) v)
+
+GType
+gst_rtsp_backlog_policy_get_type (void)
+{
+  static gsize id = 0;
+  static const GEnumValue values[] = {
+    {C_ENUM (GST_RTSP_BACKLOG_POLICY_DISCONNECT),
+        "GST_RTSP_BACKLOG_POLICY_DISCONNECT", "disconnect"},
+    {C_ENUM (GST_RTSP_BACKLOG_POLICY_DROP_OLDEST),
+        "GST_RTSP_BACKLOG_POLICY_DROP_OLDEST", "drop-oldest"},
+    {0, NULL, NULL}
+  };
+
+  if (g_once_init_enter (&id)) {
+    GType tmp = g_enum_register_static ("GstRTSPBacklogPolicy", values);
+    g_once_init_leave (&id, tmp);
+  }
+  return (GType) id;
+}
+
 G_DEFINE_TYPE_WITH_PRIVATE (GstRTSPStreamTransport, gst_rtsp_stream_transport,
     G_TYPE_OBJECT);
 
@@ -146,6 +177,8 @@ gst_rtsp_stream_transport_init (GstRTSPStreamTransport * trans)
   gst_vec_deque_set_clear_func (trans->priv->items,
       (GDestroyNotify) clear_backlog_item);
   g_rec_mutex_init (&trans->priv->backlog_lock);
+  trans->priv->max_backlog_duration = DEFAULT_MAX_BACKLOG_DURATION;
+  trans->priv->backlog_policy = DEFAULT_BACKLOG_POLICY;
 }
 
 static void
@@ -406,6 +439,102 @@ gst_rtsp_stream_transport_set_message_sent_full (GstRTSPStreamTransport * trans,
   priv->msf_notify = notify;
 }
 
+/**
+ * gst_rtsp_stream_transport_set_max_backlog:
+ * @trans: a #GstRTSPStreamTransport
+ * @duration: the maximum duration of the backlog
+ *
+ * Set the maximum duration of the data that is queued for @trans while the
+ * client does not read it fast enough. Only used for TCP transports. When the
+ * backlog gets longer, the backlog policy decides what happens.
+ *
+ * See gst_rtsp_stream_transport_set_backlog_policy().
+ *
+ * Since: 1.28
+ */
+void
+gst_rtsp_stream_transport_set_max_backlog (GstRTSPStreamTransport * trans,
+    GstClockTime duration)
+{
+  g_return_if_fail (GST_IS_RTSP_STREAM_TRANSPORT (trans));
+  g_return_if_fail (GST_CLOCK_TIME_IS_VALID (duration));
+
+  g_rec_mutex_lock (&trans->priv->backlog_lock);
+  trans->priv->max_backlog_duration = duration;
+  g_rec_mutex_unlock (&trans->priv->backlog_lock);
+}
+
+/**
+ * gst_rtsp_stream_transport_get_max_backlog:
+ * @trans: a #GstRTSPStreamTransport
+ *
+ * Get the maximum duration of the backlog of @trans.
+ *
+ * Returns: the maximum backlog duration
+ *
+ * Since: 1.28
+ */
+GstClockTime
+gst_rtsp_stream_transport_get_max_backlog (GstRTSPStreamTransport * trans)
+{
+  GstClockTime res;
+
+  g_return_val_if_fail (GST_IS_RTSP_STREAM_TRANSPORT (trans),
+      GST_CLOCK_TIME_NONE);
+
+  g_rec_mutex_lock (&trans->priv->backlog_lock);
+  res = trans->priv->max_backlog_duration;
+  g_rec_mutex_unlock (&trans->priv->backlog_lock);
+
+  return res;
+}
+
+/**
+ * gst_rtsp_stream_transport_set_backlog_policy:
+ * @trans: a #GstRTSPStreamTransport
+ * @policy: a #GstRTSPBacklogPolicy
+ *
+ * Configure what happens when the backlog of @trans exceeds its maximum
+ * duration.
+ *
+ * Since: 1.28
+ */
+void
+gst_rtsp_stream_transport_set_backlog_policy (GstRTSPStreamTransport * trans,
+    GstRTSPBacklogPolicy policy)
+{
+  g_return_if_fail (GST_IS_RTSP_STREAM_TRANSPORT (trans));
+
+  g_rec_mutex_lock (&trans->priv->backlog_lock);
+  trans->priv->backlog_policy = policy;
+  g_rec_mutex_unlock (&trans->priv->backlog_lock);
+}
+
+/**
+ * gst_rtsp_stream_transport_get_backlog_policy:
+ * @trans: a #GstRTSPStreamTransport
+ *
+ * Get the backlog policy of @trans.
+ *
+ * Returns: the #GstRTSPBacklogPolicy
+ *
+ * Since: 1.28
+ */
+GstRTSPBacklogPolicy
+gst_rtsp_stream_transport_get_backlog_policy (GstRTSPStreamTransport * trans)
+{
+  GstRTSPBacklogPolicy res;
+
+  g_return_val_if_fail (GST_IS_RTSP_STREAM_TRANSPORT (trans),
+      DEFAULT_BACKLOG_POLICY);
+
+  g_rec_mutex_lock (&trans->priv->backlog_lock);
+  res = trans->priv->backlog_policy;
+  g_rec_mutex_unlock (&trans->priv->backlog_lock);
+
+  return res;
+}
+
 /**
  * gst_rtsp_stream_transport_set_transport:
  * @trans: a #GstRTSPStreamTransport
@@ -870,6 +999,25 @@ get_first_backlog_timestamp (GstRTSPStreamTransport * trans)
   return ret;
 }
 
+/* drop the oldest items until the backlog is within its limits again,
+ * the newest item is never dropped */
+static void
+backlog_drop_oldest (GstRTSPStreamTransport * trans, GstClockTime timestamp)
+{
+  GstRTSPStreamTransportPrivate *priv = trans->priv;
+  guint dropped = 0;
+
+  while (gst_vec_deque_get_length (priv->items) > MAX_BACKLOG_SIZE &&
+      GST_CLOCK_TIME_IS_VALID (priv->first_rtp_timestamp) &&
+      GST_CLOCK_DIFF (priv->first_rtp_timestamp, timestamp) >
+      priv->max_backlog_duration) {
+    gst_rtsp_stream_transport_backlog_pop (trans, NULL, NULL, NULL);
+    dropped++;
+  }
+
+  GST_DEBUG_OBJECT (trans, "dropped %u items from the backlog", dropped);
+}
+
 /* Not MT-safe, caller should ensure consistent locking (see
  * gst_rtsp_stream_transport_lock_backlog()). Ownership
  * of @buffer and @buffer_list is transfered to the transport */
@@ -903,9 +1051,12 @@ gst_rtsp_stream_transport_backlog_push (GstRTSPStreamTransport * trans,
 
     g_assert (queue_duration >= 0);
 
-    if (queue_duration > MAX_BACKLOG_DURATION &&
+    if (queue_duration > priv->max_backlog_duration &&
         gst_vec_deque_get_length (priv->items) > MAX_BACKLOG_SIZE) {
-      ret = FALSE;
+      if (priv->backlog_policy == GST_RTSP_BACKLOG_POLICY_DROP_OLDEST)
+        backlog_drop_oldest (trans, item_timestamp);
+      else
+        ret = FALSE;
     }
   } else if (is_rtp) {
     priv->first_rtp_timestamp = item_timestamp;
@@ -950,6 +1101,78 @@ gst_rtsp_stream_transport_backlog_pop (GstRTSPStreamTransport * trans,
   return TRUE;
 }
 
+static void
+append_to_list (GstBufferList * dest, GstBuffer * buffer,
+    GstBufferList * buffer_list)
+{
+  guint i, n;
+
+  if (buffer) {
+    gst_buffer_list_add (dest, buffer);
+    return;
+  }
+
+  n = gst_buffer_list_length (buffer_list);
+  for (i = 0; i < n; i++)
+    gst_buffer_list_add (dest,
+        gst_buffer_ref (gst_buffer_list_get (buffer_list, i)));
+  gst_buffer_list_unref (buffer_list);
+}
+
+/* Not MT-safe, caller should ensure consistent locking (see
+ * gst_rtsp_stream_transport_lock_backlog()). Like
+ * gst_rtsp_stream_transport_backlog_pop() but also pops the following items
+ * of the same kind, up to MAX_BACKLOG_BATCH buffers, and returns them merged
+ * into one @buffer_list so that they are sent as one chunk of messages */
+gboolean
+gst_rtsp_stream_transport_backlog_pop_batch (GstRTSPStreamTransport * trans,
+    GstBuffer ** buffer, GstBufferList ** buffer_list, gboolean * is_rtp)
+{
+  GstRTSPStreamTransportPrivate *priv;
+  GstBufferList *merged = NULL;
+  guint n_buffers;
+
+  g_return_val_if_fail (!gst_rtsp_stream_transport_backlog_is_empty (trans),
+      FALSE);
+
+  priv = trans->priv;
+
+  gst_rtsp_stream_transport_backlog_pop (trans, buffer, buffer_list, is_rtp);
+  n_buffers = *buffer ? 1 : gst_buffer_list_length (*buffer_list);
+
+  while (!gst_vec_deque_is_empty (priv->items)) {
+    BackLogItem *item =
+        (BackLogItem *) gst_vec_deque_peek_head_struct (priv->items);
+    GstBuffer *next_buffer;
+    GstBufferList *next_list;
+    guint n;
+
+    if (item->is_rtp != *is_rtp)
+      break;
+
+    n = item->buffer ? 1 : gst_buffer_list_length (item->buffer_list);
+    if (n_buffers + n > MAX_BACKLOG_BATCH)
+      break;
+
+    if (!merged) {
+      merged = gst_buffer_list_new_sized (MAX_BACKLOG_BATCH);
+      append_to_list (merged, *buffer, *buffer_list);
+    }
+
+    gst_rtsp_stream_transport_backlog_pop (trans, &next_buffer, &next_list,
+        NULL);
+    append_to_list (merged, next_buffer, next_list);
+    n_buffers += n;
+  }
+
+  if (merged) {
+    *buffer = NULL;
+    *buffer_list = merged;
+  }
+
+  return TRUE;
+}
+
 /* Not MT-safe, caller should ensure consistent locking.
  * See gst_rtsp_stream_transport_lock_backlog() */
 gboolean
@@ -102,6 +102,27 @@ typedef void     (*GstRTSPMessageSentFunc) (gpointer user_data);
  */
 typedef void     (*GstRTSPMessageSentFuncFull) (GstRTSPStreamTransport *trans, gpointer user_data);
 
+/**
+ * GstRTSPBacklogPolicy:
+ * @GST_RTSP_BACKLOG_POLICY_DISCONNECT: remove the transport when its backlog
+ *   is too large, the client is considered too slow
+ * @GST_RTSP_BACKLOG_POLICY_DROP_OLDEST: drop the oldest data from the backlog
+ *   and keep the transport
+ *
+ * What to do when the backlog of data queued for a TCP transport exceeds its
+ * maximum duration.
+ *
+ * Since: 1.28
+ */
+typedef enum {
+  GST_RTSP_BACKLOG_POLICY_DISCONNECT,
+  GST_RTSP_BACKLOG_POLICY_DROP_OLDEST
+} GstRTSPBacklogPolicy;
+
+#define GST_TYPE_RTSP_BACKLOG_POLICY (gst_rtsp_backlog_policy_get_type())
+GST_RTSP_SERVER_API
+GType gst_rtsp_backlog_policy_get_type (void);
+
 /**
  * GstRTSPStreamTransport:
  * @parent: parent instance
@@ -183,6 +204,20 @@ void                     gst_rtsp_stream_transport_set_message_sent_full (GstRTS
                                                                           GstRTSPMessageSentFuncFull message_sent,
                                                                           gpointer user_data,
                                                                           GDestroyNotify  notify);
+GST_RTSP_SERVER_API
+void                     gst_rtsp_stream_transport_set_max_backlog (GstRTSPStreamTransport *trans,
+                                                                    GstClockTime duration);
+
+GST_RTSP_SERVER_API
+GstClockTime             gst_rtsp_stream_transport_get_max_backlog (GstRTSPStreamTransport *trans);
+
+GST_RTSP_SERVER_API
+void                     gst_rtsp_stream_transport_set_backlog_policy (GstRTSPStreamTransport *trans,
+                                                                       GstRTSPBacklogPolicy policy);
+
+GST_RTSP_SERVER_API
+GstRTSPBacklogPolicy     gst_rtsp_stream_transport_get_backlog_policy (GstRTSPStreamTransport *trans);
+
 GST_RTSP_SERVER_API
 void                     gst_rtsp_stream_transport_keep_alive    (GstRTSPStreamTransport *trans);
 
@@ -60,9 +60,12 @@
  * When a sample is popped, it is either sent directly on transports that don't
  * experience backpressure, or queued on the transport's backlog otherwise. Samples
  * are then popped from that backlog when the transport reports it has sent the message.
+ * All consecutive RTP or RTCP samples queued at that point are sent together as
+ * one chunk of messages.
  *
  * Once the backlog reaches an overly large duration, the transport is dropped as
- * the client was deemed too slow.
+ * the client was deemed too slow, or the oldest samples are dropped, depending
+ * on the backlog policy of the transport.
  */
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -182,10 +185,14 @@ struct _GstRTSPStreamPrivate
   /* transports we stream to */
   guint n_active;
   GList *transports;
+  GHashTable *transport_links;  /* transport -> link in transports */
   guint transports_cookie;
   GPtrArray *tr_cache;
   guint tr_cache_cookie;
   guint n_tcp_transports;
+  /* TCP transports a sample can be sent to directly, only used by the
+   * send thread */
+  GPtrArray *tr_direct;
   gboolean have_buffer[2];
 
   gint dscp_qos;
@@ -351,6 +358,9 @@ gst_rtsp_stream_init (GstRTSPStream * stream)
 
   g_mutex_init (&priv->lock);
 
+  priv->transport_links = g_hash_table_new (NULL, NULL);
+  priv->tr_direct = g_ptr_array_new ();
+
   priv->continue_sending = TRUE;
   priv->send_cookie = 0;
   g_cond_init (&priv->send_cond);
@@ -447,6 +457,8 @@ gst_rtsp_stream_finalize (GObject * obj)
 
   g_hash_table_unref (priv->keys);
   g_hash_table_destroy (priv->ptmap);
+  g_hash_table_unref (priv->transport_links);
+  g_ptr_array_unref (priv->tr_direct);
 
   g_mutex_clear (&priv->send_lock);
   g_cond_clear (&priv->send_cond);
@@ -2657,9 +2669,11 @@ check_transport_backlog (GstRTSPStream * stream, GstRTSPStreamTransport * trans)
     is_rtp = gst_rtsp_stream_transport_backlog_peek_is_rtp (trans);
 
     if (!gst_rtsp_stream_transport_check_back_pressure (trans, is_rtp)) {
+      /* send everything of the same kind that is queued together, this
+       * becomes a single writev on the connection */
       popped =
-          gst_rtsp_stream_transport_backlog_pop (trans, &buffer, &buffer_list,
-          &is_rtp);
+          gst_rtsp_stream_transport_backlog_pop_batch (trans, &buffer,
+          &buffer_list, &is_rtp);
 
       g_assert (popped == TRUE);
 
@@ -2717,6 +2731,11 @@ send_tcp_message (GstRTSPStream * stream, gint idx)
 
   buffer = gst_sample_get_buffer (sample);
   buffer_list = gst_sample_get_buffer_list (sample);
+  if (buffer)
+    gst_buffer_ref (buffer);
+  if (buffer_list)
+    gst_buffer_list_ref (buffer_list);
+  gst_sample_unref (sample);
 
   /* We will get one message-sent notification per buffer or
    * complete buffer-list. We handle each buffer-list as a unit */
@@ -2725,23 +2744,26 @@ send_tcp_message (GstRTSPStream * stream, gint idx)
   if (transports)
     g_ptr_array_ref (transports);
 
+  g_ptr_array_set_size (priv->tr_direct, 0);
+
   if (transports) {
     gint index;
 
     for (index = 0; index < transports->len; index++) {
       GstRTSPStreamTransport *tr = g_ptr_array_index (transports, index);
-      GstBuffer *buf_ref = NULL;
-      GstBufferList *buflist_ref = NULL;
 
       gst_rtsp_stream_transport_lock_backlog (tr);
 
-      if (buffer)
-        buf_ref = gst_buffer_ref (buffer);
-      if (buffer_list)
-        buflist_ref = gst_buffer_list_ref (buffer_list);
-
-      if (!gst_rtsp_stream_transport_backlog_push (tr,
-              buf_ref, buflist_ref, is_rtp)) {
+      if (gst_rtsp_stream_transport_backlog_is_empty (tr) &&
+          !gst_rtsp_stream_transport_check_back_pressure (tr, is_rtp)) {
+        /* nothing queued and the connection is free, the sample can be
+         * sent right away without going through the backlog. Only this
+         * thread queues data, so this stays true until we send. */
+        g_ptr_array_add (priv->tr_direct, tr);
+      } else if (!gst_rtsp_stream_transport_backlog_push (tr,
+              buffer ? gst_buffer_ref (buffer) : NULL,
+              buffer_list ? gst_buffer_list_ref (buffer_list) : NULL,
+              is_rtp)) {
         GST_ERROR_OBJECT (stream,
             "Dropping slow transport %" GST_PTR_FORMAT, tr);
         update_transport (stream, tr, FALSE);
@@ -2750,21 +2772,38 @@ send_tcp_message (GstRTSPStream * stream, gint idx)
       gst_rtsp_stream_transport_unlock_backlog (tr);
     }
   }
-  gst_sample_unref (sample);
 
   g_mutex_unlock (&priv->lock);
 
   if (transports) {
     gint index;
+    guint direct = 0;
 
+    /* tr_direct is in the same order as transports */
     for (index = 0; index < transports->len; index++) {
       GstRTSPStreamTransport *tr = g_ptr_array_index (transports, index);
 
-      check_transport_backlog (stream, tr);
+      if (direct < priv->tr_direct->len &&
+          g_ptr_array_index (priv->tr_direct, direct) == tr) {
+        direct++;
+        if (!push_data (stream, tr, buffer, buffer_list, is_rtp)) {
+          /* remove transport on send error */
+          g_mutex_lock (&priv->lock);
+          update_transport (stream, tr, FALSE);
+          g_mutex_unlock (&priv->lock);
+        }
+      } else {
+        check_transport_backlog (stream, tr);
+      }
     }
+    g_ptr_array_set_size (priv->tr_direct, 0);
+
     g_ptr_array_unref (transports);
   }
 
+  gst_clear_buffer (&buffer);
+  gst_clear_buffer_list (&buffer_list);
+
   g_mutex_lock (&priv->lock);
 }
 
@@ -4732,7 +4771,7 @@ update_transport (GstRTSPStream * stream, GstRTSPStreamTransport * trans,
   tr = gst_rtsp_stream_transport_get_transport (trans);
   dest = tr->destination;
 
-  tr_element = g_list_find (priv->transports, trans);
+  tr_element = g_hash_table_lookup (priv->transport_links, trans);
 
   if (add && tr_element)
     return TRUE;
@@ -4762,12 +4801,14 @@ update_transport (GstRTSPStream * stream, GstRTSPStreamTransport * trans,
                 NULL);
         }
         priv->transports = g_list_prepend (priv->transports, trans);
+        g_hash_table_insert (priv->transport_links, trans, priv->transports);
       } else {
         GST_INFO ("removing %s:%d-%d", dest, min, max);
         if (!remove_mcast_client_addr (stream, dest, min, max))
           GST_WARNING_OBJECT (stream,
               "Failed to remove multicast address: %s:%d-%d", dest, min, max);
         priv->transports = g_list_delete_link (priv->transports, tr_element);
+        g_hash_table_remove (priv->transport_links, trans);
         remove_client (priv->mcast_udpsink[0], priv->mcast_udpsink[1], dest,
             min, max);
       }
@@ -4789,9 +4830,11 @@ update_transport (GstRTSPStream * stream, GstRTSPStreamTransport * trans,
         GST_INFO ("adding %s:%d-%d", dest, min, max);
         add_client (priv->udpsink[0], priv->udpsink[1], dest, min, max);
         priv->transports = g_list_prepend (priv->transports, trans);
+        g_hash_table_insert (priv->transport_links, trans, priv->transports);
       } else {
         GST_INFO ("removing %s:%d-%d", dest, min, max);
         priv->transports = g_list_delete_link (priv->transports, tr_element);
+        g_hash_table_remove (priv->transport_links, trans);
         remove_client (priv->udpsink[0], priv->udpsink[1], dest, min, max);
       }
       priv->transports_cookie++;
@@ -4801,10 +4844,12 @@ update_transport (GstRTSPStream * stream, GstRTSPStreamTransport * trans,
       if (add) {
         GST_INFO ("adding TCP %s", tr->destination);
         priv->transports = g_list_prepend (priv->transports, trans);
+        g_hash_table_insert (priv->transport_links, trans, priv->transports);
         priv->n_tcp_transports++;
       } else {
         GST_INFO ("removing TCP %s", tr->destination);
         priv->transports = g_list_delete_link (priv->transports, tr_element);
+        g_hash_table_remove (priv->transport_links, trans);
 
         gst_rtsp_stream_transport_lock_backlog (trans);
         gst_rtsp_stream_transport_clear_backlog (trans);
@@ -745,6 +745,58 @@ GST_START_TEST (test_setup_tcp_root_mount_point)
 
 GST_END_TEST;
 
+static void
+setup_request_check_backlog_cb (GstRTSPClient * client, GstRTSPContext * ctx,
+    gboolean * checked)
+{
+  fail_unless (ctx->trans != NULL);
+  fail_unless_equals_uint64 (gst_rtsp_stream_transport_get_max_backlog
+      (ctx->trans), 2 * GST_SECOND);
+  fail_unless_equals_int (gst_rtsp_stream_transport_get_backlog_policy
+      (ctx->trans), GST_RTSP_BACKLOG_POLICY_DROP_OLDEST);
+  *checked = TRUE;
+}
+
+GST_START_TEST (test_setup_tcp_backlog_settings)
+{
+  GstRTSPClient *client;
+  GstRTSPConnection *conn;
+  GstRTSPMessage request = { 0, };
+  gboolean checked = FALSE;
+  gchar *str;
+
+  client = setup_client (NULL, "/test", TRUE);
+  create_connection (&conn);
+  fail_unless (gst_rtsp_client_set_connection (client, conn));
+
+  /* applied to the TCP transports of the client */
+  g_object_set (client, "max-backlog-duration", 2 * GST_SECOND,
+      "backlog-policy", GST_RTSP_BACKLOG_POLICY_DROP_OLDEST, NULL);
+  g_signal_connect (client, "setup-request",
+      G_CALLBACK (setup_request_check_backlog_cb), &checked);
+
+  fail_unless (gst_rtsp_message_init_request (&request, GST_RTSP_SETUP,
+          "rtsp://localhost/test/stream=0") == GST_RTSP_OK);
+  str = g_strdup_printf ("%d", cseq);
+  gst_rtsp_message_take_header (&request, GST_RTSP_HDR_CSEQ, str);
+  gst_rtsp_message_add_header (&request, GST_RTSP_HDR_TRANSPORT,
+      "RTP/AVP/TCP;unicast");
+
+  gst_rtsp_client_set_send_func (client, test_setup_response_200, NULL, NULL);
+  expected_transport =
+      "RTP/AVP/TCP;unicast;interleaved=0-1;ssrc=.*;mode=\"PLAY\"";
+  fail_unless (gst_rtsp_client_handle_message (client,
+          &request) == GST_RTSP_OK);
+  gst_rtsp_message_unset (&request);
+  expected_transport = NULL;
+  fail_unless (checked);
+
+  send_teardown (client, "rtsp://localhost/test");
+  teardown_client (client);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_setup_no_rtcp)
 {
   GstRTSPClient *client;
@@ -2215,6 +2267,7 @@ rtspclient_suite (void)
   tcase_add_test (tc, test_describe_root_mount_point);
   tcase_add_test (tc, test_setup_tcp);
   tcase_add_test (tc, test_setup_tcp_root_mount_point);
+  tcase_add_test (tc, test_setup_tcp_backlog_settings);
   tcase_add_test (tc, test_setup_no_rtcp);
   tcase_add_test (tc, test_setup_tcp_two_streams_same_channels);
   tcase_add_test (tc,
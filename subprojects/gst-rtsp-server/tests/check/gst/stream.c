@@ -653,6 +653,73 @@ GST_START_TEST (test_remove_transport_twice)
 
 GST_END_TEST;
 
+/* many clients of a shared media */
+GST_START_TEST (test_add_remove_many_transports)
+{
+  GstRTSPStream *stream;
+  GstRTSPStreamTransport *trs[1000];
+  GstPad *srcpad;
+  GstElement *pay;
+  GstBin *bin;
+  GstElement *rtpbin;
+  GList *transports;
+  guint i;
+
+  srcpad = gst_pad_new ("testsrcpad", GST_PAD_SRC);
+  fail_unless (srcpad != NULL);
+  pay = gst_element_factory_make ("rtpgstpay", "testpayloader");
+  fail_unless (pay != NULL);
+  stream = gst_rtsp_stream_new (0, pay, srcpad);
+  fail_unless (stream != NULL);
+  gst_object_unref (pay);
+  gst_object_unref (srcpad);
+  rtpbin = gst_element_factory_make ("rtpbin", "testrtpbin");
+  fail_unless (rtpbin != NULL);
+  bin = GST_BIN (gst_bin_new ("testbin"));
+  fail_unless (bin != NULL);
+  fail_unless (gst_bin_add (bin, rtpbin));
+
+  gst_rtsp_stream_set_protocols (stream, GST_RTSP_LOWER_TRANS_TCP);
+  fail_unless (gst_rtsp_stream_join_bin (stream, bin, rtpbin, GST_STATE_NULL));
+
+  for (i = 0; i < G_N_ELEMENTS (trs); i++) {
+    GstRTSPTransport *transport;
+
+    fail_unless (gst_rtsp_transport_new (&transport) == GST_RTSP_OK);
+    transport->lower_transport = GST_RTSP_LOWER_TRANS_TCP;
+    transport->destination = g_strdup ("127.0.0.1");
+    trs[i] = gst_rtsp_stream_transport_new (stream, transport);
+    fail_unless (gst_rtsp_stream_add_transport (stream, trs[i]));
+  }
+
+  transports = gst_rtsp_stream_transport_filter (stream, NULL, NULL);
+  fail_unless_equals_int (g_list_length (transports), G_N_ELEMENTS (trs));
+  g_list_free_full (transports, g_object_unref);
+
+  /* remove every other one first, then the rest */
+  for (i = 0; i < G_N_ELEMENTS (trs); i += 2)
+    fail_unless (gst_rtsp_stream_remove_transport (stream, trs[i]));
+  for (i = 0; i < G_N_ELEMENTS (trs); i += 2)
+    fail_if (gst_rtsp_stream_remove_transport (stream, trs[i]));
+
+  transports = gst_rtsp_stream_transport_filter (stream, NULL, NULL);
+  fail_unless_equals_int (g_list_length (transports), G_N_ELEMENTS (trs) / 2);
+  fail_unless (g_list_find (transports, trs[1]) != NULL);
+  fail_if (g_list_find (transports, trs[0]) != NULL);
+  g_list_free_full (transports, g_object_unref);
+
+  for (i = 1; i < G_N_ELEMENTS (trs); i += 2)
+    fail_unless (gst_rtsp_stream_remove_transport (stream, trs[i]));
+
+  fail_unless (gst_rtsp_stream_leave_bin (stream, bin, rtpbin));
+  for (i = 0; i < G_N_ELEMENTS (trs); i++)
+    g_object_unref (trs[i]);
+  gst_object_unref (bin);
+  gst_object_unref (stream);
+}
+
+GST_END_TEST;
+
 static gboolean
 is_ipv6_supported (void)
 {
@@ -699,6 +766,7 @@ rtspstream_suite (void)
   tcase_add_test (tc, test_multicast_client_address_invalid);
   tcase_add_test (tc, test_add_transport_twice);
   tcase_add_test (tc, test_remove_transport_twice);
+  tcase_add_test (tc, test_add_remove_many_transports);
 
   return s;
 }
@@ -0,0 +1,229 @@
+/* GStreamer
+ *
+ * unit tests for the TCP backlog of GstRTSPStreamTransport
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+
+#include <rtsp-stream.h>
+#include <rtsp-stream-transport.h>
+/* this test is built with the objects of the library, see meson.build */
+#include <rtsp-server-internal.h>
+
+static GstRTSPStreamTransport *
+create_tcp_stream_transport (GstRTSPStream ** stream)
+{
+  GstRTSPTransport *transport;
+  GstPad *srcpad;
+  GstElement *pay;
+
+  srcpad = gst_pad_new ("testsrcpad", GST_PAD_SRC);
+  fail_unless (srcpad != NULL);
+  pay = gst_element_factory_make ("rtpgstpay", "testpayloader");
+  fail_unless (pay != NULL);
+  *stream = gst_rtsp_stream_new (0, pay, srcpad);
+  fail_unless (*stream != NULL);
+  gst_object_unref (pay);
+  gst_object_unref (srcpad);
+
+  fail_unless (gst_rtsp_transport_new (&transport) == GST_RTSP_OK);
+  transport->lower_transport = GST_RTSP_LOWER_TRANS_TCP;
+  transport->destination = g_strdup ("127.0.0.1");
+
+  return gst_rtsp_stream_transport_new (*stream, transport);
+}
+
+static GstBuffer *
+create_backlog_buffer (guint pts_ms)
+{
+  GstBuffer *buffer = gst_buffer_new ();
+
+  GST_BUFFER_PTS (buffer) = pts_ms * GST_MSECOND;
+
+  return buffer;
+}
+
+/* pops one batch and checks that it is of the expected kind and holds the
+ * next @n_buffers buffers in order, the buffer at @pts_ms comes first */
+static void
+check_backlog_batch (GstRTSPStreamTransport * trans, gboolean expect_rtp,
+    guint * pts_ms, guint n_buffers)
+{
+  GstBuffer *buffer = NULL;
+  GstBufferList *buffer_list = NULL;
+  gboolean is_rtp;
+  guint i;
+
+  fail_if (gst_rtsp_stream_transport_backlog_is_empty (trans));
+  fail_unless (gst_rtsp_stream_transport_backlog_pop_batch (trans, &buffer,
+          &buffer_list, &is_rtp));
+  fail_unless_equals_int (is_rtp, expect_rtp);
+
+  if (buffer) {
+    fail_unless (buffer_list == NULL);
+    fail_unless_equals_int (n_buffers, 1);
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer), *pts_ms * GST_MSECOND);
+    *pts_ms += 1;
+    gst_buffer_unref (buffer);
+    return;
+  }
+
+  fail_unless (buffer_list != NULL);
+  fail_unless_equals_int (gst_buffer_list_length (buffer_list), n_buffers);
+  for (i = 0; i < n_buffers; i++) {
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (gst_buffer_list_get
+            (buffer_list, i)), *pts_ms * GST_MSECOND);
+    *pts_ms += 1;
+  }
+  gst_buffer_list_unref (buffer_list);
+}
+
+GST_START_TEST (test_backlog_pop_batch)
+{
+  GstRTSPStream *stream;
+  GstRTSPStreamTransport *trans;
+  GstBufferList *list;
+  guint pts_ms = 0, i;
+
+  trans = create_tcp_stream_transport (&stream);
+
+  /* 3 RTP buffers, 1 RTCP buffer, RTP lists of 70 and 10 buffers and 60 more
+   * RTP buffers, with increasing timestamps */
+  for (i = 0; i < 3; i++)
+    fail_unless (gst_rtsp_stream_transport_backlog_push (trans,
+            create_backlog_buffer (pts_ms++), NULL, TRUE));
+  fail_unless (gst_rtsp_stream_transport_backlog_push (trans,
+          create_backlog_buffer (pts_ms++), NULL, FALSE));
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 70; i++)
+    gst_buffer_list_add (list, create_backlog_buffer (pts_ms++));
+  fail_unless (gst_rtsp_stream_transport_backlog_push (trans, NULL, list,
+          TRUE));
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 10; i++)
+    gst_buffer_list_add (list, create_backlog_buffer (pts_ms++));
+  fail_unless (gst_rtsp_stream_transport_backlog_push (trans, NULL, list,
+          TRUE));
+  for (i = 0; i < 60; i++)
+    fail_unless (gst_rtsp_stream_transport_backlog_push (trans,
+            create_backlog_buffer (pts_ms++), NULL, TRUE));
+
+  pts_ms = 0;
+  /* the RTP buffers are merged, the RTCP buffer after them isn't */
+  check_backlog_batch (trans, TRUE, &pts_ms, 3);
+  check_backlog_batch (trans, FALSE, &pts_ms, 1);
+  /* a list with more than 64 buffers is sent as is, without the next one */
+  check_backlog_batch (trans, TRUE, &pts_ms, 70);
+  /* the list of 10 with 54 of the buffers makes 64 */
+  check_backlog_batch (trans, TRUE, &pts_ms, 64);
+  check_backlog_batch (trans, TRUE, &pts_ms, 6);
+  fail_unless (gst_rtsp_stream_transport_backlog_is_empty (trans));
+
+  g_object_unref (trans);
+  gst_object_unref (stream);
+}
+
+GST_END_TEST;
+
+/* the backlog is only considered too long with more than 100 items spanning
+ * more than the maximum duration of 1s */
+static void
+fill_backlog (GstRTSPBacklogPolicy policy)
+{
+  GstRTSPStream *stream;
+  GstRTSPStreamTransport *trans;
+  guint pts_ms, i;
+  gboolean ret;
+
+  trans = create_tcp_stream_transport (&stream);
+  gst_rtsp_stream_transport_set_max_backlog (trans, GST_SECOND);
+  gst_rtsp_stream_transport_set_backlog_policy (trans, policy);
+
+  /* an RTCP buffer, then 101 RTP buffers 10ms apart that span exactly 1s
+   * with another RTCP buffer after the one at 200ms */
+  fail_unless (gst_rtsp_stream_transport_backlog_push (trans,
+          create_backlog_buffer (0), NULL, FALSE));
+  for (i = 0; i <= 100; i++) {
+    fail_unless (gst_rtsp_stream_transport_backlog_push (trans,
+            create_backlog_buffer (i * 10), NULL, TRUE));
+    if (i == 20)
+      fail_unless (gst_rtsp_stream_transport_backlog_push (trans,
+              create_backlog_buffer (i * 10), NULL, FALSE));
+  }
+
+  /* 1010ms is too long */
+  ret = gst_rtsp_stream_transport_backlog_push (trans,
+      create_backlog_buffer (1010), NULL, TRUE);
+
+  if (policy == GST_RTSP_BACKLOG_POLICY_DISCONNECT) {
+    fail_if (ret);
+  } else {
+    GstBuffer *buffer;
+    gboolean is_rtp;
+
+    fail_unless (ret);
+    for (i = 102; i < 150; i++)
+      fail_unless (gst_rtsp_stream_transport_backlog_push (trans,
+              create_backlog_buffer (i * 10), NULL, TRUE));
+
+    /* the oldest items including the RTCP ones were dropped until the
+     * backlog spans 1s again, from 490ms to 1490ms */
+    for (pts_ms = 490; pts_ms < 1500; pts_ms += 10) {
+      fail_unless (gst_rtsp_stream_transport_backlog_pop (trans, &buffer, NULL,
+              &is_rtp));
+      fail_unless (is_rtp);
+      fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer),
+          pts_ms * GST_MSECOND);
+      gst_buffer_unref (buffer);
+    }
+    fail_unless (gst_rtsp_stream_transport_backlog_is_empty (trans));
+  }
+
+  g_object_unref (trans);
+  gst_object_unref (stream);
+}
+
+GST_START_TEST (test_backlog_disconnect)
+{
+  fill_backlog (GST_RTSP_BACKLOG_POLICY_DISCONNECT);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_backlog_drop_oldest)
+{
+  fill_backlog (GST_RTSP_BACKLOG_POLICY_DROP_OLDEST);
+}
+
+GST_END_TEST;
+
+static Suite *
+rtspstreamtransport_suite (void)
+{
+  Suite *s = suite_create ("rtspstreamtransport");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (s, tc);
+  tcase_add_test (tc, test_backlog_pop_batch);
+  tcase_add_test (tc, test_backlog_disconnect);
+  tcase_add_test (tc, test_backlog_drop_oldest);
+
+  return s;
+}
+
+GST_CHECK_MAIN (rtspstreamtransport);